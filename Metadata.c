@@ -11,8 +11,13 @@ static const char* const names[] = {
     "Serial Baud Rate",
     "Serial RTS/CTS Enabled",
     "Binary Mode Enabled",
+    "Binary Payload Format",
+    "Binary Quaternion Compression",
+    "ASCII Precision",
     "USB Data Messages Enabled",
+    "USB Binary Framing",
     "Serial Data Messages Enabled",
+    "Serial Binary Framing",
     "Example Float",
 };
 
@@ -25,8 +30,13 @@ static const char* const keys[] = {
     "serial_baud_rate",
     "serial_rts_cts_enabled",
     "binary_mode_enabled",
+    "binary_payload_format",
+    "binary_quaternion_compression",
+    "ascii_precision",
     "usb_data_messages_enabled",
+    "usb_binary_framing",
     "serial_data_messages_enabled",
+    "serial_binary_framing",
     "example_float",
 };
 
@@ -39,8 +49,13 @@ const MetadataType types[] = {
     MetadataTypeUint32,
     MetadataTypeBool,
     MetadataTypeBool,
+    MetadataTypeUint32,
+    MetadataTypeUint32,
+    MetadataTypeUint32,
     MetadataTypeBool,
+    MetadataTypeUint32,
     MetadataTypeBool,
+    MetadataTypeUint32,
     MetadataTypeFloat,
 };
 
@@ -53,8 +68,13 @@ const size_t sizes[] = {
     sizeof (((Ximu3SettingsValues *) 0)->serialBaudRate),
     sizeof (((Ximu3SettingsValues *) 0)->serialRtsCtsEnabled),
     sizeof (((Ximu3SettingsValues *) 0)->binaryModeEnabled),
+    sizeof (((Ximu3SettingsValues *) 0)->binaryPayloadFormat),
+    sizeof (((Ximu3SettingsValues *) 0)->binaryQuaternionCompression),
+    sizeof (((Ximu3SettingsValues *) 0)->asciiPrecision),
     sizeof (((Ximu3SettingsValues *) 0)->usbDataMessagesEnabled),
+    sizeof (((Ximu3SettingsValues *) 0)->usbBinaryFraming),
     sizeof (((Ximu3SettingsValues *) 0)->serialDataMessagesEnabled),
+    sizeof (((Ximu3SettingsValues *) 0)->serialBinaryFraming),
     sizeof (((Ximu3SettingsValues *) 0)->exampleFloat),
 };
 
@@ -67,8 +87,13 @@ const void* const defaults[] = {
     (void*) (&(uint32_t) {115200}),
     (void*) (&(bool) {false}),
     (void*) (&(bool) {true}),
+    (void*) (&(uint32_t) {0}),
+    (void*) (&(uint32_t) {0}),
+    (void*) (&(uint32_t) {4}),
     (void*) (&(bool) {true}),
+    (void*) (&(uint32_t) {0}),
     (void*) (&(bool) {true}),
+    (void*) (&(uint32_t) {0}),
     (void*) (&(float) {1.0f}),
 };
 
@@ -84,6 +109,11 @@ const bool preserveds[] = {
     false,
     false,
     false,
+    false,
+    false,
+    false,
+    false,
+    false,
 };
 
 const bool readOnlys[] = {
@@ -98,6 +128,11 @@ const bool readOnlys[] = {
     false,
     false,
     false,
+    false,
+    false,
+    false,
+    false,
+    false,
 };
 
 static void* GetValue(Ximu3Settings * const settings, const Ximu3SettingsIndex index) {
@@ -118,10 +153,20 @@ static void* GetValue(Ximu3Settings * const settings, const Ximu3SettingsIndex i
             return &settings->values.serialRtsCtsEnabled;
         case Ximu3SettingsIndexBinaryModeEnabled:
             return &settings->values.binaryModeEnabled;
+        case Ximu3SettingsIndexBinaryPayloadFormat:
+            return &settings->values.binaryPayloadFormat;
+        case Ximu3SettingsIndexBinaryQuaternionCompression:
+            return &settings->values.binaryQuaternionCompression;
+        case Ximu3SettingsIndexAsciiPrecision:
+            return &settings->values.asciiPrecision;
         case Ximu3SettingsIndexUsbDataMessagesEnabled:
             return &settings->values.usbDataMessagesEnabled;
+        case Ximu3SettingsIndexUsbBinaryFraming:
+            return &settings->values.usbBinaryFraming;
         case Ximu3SettingsIndexSerialDataMessagesEnabled:
             return &settings->values.serialDataMessagesEnabled;
+        case Ximu3SettingsIndexSerialBinaryFraming:
+            return &settings->values.serialBinaryFraming;
         case Ximu3SettingsIndexExampleFloat:
             return &settings->values.exampleFloat;
 
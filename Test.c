@@ -9,12 +9,28 @@
 
 #include <float.h>
 #include <inttypes.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "Test.h"
 #include "Ximu3.h"
 
+//------------------------------------------------------------------------------
+// Definitions
+
+typedef struct {
+    uint64_t timestamp;
+    float value;
+    bool flag;
+    const char *label;
+} CustomData;
+
+typedef struct {
+    uint8_t buffer[1024];
+    size_t size;
+} RouterOutput;
+
 //------------------------------------------------------------------------------
 // Function declarations
 
@@ -26,12 +42,289 @@ static void TestAsciiFloatString(const float floatValue, const char *const float
 
 static void TestAsciiTimestampAndFloat(const uint64_t timestamp, const float floatValue, const char *const floatString);
 
+static void TestAsciiPrecision(void);
+
+static void TestAsciiPrecisionFloat(const float floatValue, const int precision, const char *const floatString);
+
+static void TestAsciiRotationMatrix(const int precision);
+
+static void TestBinaryDecoder(void);
+
+static void TestBinaryDecoderMessage(const char *const name, const void *const message, const size_t messageSize);
+
+static void TestAsciiParser(void);
+
+static void TestAsciiParserMessage(const char *const name, const void *const message, const size_t messageSize);
+
+static void TestAsciiParserNumber(const char *const number, const bool valid);
+
+static void TestPayloadFormat(void);
+
+static void TestPayloadFormatMessage(const char *const name, const void *const message, const size_t messageSize, const uint8_t *const expected, const size_t expectedSize);
+
+static void TestPacked(void);
+
+static void TestPackedMessage(const char *const name, const void *const message, const size_t messageSize, const size_t maximumMessageSize, const void *const expected, const size_t expectedSize);
+
+static void TestQuaternionCompression(void);
+
+static void TestQuaternionCompressionMessage(const char *const name, const void *const message, const size_t messageSize, const size_t maximumMessageSize, const float *const expected, const size_t numberOfValues, const float maximumError);
+
+static void DecompressedQuaternion(const Ximu3DataQuaternion *const data, void *const context);
+
+static void DecompressedLinearAcceleration(const Ximu3DataLinearAcceleration *const data, void *const context);
+
+static void DecompressedEarthAcceleration(const Ximu3DataEarthAcceleration *const data, void *const context);
+
+static void TestAggregator(void);
+
+static void TestAggregatorSamples(const char *const name, Ximu3BinaryAggregator *const aggregator, const int expectedNumberOfWrites);
+
+static void AggregatorWrite(const void *const data, const size_t numberOfBytes, void *const context);
+
+static void TestComposite(void);
+
+static void TestDescriptor(void);
+
+static void TestCobs(void);
+
+static void TestCobsMessage(const char *const name, const void *const message, const size_t messageSize, const size_t maximumCobsSize, const void *const expected, const size_t expectedSize);
+
+static void TestMessageCobs(const char *const name, const Ximu3Descriptor *const descriptor, const void *const data, const size_t maximumCobsSize);
+
+static void TestCompression(void);
+
+static void TestIntern(void);
+
+static bool TestInternMessage(const void *const message, const size_t messageSize, const void *const expected, const size_t expectedSize);
+
+static size_t CompressionStream(Ximu3Compressor *const compressor, uint8_t *const original, size_t *const originalSize, uint8_t *const compressed, const uint32_t numberOfMessages, const uint32_t dropIndex);
+
+static void DecompressorWrite(const void *const data, const size_t numberOfBytes, void *const context);
+
+static void TestBatch(void);
+
+static void TestBatchSize(const char *const name, const size_t destinationSize, const size_t expectedNumberOfMessages);
+
+static void TestUnchecked(void);
+
+static void TestPrintable(void);
+
+static void TestSerialAccessoryStream(void);
+
+static void StreamWrite(const void *const data, const size_t numberOfBytes, void *const context);
+
+static void TestUncheckedMessage(const char *const name, const void *const unchecked, const size_t uncheckedSize, const void *const checked, const size_t checkedSize);
+
+static void TestWriter(void);
+
+static void TestCompactTimestamp(void);
+
+static void TestCsv(void);
+
+static void CsvWrite(const void *const data, const size_t numberOfBytes, void *const context);
+
+static void TestRouter(void);
+
+static void TestWorstCaseSize(void);
+
+static void TestPool(void);
+
+static void TestRouterMessage(const char *const name, Ximu3Router *const router, const Ximu3Descriptor *const descriptor, const void *const data, const void *const expectedUsb, const size_t expectedUsbSize, const void *const expectedSerial, const size_t expectedSerialSize);
+
+static void *RouterReserve(const size_t numberOfBytes, void *const context);
+
+static void RouterCommit(const size_t numberOfBytes, void *const context);
+
+static void *RingReserve(const size_t numberOfBytes, void *const context);
+
+static void RingCommit(const size_t numberOfBytes, void *const context);
+
+static size_t RingTransmit(uint8_t *const destination);
+
+static float FloatFromBits(const uint32_t bits);
+
+static void DecodedInertial(const Ximu3DataInertial *const data, void *const context);
+
+static void DecodedMagnetometer(const Ximu3DataMagnetometer *const data, void *const context);
+
+static void DecodedHighGAccelerometer(const Ximu3DataHighGAccelerometer *const data, void *const context);
+
+static void DecodedQuaternion(const Ximu3DataQuaternion *const data, void *const context);
+
+static void DecodedRotationMatrix(const Ximu3DataRotationMatrix *const data, void *const context);
+
+static void DecodedEulerAngles(const Ximu3DataEulerAngles *const data, void *const context);
+
+static void DecodedLinearAcceleration(const Ximu3DataLinearAcceleration *const data, void *const context);
+
+static void DecodedEarthAcceleration(const Ximu3DataEarthAcceleration *const data, void *const context);
+
+static void DecodedAhrsStatus(const Ximu3DataAhrsStatus *const data, void *const context);
+
+static void DecodedSerialAccessory(const Ximu3DataSerialAccessory *const data, void *const context);
+
+static void DecodedSync(const Ximu3DataSync *const data, void *const context);
+
+static void DecodedLtc(const Ximu3DataLtc *const data, void *const context);
+
+static void DecodedTemperature(const Ximu3DataTemperature *const data, void *const context);
+
+static void DecodedBattery(const Ximu3DataBattery *const data, void *const context);
+
+static void DecodedRssi(const Ximu3DataRssi *const data, void *const context);
+
+static void DecodedButton(const Ximu3DataButton *const data, void *const context);
+
+static void DecodedNotification(const Ximu3DataNotification *const data, void *const context);
+
+static void DecodedError(const Ximu3DataError *const data, void *const context);
+
+static void DecodedCustom(const Ximu3Descriptor *const descriptor, const void *const data, void *const context);
+
+static void DecodeError(const char *const error, void *const context);
+
+static void DecompressError(const char *const error, void *const context);
+
+static void ParsedInertial(const Ximu3DataInertial *const data, void *const context);
+
+static void ParsedMagnetometer(const Ximu3DataMagnetometer *const data, void *const context);
+
+static void ParsedHighGAccelerometer(const Ximu3DataHighGAccelerometer *const data, void *const context);
+
+static void ParsedQuaternion(const Ximu3DataQuaternion *const data, void *const context);
+
+static void ParsedRotationMatrix(const Ximu3DataRotationMatrix *const data, void *const context);
+
+static void ParsedEulerAngles(const Ximu3DataEulerAngles *const data, void *const context);
+
+static void ParsedLinearAcceleration(const Ximu3DataLinearAcceleration *const data, void *const context);
+
+static void ParsedEarthAcceleration(const Ximu3DataEarthAcceleration *const data, void *const context);
+
+static void ParsedAhrsStatus(const Ximu3DataAhrsStatus *const data, void *const context);
+
+static void ParsedSerialAccessory(const Ximu3DataSerialAccessory *const data, void *const context);
+
+static void ParsedSync(const Ximu3DataSync *const data, void *const context);
+
+static void ParsedLtc(const Ximu3DataLtc *const data, void *const context);
+
+static void ParsedTemperature(const Ximu3DataTemperature *const data, void *const context);
+
+static void ParsedBattery(const Ximu3DataBattery *const data, void *const context);
+
+static void ParsedRssi(const Ximu3DataRssi *const data, void *const context);
+
+static void ParsedButton(const Ximu3DataButton *const data, void *const context);
+
+static void ParsedNotification(const Ximu3DataNotification *const data, void *const context);
+
+static void ParsedError(const Ximu3DataError *const data, void *const context);
+
+static void ParsedCustom(const Ximu3Descriptor *const descriptor, const void *const data, void *const context);
+
+static void ParseError(const char *const error, void *const context);
+
 //------------------------------------------------------------------------------
 // Variables
 
 static int passCount = 0;
 static int failCount = 0;
 
+static Ximu3BinaryDecoder decoder = {
+    .inertial = DecodedInertial,
+    .magnetometer = DecodedMagnetometer,
+    .highGAccelerometer = DecodedHighGAccelerometer,
+    .quaternion = DecodedQuaternion,
+    .rotationMatrix = DecodedRotationMatrix,
+    .eulerAngles = DecodedEulerAngles,
+    .linearAcceleration = DecodedLinearAcceleration,
+    .earthAcceleration = DecodedEarthAcceleration,
+    .ahrsStatus = DecodedAhrsStatus,
+    .serialAccessory = DecodedSerialAccessory,
+    .sync = DecodedSync,
+    .ltc = DecodedLtc,
+    .temperature = DecodedTemperature,
+    .battery = DecodedBattery,
+    .rssi = DecodedRssi,
+    .button = DecodedButton,
+    .notification = DecodedNotification,
+    .error = DecodedError,
+    .custom = DecodedCustom,
+    .decodeError = DecodeError,
+};
+
+static uint8_t decoded[1024]; /* decoded messages encoded again */
+static size_t decodedSize;
+static int decodeErrorCount;
+static Ximu3BinaryDecoder compressionDecoder = {
+    .quaternion = DecompressedQuaternion,
+    .linearAcceleration = DecompressedLinearAcceleration,
+    .earthAcceleration = DecompressedEarthAcceleration,
+    .decodeError = DecodeError,
+};
+
+static Ximu3AsciiParser asciiParser = {
+    .inertial = ParsedInertial,
+    .magnetometer = ParsedMagnetometer,
+    .highGAccelerometer = ParsedHighGAccelerometer,
+    .quaternion = ParsedQuaternion,
+    .rotationMatrix = ParsedRotationMatrix,
+    .eulerAngles = ParsedEulerAngles,
+    .linearAcceleration = ParsedLinearAcceleration,
+    .earthAcceleration = ParsedEarthAcceleration,
+    .ahrsStatus = ParsedAhrsStatus,
+    .serialAccessory = ParsedSerialAccessory,
+    .sync = ParsedSync,
+    .ltc = ParsedLtc,
+    .temperature = ParsedTemperature,
+    .battery = ParsedBattery,
+    .rssi = ParsedRssi,
+    .button = ParsedButton,
+    .notification = ParsedNotification,
+    .error = ParsedError,
+    .custom = ParsedCustom,
+    .parseError = ParseError,
+};
+
+static char parsed[1024]; /* parsed messages written again */
+static size_t parsedSize;
+static float parsedTemperature;
+static int parseErrorCount;
+
+static float decompressed[7];
+static int decompressedCount;
+static uint8_t aggregated[1024];
+static size_t aggregatedSize;
+static int aggregatedNumberOfWrites;
+static size_t aggregatedMaximumWriteSize;
+static uint8_t streamed[4096];
+static size_t streamedSize;
+static int streamedNumberOfWrites;
+
+static Ximu3Decompressor decompressor = {
+    .write = DecompressorWrite,
+    .decompressError = DecompressError,
+};
+
+static uint8_t decompressorOutput[8192];
+static size_t decompressorOutputSize;
+static char csvOutput[1024];
+static size_t csvOutputSize;
+static int csvNumberOfWrites;
+static int decompressErrorCount;
+static RouterOutput usbOutput;
+static RouterOutput serialOutput;
+
+static struct {
+    uint8_t buffer[256];
+    uint8_t *reservation;
+    size_t writeIndex;
+    size_t readIndex;
+    size_t wrapIndex; /* end of valid data when writeIndex has wrapped */
+} ring;
+
 //------------------------------------------------------------------------------
 // Functions
 
@@ -184,6 +477,10 @@ int Test(void) {
     TestAsciiFloat(99999.9999f);
     TestAsciiFloatString(999999.9999f, "999999.9999"); // 999999.9999f rounds to 1000000.0f due to floating-point precision
 
+    TestAsciiFloat(0.99996f); // fractional part rounds up to 1
+    TestAsciiFloat(-0.99996f);
+    TestAsciiFloat(9.99996f);
+
     TestAsciiFloatString(-0.0f, "0.0000");
 
     TestAsciiFloatString(-1000000.0f, "-999999.9999");
@@ -193,6 +490,50 @@ int Test(void) {
     TestAsciiFloatString(-FLT_MAX, "-999999.9999");
     TestAsciiFloatString(FLT_MAX, "999999.9999");
 
+    TestAsciiPrecision();
+
+    TestBinaryDecoder();
+
+    TestAsciiParser();
+
+    TestPayloadFormat();
+
+    TestPacked();
+
+    TestQuaternionCompression();
+
+    TestAggregator();
+
+    TestComposite();
+
+    TestDescriptor();
+
+    TestCobs();
+
+    TestCompression();
+
+    TestIntern();
+
+    TestBatch();
+
+    TestUnchecked();
+
+    TestPrintable();
+
+    TestSerialAccessoryStream();
+
+    TestWriter();
+
+    TestCompactTimestamp();
+
+    TestCsv();
+
+    TestRouter();
+
+    TestWorstCaseSize();
+
+    TestPool();
+
     printf("Passed %d of %d\n", passCount, passCount + failCount);
 
     return failCount > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
@@ -236,5 +577,2075 @@ static void TestAsciiTimestampAndFloat(const uint64_t timestamp, const float flo
     }
 }
 
+static void TestAsciiPrecision(void) {
+    for (int precision = 0; precision <= XIMU3_ASCII_PRECISION_MAX; precision++) {
+        TestAsciiPrecisionFloat(0.0f, precision, NULL);
+        TestAsciiPrecisionFloat(1.2345678f, precision, NULL);
+        TestAsciiPrecisionFloat(-98765.4321f, precision, NULL);
+        TestAsciiPrecisionFloat(0.99999994f, precision, NULL); // fractional part rounds up to 1
+        TestAsciiPrecisionFloat(-0.0012345f, precision, NULL);
+    }
+
+    TestAsciiPrecisionFloat(0.50494999f, 4, NULL); // product of fraction and scale rounds up to 5049.5 as a float
+    TestAsciiPrecisionFloat(97.8283005f, 6, NULL);
+
+    TestAsciiPrecisionFloat(999999.5f, 0, "999999"); // rounds up to 1000000
+    TestAsciiPrecisionFloat(-999999.5f, 0, "-999999");
+    TestAsciiPrecisionFloat(FLT_MAX, 2, "999999.99");
+    TestAsciiPrecisionFloat(-FLT_MAX, 6, "-999999.999999");
+
+    TestAsciiPrecisionFloat(1.5f, -1, "2");
+    TestAsciiPrecisionFloat(1.5f, 7, "1.500000");
+
+    for (int precision = 0; precision <= XIMU3_ASCII_PRECISION_MAX; precision++) {
+        TestAsciiRotationMatrix(precision);
+    }
+
+    char string[XIMU3_SIZE_ASCII_TEMPERATURE + 1];
+    for (int precision = 0; precision <= XIMU3_ASCII_PRECISION_MAX; precision++) {
+        const Ximu3DataTemperature data = {UINT64_MAX, -FLT_MAX};
+        const size_t size = Ximu3AsciiTemperaturePrecision(string, sizeof(string), &data, precision);
+        if (size != (XIMU3_SIZE_ASCII_OVERHEAD + XIMU3_SIZE_ASCII_FLOAT_PRECISION(precision))) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tExpected: %d decimal places in %d bytes\n", precision, (int) (XIMU3_SIZE_ASCII_OVERHEAD + XIMU3_SIZE_ASCII_FLOAT_PRECISION(precision)));
+            printf("\tActual:   %d bytes\n", (int) size);
+        } else {
+            passCount++;
+        }
+    }
+}
+
+static void TestAsciiPrecisionFloat(const float floatValue, const int precision, const char *const floatString) {
+    char expected[256];
+    if (floatString == NULL) {
+        snprintf(expected, sizeof(expected), "T,0,%.*f\n", precision, (double) floatValue);
+    } else {
+        snprintf(expected, sizeof(expected), "T,0,%s\n", floatString);
+    }
+
+    char actual[256];
+    const Ximu3DataTemperature data = {
+        .timestamp = 0,
+        .temperature = floatValue,
+    };
+    const size_t messageSize = Ximu3AsciiTemperaturePrecision(actual, sizeof(actual), &data, precision);
+    actual[messageSize] = '\0';
+
+    if (strcmp(actual, expected) != 0) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tExpected: %s", expected);
+        printf("\tActual:   %s", actual);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestAsciiRotationMatrix(const int precision) {
+    const float values[] = {-0.4f, 123.456f, -654321.0f, 9.999999f, 0.0624f, -42.126f, 1e-7f, 6553.599f, -3.7f}; // 9 floats written as overlapping blocks
+    char expected[256];
+    int expectedSize = snprintf(expected, sizeof(expected), "R,123");
+    for (size_t index = 0; index < (sizeof(values) / sizeof(values[0])); index++) {
+        expectedSize += snprintf(&expected[expectedSize], sizeof(expected) - (size_t) expectedSize, ",%.*f", precision, (double) values[index]);
+    }
+    snprintf(&expected[expectedSize], sizeof(expected) - (size_t) expectedSize, "\n");
+
+    char actual[256];
+    const Ximu3DataRotationMatrix data = {123, values[0], values[1], values[2], values[3], values[4], values[5], values[6], values[7], values[8]};
+    const size_t messageSize = Ximu3AsciiRotationMatrixPrecision(actual, sizeof(actual), &data, precision);
+    actual[messageSize] = '\0';
+
+    if (strcmp(actual, expected) != 0) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tExpected: %s", expected);
+        printf("\tActual:   %s", actual);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestBinaryDecoder(void) {
+    const uint64_t timestamp = UINT64_C(0x0ADBDD0A0ADBDC00); // bytes that require byte stuffing
+    const float a = FloatFromBits(UINT32_C(0x0ADB0ADB));
+    const float b = FloatFromBits(UINT32_C(0xDBDC0ADD));
+    const uint8_t serialAccessory[] = {0x00, XIMU3_TERMINATION, 0xDB, 0xDC, 0xDD, 0xFF};
+    uint8_t message[1024];
+
+    const Ximu3DataInertial inertial = {timestamp, 1.0f, -2.0f, a, b, 1E-6f, -FLT_MAX};
+    TestBinaryDecoderMessage("Inertial", message, Ximu3BinaryInertial(message, sizeof(message), &inertial));
+
+    const Ximu3DataMagnetometer magnetometer = {timestamp, a, b, 3.0f};
+    TestBinaryDecoderMessage("Magnetometer", message, Ximu3BinaryMagnetometer(message, sizeof(message), &magnetometer));
+
+    const Ximu3DataHighGAccelerometer highGAccelerometer = {timestamp, b, a, -3.0f};
+    TestBinaryDecoderMessage("High-g accelerometer", message, Ximu3BinaryHighGAccelerometer(message, sizeof(message), &highGAccelerometer));
+
+    const Ximu3DataQuaternion quaternion = {timestamp, 1.0f, a, b, 0.0f};
+    TestBinaryDecoderMessage("Quaternion", message, Ximu3BinaryQuaternion(message, sizeof(message), &quaternion));
+
+    const Ximu3DataRotationMatrix rotationMatrix = {timestamp, 1.0f, 2.0f, 3.0f, 4.0f, a, 6.0f, 7.0f, b, 9.0f};
+    TestBinaryDecoderMessage("Rotation matrix", message, Ximu3BinaryRotationMatrix(message, sizeof(message), &rotationMatrix));
+
+    const Ximu3DataEulerAngles eulerAngles = {timestamp, 180.0f, a, -180.0f};
+    TestBinaryDecoderMessage("Euler angles", message, Ximu3BinaryEulerAngles(message, sizeof(message), &eulerAngles));
+
+    const Ximu3DataLinearAcceleration linearAcceleration = {timestamp, 1.0f, 0.0f, a, 0.0f, b, 2.0f, 3.0f};
+    TestBinaryDecoderMessage("Linear acceleration", message, Ximu3BinaryLinearAcceleration(message, sizeof(message), &linearAcceleration));
+
+    const Ximu3DataEarthAcceleration earthAcceleration = {timestamp, 1.0f, 0.0f, b, 0.0f, a, 2.0f, 3.0f};
+    TestBinaryDecoderMessage("Earth acceleration", message, Ximu3BinaryEarthAcceleration(message, sizeof(message), &earthAcceleration));
+
+    const Ximu3DataAhrsStatus ahrsStatus = {timestamp, true, false, true, false};
+    TestBinaryDecoderMessage("AHRS status", message, Ximu3BinaryAhrsStatus(message, sizeof(message), &ahrsStatus));
+
+    const Ximu3DataSerialAccessory serialAccessoryData = {timestamp, serialAccessory, sizeof(serialAccessory)};
+    TestBinaryDecoderMessage("Serial accessory", message, Ximu3BinarySerialAccessory(message, sizeof(message), &serialAccessoryData));
+
+    const Ximu3DataSync sync = {timestamp, true};
+    TestBinaryDecoderMessage("Sync", message, Ximu3BinarySync(message, sizeof(message), &sync));
+
+    const Ximu3DataLtc ltc = {timestamp, "01:23:45:67", 0};
+    TestBinaryDecoderMessage("LTC", message, Ximu3BinaryLtc(message, sizeof(message), &ltc));
+
+    const Ximu3DataTemperature temperature = {timestamp, a};
+    TestBinaryDecoderMessage("Temperature", message, Ximu3BinaryTemperature(message, sizeof(message), &temperature));
+
+    const Ximu3DataBattery battery = {timestamp, 100.0f, b, 1.0f};
+    TestBinaryDecoderMessage("Battery", message, Ximu3BinaryBattery(message, sizeof(message), &battery));
+
+    const Ximu3DataRssi rssi = {timestamp, 50.0f, a};
+    TestBinaryDecoderMessage("RSSI", message, Ximu3BinaryRssi(message, sizeof(message), &rssi));
+
+    const Ximu3DataButton button = {timestamp, true};
+    TestBinaryDecoderMessage("Button", message, Ximu3BinaryButton(message, sizeof(message), &button));
+
+    const Ximu3DataNotification notification = {timestamp, "Notification"};
+    TestBinaryDecoderMessage("Notification", message, Ximu3BinaryNotification(message, sizeof(message), &notification));
+
+    const Ximu3DataError error = {timestamp, "Error"};
+    TestBinaryDecoderMessage("Error", message, Ximu3BinaryError(message, sizeof(message), &error));
+}
+
+static void TestBinaryDecoderMessage(const char *const name, const void *const message, const size_t messageSize) {
+    static const uint8_t corrupt[] = {0x80 + XIMU3_ASCII_ID_INERTIAL, 0xDB, 0x00, 0x01, 0x02, XIMU3_TERMINATION}; // invalid escape sequence
+
+    for (int test = 0; test < 3; test++) {
+        Ximu3BinaryDecoderReset(&decoder);
+        decodedSize = 0;
+        decodeErrorCount = 0;
+
+        switch (test) {
+            case 0: // complete message
+                Ximu3BinaryDecoderProcess(&decoder, message, messageSize);
+                break;
+            case 1: // one byte at a time
+                for (size_t index = 0; index < messageSize; index++) {
+                    Ximu3BinaryDecoderProcess(&decoder, &((const uint8_t *) message)[index], 1);
+                }
+                break;
+            default: // resynchronise after corrupt message
+                Ximu3BinaryDecoderProcess(&decoder, corrupt, sizeof(corrupt));
+                Ximu3BinaryDecoderProcess(&decoder, message, messageSize);
+                break;
+        }
+
+        const int expectedErrorCount = test == 2 ? 1 : 0;
+        if ((decodedSize != messageSize) || (memcmp(decoded, message, messageSize) != 0) || (decodeErrorCount != expectedErrorCount)) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tBinary decoder %s test %d\n", name, test);
+        } else {
+            passCount++;
+        }
+    }
+}
+
+static void TestAsciiParser(void) {
+    const uint64_t timestamp = UINT64_MAX;
+    const uint8_t serialAccessory[] = {'a', ',', 'b', '#', '1', '='}; // commas are part of the bytes
+    char message[1024];
+
+    const Ximu3DataInertial inertial = {timestamp, 1.0f, -2.5f, 123.4567f, -FLT_MAX, 0.0001f, -0.0004f};
+    TestAsciiParserMessage("Inertial", message, Ximu3AsciiInertial(message, sizeof(message), &inertial));
+
+    const Ximu3DataMagnetometer magnetometer = {timestamp, 999999.9999f, -0.5f, 3.0f};
+    TestAsciiParserMessage("Magnetometer", message, Ximu3AsciiMagnetometer(message, sizeof(message), &magnetometer));
+
+    const Ximu3DataHighGAccelerometer highGAccelerometer = {timestamp, -16.0f, 0.0625f, -3.0f};
+    TestAsciiParserMessage("High-g accelerometer", message, Ximu3AsciiHighGAccelerometer(message, sizeof(message), &highGAccelerometer));
+
+    const Ximu3DataQuaternion quaternion = {timestamp, 1.0f, -0.7071f, 0.7071f, 0.0f};
+    TestAsciiParserMessage("Quaternion", message, Ximu3AsciiQuaternion(message, sizeof(message), &quaternion));
+
+    const Ximu3DataRotationMatrix rotationMatrix = {timestamp, 1.0f, 2.0f, 3.0f, 4.0f, -5.5f, 6.0f, 7.0f, 8.25f, -9.0f};
+    TestAsciiParserMessage("Rotation matrix", message, Ximu3AsciiRotationMatrix(message, sizeof(message), &rotationMatrix));
+
+    const Ximu3DataEulerAngles eulerAngles = {timestamp, 180.0f, 45.1234f, -180.0f};
+    TestAsciiParserMessage("Euler angles", message, Ximu3AsciiEulerAngles(message, sizeof(message), &eulerAngles));
+
+    const Ximu3DataLinearAcceleration linearAcceleration = {timestamp, 1.0f, 0.0f, 0.5f, 0.0f, -0.0123f, 2.0f, 3.0f};
+    TestAsciiParserMessage("Linear acceleration", message, Ximu3AsciiLinearAcceleration(message, sizeof(message), &linearAcceleration));
+
+    const Ximu3DataEarthAcceleration earthAcceleration = {timestamp, 1.0f, 0.0f, -0.5f, 0.0f, 0.0123f, 2.0f, 3.0f};
+    TestAsciiParserMessage("Earth acceleration", message, Ximu3AsciiEarthAcceleration(message, sizeof(message), &earthAcceleration));
+
+    const Ximu3DataAhrsStatus ahrsStatus = {timestamp, true, false, true, false};
+    TestAsciiParserMessage("AHRS status", message, Ximu3AsciiAhrsStatus(message, sizeof(message), &ahrsStatus));
+
+    const Ximu3DataSerialAccessory serialAccessoryData = {timestamp, serialAccessory, sizeof(serialAccessory)};
+    TestAsciiParserMessage("Serial accessory", message, Ximu3AsciiSerialAccessory(message, sizeof(message), &serialAccessoryData));
+
+    const Ximu3DataSync sync = {timestamp, true};
+    TestAsciiParserMessage("Sync", message, Ximu3AsciiSync(message, sizeof(message), &sync));
+
+    const Ximu3DataLtc ltc = {timestamp, "01:23:45:67", 0};
+    TestAsciiParserMessage("LTC", message, Ximu3AsciiLtc(message, sizeof(message), &ltc));
+
+    const Ximu3DataTemperature temperature = {timestamp, -40.5f};
+    TestAsciiParserMessage("Temperature", message, Ximu3AsciiTemperature(message, sizeof(message), &temperature));
+
+    const Ximu3DataBattery battery = {timestamp, 100.0f, 4.2f, 1.0f};
+    TestAsciiParserMessage("Battery", message, Ximu3AsciiBattery(message, sizeof(message), &battery));
+
+    const Ximu3DataRssi rssi = {timestamp, 50.0f, -60.0f};
+    TestAsciiParserMessage("RSSI", message, Ximu3AsciiRssi(message, sizeof(message), &rssi));
+
+    const Ximu3DataButton button = {timestamp, true};
+    TestAsciiParserMessage("Button", message, Ximu3AsciiButton(message, sizeof(message), &button));
+
+    const Ximu3DataNotification notification = {timestamp, "Notification, #1"};
+    TestAsciiParserMessage("Notification", message, Ximu3AsciiNotification(message, sizeof(message), &notification));
+
+    const Ximu3DataError error = {timestamp, ""};
+    TestAsciiParserMessage("Error", message, Ximu3AsciiError(message, sizeof(message), &error));
+
+    const Ximu3DataNotification notificationReference = {timestamp, "#3"}; // plain strings that look like interned strings
+    TestAsciiParserMessage("Notification reference", message, Ximu3AsciiNotification(message, sizeof(message), &notificationReference));
+
+    const Ximu3DataNotification notificationDefinition = {timestamp, "#2=Battery low"};
+    TestAsciiParserMessage("Notification definition", message, Ximu3AsciiNotification(message, sizeof(message), &notificationDefinition));
+
+    const Ximu3DataError errorDefinition = {timestamp, "#0="};
+    TestAsciiParserMessage("Error definition", message, Ximu3AsciiError(message, sizeof(message), &errorDefinition));
+
+    // Numbers
+    TestAsciiParserNumber("0", true);
+    TestAsciiParserNumber("-0.5", true);
+    TestAsciiParserNumber("7.", false);
+    TestAsciiParserNumber(".5", false);
+    TestAsciiParserNumber("-", false);
+    TestAsciiParserNumber("+1", false);
+    TestAsciiParserNumber("1e3", false);
+    TestAsciiParserNumber("0.1234567", false);
+    TestAsciiParserNumber("123456789.123456", true);
+    TestAsciiParserNumber("1234567890", false);
+    TestAsciiParserNumber("0.1", true);
+    TestAsciiParserNumber("-999999.9999", true);
+    TestAsciiParserNumber("16777217", true);
+    TestAsciiParserNumber("0.000001", true);
+    TestAsciiParserNumber("3.402823", true);
+
+    // Compact timestamps, interned strings, ignored lines and buffer overrun
+    static const uint64_t timestamps[] = {1000, 1010, 3001210, 3001211};
+    Ximu3CompactTimestamp compactTimestamp = {.absolutePeriod = 4};
+    Ximu3Intern intern = {0};
+    char stream[4096];
+    size_t streamSize = 0;
+    char expected[1024];
+    size_t expectedSize = 0;
+    for (size_t index = 0; index < (sizeof(timestamps) / sizeof(timestamps[0])); index++) {
+        const Ximu3DataTemperature data = {timestamps[index], 20.0f};
+        expectedSize += Ximu3AsciiTemperature(&expected[expectedSize], sizeof(expected) - expectedSize, &data);
+        const size_t messageSize = Ximu3AsciiTemperature(&stream[streamSize], sizeof(stream) - streamSize, &data);
+        streamSize += Ximu3AsciiCompactTimestamp(&compactTimestamp, &stream[streamSize], messageSize);
+        const Ximu3DataNotification internedNotification = {timestamps[index], "Battery low"};
+        expectedSize += Ximu3AsciiNotification(&expected[expectedSize], sizeof(expected) - expectedSize, &internedNotification);
+        streamSize += Ximu3AsciiNotificationInterned(&stream[streamSize], sizeof(stream) - streamSize, &internedNotification, &intern);
+    }
+    static const char ignored[] = "{\"ping\":null}\r\n\r\n";
+    memcpy(&stream[streamSize], ignored, sizeof(ignored) - 1);
+    streamSize += sizeof(ignored) - 1;
+    memset(&stream[streamSize], 'A', sizeof(asciiParser.buffer));
+    streamSize += sizeof(asciiParser.buffer);
+    stream[streamSize++] = '\n';
+    memcpy(&stream[streamSize], expected, expectedSize);
+    streamSize += expectedSize;
+    Ximu3AsciiParserReset(&asciiParser);
+    parsedSize = 0;
+    parseErrorCount = 0;
+    for (size_t index = 0; index < streamSize; index += 7) {
+        Ximu3AsciiParserProcess(&asciiParser, &stream[index], (streamSize - index) < 7 ? (streamSize - index) : 7);
+    }
+    const bool stream1 = (parsedSize == (2 * expectedSize)) && (memcmp(parsed, expected, expectedSize) == 0) && (memcmp(&parsed[expectedSize], expected, expectedSize) == 0) && (parseErrorCount == 1);
+
+    // Compact message and interned reference without previous message
+    static const char orphans[] = "t,10,20.0000\nN,1,\x1F#0\nZ,1,1.0000\nP,1,1.0000\n";
+    Ximu3AsciiParserReset(&asciiParser);
+    parsedSize = 0;
+    parseErrorCount = 0;
+    Ximu3AsciiParserProcess(&asciiParser, orphans, sizeof(orphans) - 1);
+    const bool stream2 = (parsedSize == 0) && (parseErrorCount == 4);
+
+    // Plain string that looks like a definition does not define an interned string
+    static const char plainDefinition[] = "N,1,#2=Battery low\n";
+    static const char plainReference[] = "N,1,\x1F#2\n";
+    Ximu3AsciiParserReset(&asciiParser);
+    parsedSize = 0;
+    parseErrorCount = 0;
+    Ximu3AsciiParserProcess(&asciiParser, plainDefinition, sizeof(plainDefinition) - 1);
+    Ximu3AsciiParserProcess(&asciiParser, plainReference, sizeof(plainReference) - 1);
+    const bool stream3 = (parsedSize == (sizeof(plainDefinition) - 1)) && (memcmp(parsed, plainDefinition, parsedSize) == 0) && (parseErrorCount == 1);
+
+    if ((stream1 == false) || (stream2 == false) || (stream3 == false)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tASCII parser stream\n");
+    } else {
+        passCount++;
+    }
+}
+
+static void TestAsciiParserMessage(const char *const name, const void *const message, const size_t messageSize) {
+    static const char corrupt[] = "I,0,1.0000\n{\"ping\":null}\n"; // missing fields followed by a command response
+
+    for (int test = 0; test < 3; test++) {
+        Ximu3AsciiParserReset(&asciiParser);
+        parsedSize = 0;
+        parseErrorCount = 0;
+
+        switch (test) {
+            case 0: // complete message
+                Ximu3AsciiParserProcess(&asciiParser, message, messageSize);
+                break;
+            case 1: // one byte at a time
+                for (size_t index = 0; index < messageSize; index++) {
+                    Ximu3AsciiParserProcess(&asciiParser, &((const char *) message)[index], 1);
+                }
+                break;
+            default: // resynchronise after corrupt message
+                Ximu3AsciiParserProcess(&asciiParser, corrupt, sizeof(corrupt) - 1);
+                Ximu3AsciiParserProcess(&asciiParser, message, messageSize);
+                break;
+        }
+
+        const int expectedErrorCount = test == 2 ? 1 : 0;
+        if ((parsedSize != messageSize) || (memcmp(parsed, message, messageSize) != 0) || (parseErrorCount != expectedErrorCount)) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tASCII parser %s test %d\n", name, test);
+        } else {
+            passCount++;
+        }
+    }
+}
+
+static void TestAsciiParserNumber(const char *const number, const bool valid) {
+    char message[64];
+    const int messageSize = snprintf(message, sizeof(message), "T,1,%s\n", number);
+    Ximu3AsciiParserReset(&asciiParser);
+    parsedSize = 0;
+    parsedTemperature = NAN;
+    parseErrorCount = 0;
+    Ximu3AsciiParserProcess(&asciiParser, message, (size_t) messageSize);
+
+    const bool result = valid ? ((parseErrorCount == 0) && (parsedTemperature == strtof(number, NULL))) : ((parseErrorCount == 1) && (parsedSize == 0));
+    if (result == false) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tASCII parser number %s\n", number);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestPayloadFormat(void) {
+    const uint64_t timestamp = UINT64_C(0x0ADBDD0A0ADBDC00); // bytes that require byte stuffing
+    const float a = FloatFromBits(UINT32_C(0x0ADB0ADB));
+    const float b = FloatFromBits(UINT32_C(0xDBDC0ADD));
+    uint8_t message[1024];
+
+    // Decode and encode again with each 16-bit payload format
+    static const Ximu3BinaryPayloadFormat payloadFormats[] = {Ximu3BinaryPayloadFormatFloat16, Ximu3BinaryPayloadFormatInt16};
+    for (size_t index = 0; index < (sizeof(payloadFormats) / sizeof(payloadFormats[0])); index++) {
+        const Ximu3BinaryPayloadFormat payloadFormat = payloadFormats[index];
+        decoder.payloadFormat = payloadFormat;
+
+        const Ximu3DataInertial inertial = {timestamp, 1.0f, -2.0f, a, b, 1E-6f, -FLT_MAX};
+        TestBinaryDecoderMessage("Inertial 16-bit", message, Ximu3BinaryInertialPayloadFormat(message, sizeof(message), &inertial, payloadFormat));
+
+        const Ximu3DataMagnetometer magnetometer = {timestamp, a, b, 3.0f};
+        TestBinaryDecoderMessage("Magnetometer 16-bit", message, Ximu3BinaryMagnetometerPayloadFormat(message, sizeof(message), &magnetometer, payloadFormat));
+
+        const Ximu3DataHighGAccelerometer highGAccelerometer = {timestamp, b, a, -3.0f};
+        TestBinaryDecoderMessage("High-g accelerometer 16-bit", message, Ximu3BinaryHighGAccelerometerPayloadFormat(message, sizeof(message), &highGAccelerometer, payloadFormat));
+
+        const Ximu3DataQuaternion quaternion = {timestamp, 1.0f, a, b, 0.0f};
+        TestBinaryDecoderMessage("Quaternion 16-bit", message, Ximu3BinaryQuaternionPayloadFormat(message, sizeof(message), &quaternion, payloadFormat));
+
+        const Ximu3DataRotationMatrix rotationMatrix = {timestamp, 1.0f, 2.0f, 3.0f, 4.0f, a, 6.0f, 7.0f, b, 9.0f};
+        TestBinaryDecoderMessage("Rotation matrix 16-bit", message, Ximu3BinaryRotationMatrixPayloadFormat(message, sizeof(message), &rotationMatrix, payloadFormat));
+
+        const Ximu3DataEulerAngles eulerAngles = {timestamp, 180.0f, a, -180.0f};
+        TestBinaryDecoderMessage("Euler angles 16-bit", message, Ximu3BinaryEulerAnglesPayloadFormat(message, sizeof(message), &eulerAngles, payloadFormat));
+
+        const Ximu3DataLinearAcceleration linearAcceleration = {timestamp, 1.0f, 0.0f, a, 0.0f, b, 2.0f, 3.0f};
+        TestBinaryDecoderMessage("Linear acceleration 16-bit", message, Ximu3BinaryLinearAccelerationPayloadFormat(message, sizeof(message), &linearAcceleration, payloadFormat));
+
+        const Ximu3DataEarthAcceleration earthAcceleration = {timestamp, 1.0f, 0.0f, b, 0.0f, a, 2.0f, 3.0f};
+        TestBinaryDecoderMessage("Earth acceleration 16-bit", message, Ximu3BinaryEarthAccelerationPayloadFormat(message, sizeof(message), &earthAcceleration, payloadFormat));
+    }
+    decoder.payloadFormat = Ximu3BinaryPayloadFormatFloat32;
+
+    // Half float rounding, overflow and subnormal
+    const Ximu3DataQuaternion quaternion = {0, 1.0f, -2.0f, 65520.0f, 5.9604645E-8f};
+    static const uint8_t quaternionFloat16[] = {0x80 + XIMU3_ASCII_ID_QUATERNION, 0, 0, 0, 0, 0, 0, 0, 0, 0x00, 0x3C, 0x00, 0xC0, 0x00, 0x7C, 0x01, 0x00, XIMU3_TERMINATION};
+    TestPayloadFormatMessage("Float16", message, Ximu3BinaryQuaternionPayloadFormat(message, sizeof(message), &quaternion, Ximu3BinaryPayloadFormatFloat16), quaternionFloat16, sizeof(quaternionFloat16));
+
+    // Scaled integer rounding and saturation
+    const Ximu3DataEulerAngles eulerAngles = {0, 90.0f, -180.0f, 720.0f};
+    static const uint8_t eulerAnglesInt16[] = {0x80 + XIMU3_ASCII_ID_EULER_ANGLES, 0, 0, 0, 0, 0, 0, 0, 0, 0x00, 0x40, 0x01, 0x80, 0xFF, 0x7F, XIMU3_TERMINATION};
+    TestPayloadFormatMessage("Int16", message, Ximu3BinaryEulerAnglesPayloadFormat(message, sizeof(message), &eulerAngles, Ximu3BinaryPayloadFormatInt16), eulerAnglesInt16, sizeof(eulerAnglesInt16));
+}
+
+static void TestPayloadFormatMessage(const char *const name, const void *const message, const size_t messageSize, const uint8_t *const expected, const size_t expectedSize) {
+    if ((messageSize != expectedSize) || (memcmp(message, expected, expectedSize) != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tPayload format %s\n", name);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestPacked(void) {
+    uint8_t message[1024];
+    uint8_t expected[1024];
+
+    for (int flags = 0; flags < 16; flags++) {
+        const Ximu3DataAhrsStatus ahrsStatus = {UINT64_C(0x0ADBDD0A0ADBDC00), (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0, (flags & 8) != 0};
+        TestPackedMessage("AHRS status", message, Ximu3BinaryAhrsStatusPacked(message, sizeof(message), &ahrsStatus), XIMU3_SIZE_BINARY_AHRS_STATUS_PACKED, expected, Ximu3BinaryAhrsStatus(expected, sizeof(expected), &ahrsStatus));
+    }
+
+    // Worst case AHRS status, flags of angular rate recovery and magnetic recovery are 0x0A
+    const Ximu3DataAhrsStatus worstCaseAhrsStatus = {UINT64_C(0x0A0A0A0A0A0A0A0A), false, true, false, true};
+    uint8_t worstCase[XIMU3_SIZE_BINARY_AHRS_STATUS_PACKED];
+    const size_t worstCaseSize = Ximu3BinaryAhrsStatusPacked(worstCase, sizeof(worstCase), &worstCaseAhrsStatus);
+    const size_t expectedSize = Ximu3BinaryAhrsStatusPacked(expected, sizeof(expected), &worstCaseAhrsStatus);
+    if ((expectedSize != XIMU3_SIZE_BINARY_AHRS_STATUS_PACKED) || (worstCaseSize != expectedSize) || (memcmp(worstCase, expected, expectedSize) != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tPacked AHRS status worst case size\n");
+    } else {
+        passCount++;
+    }
+
+    for (int state = 0; state < 2; state++) {
+        const Ximu3DataSync sync = {UINT64_C(1), state != 0};
+        TestPackedMessage("Sync", message, Ximu3BinarySyncPacked(message, sizeof(message), &sync), XIMU3_SIZE_BINARY_SYNC_PACKED, expected, Ximu3BinarySync(expected, sizeof(expected), &sync));
+
+        const Ximu3DataButton button = {UINT64_C(2), state != 0};
+        TestPackedMessage("Button", message, Ximu3BinaryButtonPacked(message, sizeof(message), &button), XIMU3_SIZE_BINARY_BUTTON_PACKED, expected, Ximu3BinaryButton(expected, sizeof(expected), &button));
+    }
+
+    static const char *const timecodes[] = {"00:00:00:00", "23:59:59:59", "10:10:10:10", "01:23:45;27"}; // "10" requires byte stuffing
+    for (size_t index = 0; index < (sizeof(timecodes) / sizeof(timecodes[0])); index++) {
+        const Ximu3DataLtc ltc = {UINT64_C(3), timecodes[index], 0};
+        TestPackedMessage("LTC", message, Ximu3BinaryLtcPacked(message, sizeof(message), &ltc), XIMU3_SIZE_BINARY_LTC_PACKED, expected, Ximu3BinaryLtc(expected, sizeof(expected), &ltc));
+
+        uint32_t packedTimecode = 0;
+        Ximu3LtcPack(timecodes[index], &packedTimecode);
+        const Ximu3DataLtc prePacked = {UINT64_C(3), NULL, packedTimecode};
+        TestPackedMessage("LTC pre-packed", message, Ximu3BinaryLtcPacked(message, sizeof(message), &prePacked), XIMU3_SIZE_BINARY_LTC_PACKED, expected, Ximu3BinaryLtc(expected, sizeof(expected), &ltc));
+        TestPackedMessage("LTC pre-packed string", message, Ximu3BinaryLtc(message, sizeof(message), &prePacked), XIMU3_SIZE_BINARY_LTC, expected, Ximu3BinaryLtc(expected, sizeof(expected), &ltc));
+    }
+
+    // Invalid timecodes
+    static const char *const invalidTimecodes[] = {"", "01:23:45", "24:00:00:00", "00:60:00:00", "00:00:00:60", "00;00:00:00", "0a:00:00:00", "00:00:00:000"};
+    bool invalid = true;
+    for (size_t index = 0; index < (sizeof(invalidTimecodes) / sizeof(invalidTimecodes[0])); index++) {
+        const Ximu3DataLtc ltc = {UINT64_C(3), invalidTimecodes[index], 0};
+        uint32_t packedTimecode;
+        if (Ximu3LtcPack(invalidTimecodes[index], &packedTimecode) || (Ximu3BinaryLtcPacked(message, sizeof(message), &ltc) != 0)) {
+            invalid = false;
+        }
+    }
+    char timecode[XIMU3_LTC_TIMECODE_SIZE];
+    const Ximu3DataLtc invalidPacked = {UINT64_C(3), NULL, UINT32_C(0x18000000)}; // 24 hours
+    if ((invalid == false) || Ximu3LtcUnpack(invalidPacked.packedTimecode, timecode) || (Ximu3BinaryLtc(message, sizeof(message), &invalidPacked) != 0) || (Ximu3AsciiLtc(message, sizeof(message), &invalidPacked) != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tPacked LTC invalid\n");
+    } else {
+        passCount++;
+    }
+}
+
+static void TestPackedMessage(const char *const name, const void *const message, const size_t messageSize, const size_t maximumMessageSize, const void *const expected, const size_t expectedSize) {
+    Ximu3BinaryDecoderReset(&decoder);
+    decodedSize = 0;
+    decodeErrorCount = 0;
+    Ximu3BinaryDecoderProcess(&decoder, message, messageSize);
+
+    if ((messageSize > maximumMessageSize) || (decodedSize != expectedSize) || (memcmp(decoded, expected, expectedSize) != 0) || (decodeErrorCount != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tPacked %s\n", name);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestQuaternionCompression(void) {
+    const uint64_t timestamp = UINT64_C(0x0ADBDD0A0ADBDC00); // bytes that require byte stuffing
+    uint8_t message[1024];
+
+    // Each largest component, negative largest component, equal components, not normalised, and zero length
+    static const float quaternions[][4] = {
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f, 1.0f},
+        {0.1f, -0.9f, 0.3f, 0.2f},
+        {-0.5f, 0.5f, -0.5f, 0.5f},
+        {0.0f, 0.0f, 0.70710678f, -0.70710678f},
+        {2.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f, 0.0f},
+    };
+    static const Ximu3BinaryQuaternionCompression quaternionCompressions[] = {Ximu3BinaryQuaternionCompression32Bit, Ximu3BinaryQuaternionCompression48Bit};
+    static const float maximumErrors[] = {0.3f, 0.01f}; // degrees
+    static const Ximu3BinaryPayloadFormat payloadFormats[] = {Ximu3BinaryPayloadFormatFloat32, Ximu3BinaryPayloadFormatFloat16, Ximu3BinaryPayloadFormatInt16};
+    for (size_t compressionIndex = 0; compressionIndex < (sizeof(quaternionCompressions) / sizeof(quaternionCompressions[0])); compressionIndex++) {
+        const Ximu3BinaryQuaternionCompression quaternionCompression = quaternionCompressions[compressionIndex];
+        const float maximumError = maximumErrors[compressionIndex];
+        for (size_t formatIndex = 0; formatIndex < (sizeof(payloadFormats) / sizeof(payloadFormats[0])); formatIndex++) {
+            const Ximu3BinaryPayloadFormat payloadFormat = payloadFormats[formatIndex];
+            compressionDecoder.payloadFormat = payloadFormat;
+            for (size_t index = 0; index < (sizeof(quaternions) / sizeof(quaternions[0])); index++) {
+                const float *const q = quaternions[index];
+                const float expected[] = {q[0], q[1], q[2], q[3], 1.0f, -2.0f, 3.0f};
+
+                const Ximu3DataQuaternion quaternion = {timestamp, q[0], q[1], q[2], q[3]};
+                TestQuaternionCompressionMessage("Quaternion", message, Ximu3BinaryQuaternionCompressed(message, sizeof(message), &quaternion, payloadFormat, quaternionCompression), XIMU3_SIZE_BINARY_QUATERNION_COMPRESSED, expected, 4, maximumError);
+
+                const Ximu3DataLinearAcceleration linearAcceleration = {timestamp, q[0], q[1], q[2], q[3], 1.0f, -2.0f, 3.0f};
+                TestQuaternionCompressionMessage("Linear acceleration", message, Ximu3BinaryLinearAccelerationCompressed(message, sizeof(message), &linearAcceleration, payloadFormat, quaternionCompression), XIMU3_SIZE_BINARY_LINEAR_ACCELERATION_COMPRESSED, expected, 7, maximumError);
+
+                const Ximu3DataEarthAcceleration earthAcceleration = {timestamp, q[0], q[1], q[2], q[3], 1.0f, -2.0f, 3.0f};
+                TestQuaternionCompressionMessage("Earth acceleration", message, Ximu3BinaryEarthAccelerationCompressed(message, sizeof(message), &earthAcceleration, payloadFormat, quaternionCompression), XIMU3_SIZE_BINARY_EARTH_ACCELERATION_COMPRESSED, expected, 7, maximumError);
+            }
+        }
+
+        // Pseudo-random quaternions
+        compressionDecoder.payloadFormat = Ximu3BinaryPayloadFormatFloat32;
+        uint32_t seed = 1;
+        for (int index = 0; index < 25; index++) {
+            float q[4];
+            for (int component = 0; component < 4; component++) {
+                seed = (seed * UINT32_C(1664525)) + UINT32_C(1013904223);
+                q[component] = ((float) (seed >> 8) / 8388608.0f) - 1.0f;
+            }
+            const Ximu3DataQuaternion quaternion = {timestamp, q[0], q[1], q[2], q[3]};
+            TestQuaternionCompressionMessage("Quaternion pseudo-random", message, Ximu3BinaryQuaternionCompressed(message, sizeof(message), &quaternion, Ximu3BinaryPayloadFormatFloat32, quaternionCompression), XIMU3_SIZE_BINARY_QUATERNION_COMPRESSED, q, 4, maximumError);
+        }
+    }
+    compressionDecoder.payloadFormat = Ximu3BinaryPayloadFormatFloat32;
+
+    // No compression
+    const Ximu3DataQuaternion quaternion = {timestamp, 1.0f, 0.0f, 0.0f, 0.0f};
+    uint8_t expected[1024];
+    const size_t messageSize = Ximu3BinaryQuaternionCompressed(message, sizeof(message), &quaternion, Ximu3BinaryPayloadFormatFloat16, Ximu3BinaryQuaternionCompressionNone);
+    const size_t expectedSize = Ximu3BinaryQuaternionPayloadFormat(expected, sizeof(expected), &quaternion, Ximu3BinaryPayloadFormatFloat16);
+    if ((messageSize != expectedSize) || (memcmp(message, expected, expectedSize) != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tCompressed Quaternion none\n");
+    } else {
+        passCount++;
+    }
+}
+
+static void TestQuaternionCompressionMessage(const char *const name, const void *const message, const size_t messageSize, const size_t maximumMessageSize, const float *const expected, const size_t numberOfValues, const float maximumError) {
+    Ximu3BinaryDecoderReset(&compressionDecoder);
+    decompressedCount = 0;
+    decodeErrorCount = 0;
+    Ximu3BinaryDecoderProcess(&compressionDecoder, message, messageSize);
+
+    // Angle between quaternions, calculated from the chord length for precision. A zero length quaternion is expected to be the identity quaternion.
+    static const float identity[] = {1.0f, 0.0f, 0.0f, 0.0f};
+    const float norm = sqrtf((expected[0] * expected[0]) + (expected[1] * expected[1]) + (expected[2] * expected[2]) + (expected[3] * expected[3]));
+    const float *const q = norm > 0.0f ? expected : identity;
+    const float scale = norm > 0.0f ? 1.0f / norm : 1.0f;
+    const float sign = ((q[0] * decompressed[0]) + (q[1] * decompressed[1]) + (q[2] * decompressed[2]) + (q[3] * decompressed[3])) < 0.0f ? -1.0f : 1.0f;
+    float chordSquared = 0.0f;
+    for (int index = 0; index < 4; index++) {
+        const float difference = (q[index] * scale) - (sign * decompressed[index]);
+        chordSquared += difference * difference;
+    }
+    const float error = 4.0f * asinf(sqrtf(chordSquared) / 2.0f) * (180.0f / 3.14159265f);
+
+    bool valuesMatch = true;
+    for (size_t index = 4; index < numberOfValues; index++) {
+        valuesMatch = valuesMatch && (fabsf(decompressed[index] - expected[index]) < 0.001f);
+    }
+
+    if ((messageSize > maximumMessageSize) || (decompressedCount != 1) || (decodeErrorCount != 0) || (error > maximumError) || (valuesMatch == false)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tCompressed %s, error %f degrees\n", name, (double) error);
+    } else {
+        passCount++;
+    }
+}
+
+static void DecompressedQuaternion(const Ximu3DataQuaternion *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    const float values[] = {data->w, data->x, data->y, data->z};
+    memcpy(decompressed, values, sizeof(values));
+    decompressedCount++;
+}
+
+static void DecompressedLinearAcceleration(const Ximu3DataLinearAcceleration *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    const float values[] = {data->quaternionW, data->quaternionX, data->quaternionY, data->quaternionZ, data->linearAccelerationX, data->linearAccelerationY, data->linearAccelerationZ};
+    memcpy(decompressed, values, sizeof(values));
+    decompressedCount++;
+}
+
+static void DecompressedEarthAcceleration(const Ximu3DataEarthAcceleration *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    const float values[] = {data->quaternionW, data->quaternionX, data->quaternionY, data->quaternionZ, data->earthAccelerationX, data->earthAccelerationY, data->earthAccelerationZ};
+    memcpy(decompressed, values, sizeof(values));
+    decompressedCount++;
+}
+
+static void TestAggregator(void) {
+    static const Ximu3BinaryPayloadFormat payloadFormats[] = {Ximu3BinaryPayloadFormatFloat32, Ximu3BinaryPayloadFormatFloat16};
+    for (size_t index = 0; index < (sizeof(payloadFormats) / sizeof(payloadFormats[0])); index++) {
+        Ximu3BinaryAggregator numberOfSamplesAggregator = {
+            .maximumNumberOfSamples = 4,
+            .payloadFormat = payloadFormats[index],
+            .write = AggregatorWrite,
+        };
+        TestAggregatorSamples("number of samples", &numberOfSamplesAggregator, 4);
+
+        Ximu3BinaryAggregator sizeAggregator = {
+            .maximumSize = 160,
+            .payloadFormat = payloadFormats[index],
+            .write = AggregatorWrite,
+        };
+        TestAggregatorSamples("size", &sizeAggregator, payloadFormats[index] == Ximu3BinaryPayloadFormatFloat32 ? 4 : 3);
+    }
+}
+
+static void TestAggregatorSamples(const char *const name, Ximu3BinaryAggregator *const aggregator, const int expectedNumberOfWrites) {
+    const uint64_t timestamp = UINT64_C(0x0A0A0A0A0A0A0A0A); // bytes that require byte stuffing
+    const float a = FloatFromBits(UINT32_C(0x0ADB0ADB));
+    uint8_t expected[1024];
+    size_t expectedSize = 0;
+    aggregatedSize = 0;
+    aggregatedNumberOfWrites = 0;
+    aggregatedMaximumWriteSize = 0;
+
+    // Inertial samples, then a magnetometer sample, then inertial samples after a large timestamp jump
+    for (int index = 0; index < 9; index++) {
+        if (index == 6) {
+            const Ximu3DataMagnetometer magnetometer = {timestamp + 60, a, 2.0f, 3.0f};
+            expectedSize += Ximu3BinaryMagnetometerPayloadFormat(&expected[expectedSize], sizeof(expected) - expectedSize, &magnetometer, aggregator->payloadFormat);
+            Ximu3BinaryAggregatorMagnetometer(aggregator, &magnetometer);
+        }
+        const uint64_t offset = index < 6 ? (uint64_t) (10 * index) : (uint64_t) (3000000 + index);
+        const Ximu3DataInertial inertial = {timestamp + offset, 1.0f, -2.0f, a, (float) index, 1E-6f, 100.0f};
+        expectedSize += Ximu3BinaryInertialPayloadFormat(&expected[expectedSize], sizeof(expected) - expectedSize, &inertial, aggregator->payloadFormat);
+        Ximu3BinaryAggregatorInertial(aggregator, &inertial);
+    }
+    Ximu3BinaryAggregatorFlush(aggregator);
+
+    // Decode
+    Ximu3BinaryDecoderReset(&decoder);
+    decoder.payloadFormat = aggregator->payloadFormat;
+    decodedSize = 0;
+    decodeErrorCount = 0;
+    Ximu3BinaryDecoderProcess(&decoder, aggregated, aggregatedSize);
+    decoder.payloadFormat = Ximu3BinaryPayloadFormatFloat32;
+
+    const size_t maximumWriteSize = aggregator->maximumSize == 0 ? XIMU3_SIZE_BINARY_AGGREGATE : aggregator->maximumSize;
+    if ((aggregatedNumberOfWrites != expectedNumberOfWrites) || (aggregatedMaximumWriteSize > maximumWriteSize) || (aggregatedSize >= expectedSize) ||
+        (decodedSize != expectedSize) || (memcmp(decoded, expected, expectedSize) != 0) || (decodeErrorCount != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tAggregator %s\n", name);
+    } else {
+        passCount++;
+    }
+}
+
+static void AggregatorWrite(const void *const data, const size_t numberOfBytes, void *const context) {
+    (void) context; // avoid compiler warning
+    memcpy(&aggregated[aggregatedSize], data, numberOfBytes);
+    aggregatedSize += numberOfBytes;
+    aggregatedNumberOfWrites++;
+    if (numberOfBytes > aggregatedMaximumWriteSize) {
+        aggregatedMaximumWriteSize = numberOfBytes;
+    }
+}
+
+static void TestComposite(void) {
+    const uint64_t timestamp = UINT64_C(0x0ADBDD0A0ADBDC00); // bytes that require byte stuffing
+    const float a = FloatFromBits(UINT32_C(0x0ADB0ADB));
+    const Ximu3DataInertial inertial = {0, 1.0f, -2.0f, a, 4.0f, 1E-6f, 100.0f};
+    const Ximu3DataMagnetometer magnetometer = {0, a, 2.0f, 3.0f};
+    const Ximu3DataHighGAccelerometer highGAccelerometer = {0, 10.0f, a, -300.0f};
+    const Ximu3DataTemperature temperature = {0, 25.0f};
+    const Ximu3DataQuaternion quaternion = {0, 1.0f, a, 0.5f, 0.0f};
+    const Ximu3DataEulerAngles eulerAngles = {0, 180.0f, a, -180.0f};
+
+    static const Ximu3BinaryPayloadFormat payloadFormats[] = {Ximu3BinaryPayloadFormatFloat32, Ximu3BinaryPayloadFormatFloat16, Ximu3BinaryPayloadFormatInt16};
+    for (size_t index = 0; index < (sizeof(payloadFormats) / sizeof(payloadFormats[0])); index++) {
+        const Ximu3BinaryPayloadFormat payloadFormat = payloadFormats[index];
+
+        // Expected messages in order of presence bitmask
+        uint8_t expected[1024];
+        size_t expectedSize = 0;
+        Ximu3DataInertial inertial_ = inertial;
+        inertial_.timestamp = timestamp;
+        expectedSize += Ximu3BinaryInertialPayloadFormat(&expected[expectedSize], sizeof(expected) - expectedSize, &inertial_, payloadFormat);
+        Ximu3DataMagnetometer magnetometer_ = magnetometer;
+        magnetometer_.timestamp = timestamp;
+        expectedSize += Ximu3BinaryMagnetometerPayloadFormat(&expected[expectedSize], sizeof(expected) - expectedSize, &magnetometer_, payloadFormat);
+        Ximu3DataHighGAccelerometer highGAccelerometer_ = highGAccelerometer;
+        highGAccelerometer_.timestamp = timestamp;
+        expectedSize += Ximu3BinaryHighGAccelerometerPayloadFormat(&expected[expectedSize], sizeof(expected) - expectedSize, &highGAccelerometer_, payloadFormat);
+        Ximu3DataTemperature temperature_ = temperature;
+        temperature_.timestamp = timestamp;
+        expectedSize += Ximu3BinaryTemperaturePayloadFormat(&expected[expectedSize], sizeof(expected) - expectedSize, &temperature_, payloadFormat);
+        Ximu3DataQuaternion quaternion_ = quaternion;
+        quaternion_.timestamp = timestamp;
+        expectedSize += Ximu3BinaryQuaternionPayloadFormat(&expected[expectedSize], sizeof(expected) - expectedSize, &quaternion_, payloadFormat);
+        Ximu3DataEulerAngles eulerAngles_ = eulerAngles;
+        eulerAngles_.timestamp = timestamp;
+        expectedSize += Ximu3BinaryEulerAnglesPayloadFormat(&expected[expectedSize], sizeof(expected) - expectedSize, &eulerAngles_, payloadFormat);
+
+        // Composite message
+        const Ximu3DataComposite composite = {
+            .timestamp = timestamp,
+            .inertial = &inertial,
+            .magnetometer = &magnetometer,
+            .highGAccelerometer = &highGAccelerometer,
+            .temperature = &temperature,
+            .quaternion = &quaternion,
+            .eulerAngles = &eulerAngles,
+        };
+        uint8_t message[XIMU3_SIZE_BINARY_COMPOSITE];
+        const size_t messageSize = Ximu3BinaryComposite(message, sizeof(message), &composite, payloadFormat);
+
+        // Decode
+        Ximu3BinaryDecoderReset(&decoder);
+        decoder.payloadFormat = payloadFormat;
+        decodedSize = 0;
+        decodeErrorCount = 0;
+        Ximu3BinaryDecoderProcess(&decoder, message, messageSize);
+        decoder.payloadFormat = Ximu3BinaryPayloadFormatFloat32;
+
+        if ((messageSize >= expectedSize) || (decodedSize != expectedSize) || (memcmp(decoded, expected, expectedSize) != 0) || (decodeErrorCount != 0)) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tComposite %d\n", (int) payloadFormat);
+        } else {
+            passCount++;
+        }
+    }
+}
+
+static void TestDescriptor(void) {
+    static const Ximu3DescriptorField fields[] = {
+        {Ximu3DescriptorFieldTypeFloat, offsetof(CustomData, value), 0},
+        {Ximu3DescriptorFieldTypeBool, offsetof(CustomData, flag), 0},
+        {Ximu3DescriptorFieldTypeString, offsetof(CustomData, label), 0},
+    };
+    static const Ximu3DescriptorField stringNotLast[] = {
+        {Ximu3DescriptorFieldTypeString, offsetof(CustomData, label), 0},
+        {Ximu3DescriptorFieldTypeFloat, offsetof(CustomData, value), 0},
+    };
+    static const Ximu3Descriptor descriptor = {'J', sizeof(CustomData), fields, sizeof(fields) / sizeof(fields[0])};
+    static const Ximu3Descriptor usedId = {XIMU3_ASCII_ID_INERTIAL, sizeof(CustomData), fields, sizeof(fields) / sizeof(fields[0])};
+    static const Ximu3Descriptor reservedId = {XIMU3_ASCII_ID_PRESSURE, sizeof(CustomData), fields, sizeof(fields) / sizeof(fields[0])};
+    static const Ximu3Descriptor lowercaseId = {'j', sizeof(CustomData), fields, sizeof(fields) / sizeof(fields[0])};
+    static const Ximu3Descriptor invalidFields = {'Z', sizeof(CustomData), stringNotLast, sizeof(stringNotLast) / sizeof(stringNotLast[0])};
+    const CustomData data = {UINT64_C(0x0ADBDD0A0ADBDC00), 1.5f, true, "Custom"}; // timestamp requires byte stuffing
+
+    // Registration
+    const bool registration = (Ximu3DescriptorRegister(&descriptor) == Ximu3ResultOk) &&
+                              (Ximu3DescriptorRegister(&descriptor) == Ximu3ResultError) &&
+                              (Ximu3DescriptorRegister(&usedId) == Ximu3ResultError) &&
+                              (Ximu3DescriptorRegister(&reservedId) == Ximu3ResultError) &&
+                              (Ximu3DescriptorRegister(&lowercaseId) == Ximu3ResultError) &&
+                              (Ximu3DescriptorRegister(&invalidFields) == Ximu3ResultError) &&
+                              (Ximu3DescriptorFind('J') == &descriptor) &&
+                              (Ximu3DescriptorFind(XIMU3_ASCII_ID_INERTIAL) == &ximu3DescriptorInertial) &&
+                              (Ximu3DescriptorFind(XIMU3_ASCII_ID_PRESSURE) == NULL);
+
+    // ASCII
+    char ascii[256];
+    const size_t asciiSize = Ximu3AsciiMessage(ascii, sizeof(ascii), &descriptor, &data);
+    static const char expectedAscii[] = "J,782461995480505344,1.5000,1.0000,Custom\n";
+    Ximu3AsciiParserReset(&asciiParser);
+    parsedSize = 0;
+    parseErrorCount = 0;
+    Ximu3AsciiParserProcess(&asciiParser, ascii, asciiSize);
+    const bool asciiParsed = (parsedSize == asciiSize) && (memcmp(parsed, ascii, asciiSize) == 0) && (parseErrorCount == 0);
+
+    // Binary
+    uint8_t message[256];
+    const size_t messageSize = Ximu3BinaryMessage(message, sizeof(message), &descriptor, &data);
+    Ximu3BinaryDecoderReset(&decoder);
+    decodedSize = 0;
+    decodeErrorCount = 0;
+    Ximu3BinaryDecoderProcess(&decoder, message, messageSize);
+    const bool binary = (decodedSize == messageSize) && (memcmp(decoded, message, messageSize) == 0) && (decodeErrorCount == 0);
+
+    // Unregistered
+    Ximu3DescriptorUnregister('J');
+    Ximu3BinaryDecoderReset(&decoder);
+    decodedSize = 0;
+    Ximu3BinaryDecoderProcess(&decoder, message, messageSize);
+    const bool unregistered = (decodedSize == 0) && (decodeErrorCount == 1) && (Ximu3DescriptorFind('J') == NULL);
+
+    // Packed timecode
+    uint32_t packedTimecode;
+    Ximu3LtcPack("01:23:45:12", &packedTimecode);
+    const Ximu3DataLtc ltc = {UINT64_C(3), "01:23:45:12", 0};
+    const Ximu3DataLtc prePacked = {UINT64_C(3), NULL, packedTimecode};
+    const Ximu3DataLtc invalidPacked = {UINT64_C(3), NULL, UINT32_C(0x18000000)}; // 24 hours
+    char expectedLtc[XIMU3_SIZE_ASCII_LTC];
+    char asciiLtc[XIMU3_SIZE_ASCII_LTC];
+    uint8_t expectedBinaryLtc[XIMU3_SIZE_BINARY_LTC];
+    uint8_t binaryLtc[XIMU3_SIZE_BINARY_LTC];
+    const size_t expectedLtcSize = Ximu3AsciiMessage(expectedLtc, sizeof(expectedLtc), &ximu3DescriptorLtc, &ltc);
+    const size_t expectedBinaryLtcSize = Ximu3BinaryMessage(expectedBinaryLtc, sizeof(expectedBinaryLtc), &ximu3DescriptorLtc, &ltc);
+    const bool packed = (Ximu3AsciiMessage(asciiLtc, sizeof(asciiLtc), &ximu3DescriptorLtc, &prePacked) == expectedLtcSize) && (memcmp(asciiLtc, expectedLtc, expectedLtcSize) == 0) &&
+                        (Ximu3BinaryMessage(binaryLtc, sizeof(binaryLtc), &ximu3DescriptorLtc, &prePacked) == expectedBinaryLtcSize) && (memcmp(binaryLtc, expectedBinaryLtc, expectedBinaryLtcSize) == 0) &&
+                        (Ximu3AsciiMessage(asciiLtc, sizeof(asciiLtc), &ximu3DescriptorLtc, &invalidPacked) == 0) &&
+                        (Ximu3BinaryMessage(binaryLtc, sizeof(binaryLtc), &ximu3DescriptorLtc, &invalidPacked) == 0);
+
+    // NULL string
+    const Ximu3DataNotification nullNotification = {UINT64_C(4), NULL};
+    const Ximu3DataNotification emptyNotification = {UINT64_C(4), ""};
+    static const char expectedNullAscii[] = "N,4,\n";
+    char asciiNull[sizeof(expectedNullAscii)];
+    uint8_t expectedNullBinary[XIMU3_SIZE_BINARY_OVERHEAD];
+    uint8_t binaryNull[XIMU3_SIZE_BINARY_OVERHEAD];
+    const size_t expectedNullBinarySize = Ximu3BinaryNotification(expectedNullBinary, sizeof(expectedNullBinary), &emptyNotification);
+    const bool nullString = (Ximu3AsciiMessage(asciiNull, sizeof(asciiNull), &ximu3DescriptorNotification, &nullNotification) == (sizeof(expectedNullAscii) - 1)) && (memcmp(asciiNull, expectedNullAscii, sizeof(expectedNullAscii) - 1) == 0) &&
+                            (Ximu3BinaryMessage(binaryNull, sizeof(binaryNull), &ximu3DescriptorNotification, &nullNotification) == expectedNullBinarySize) && (memcmp(binaryNull, expectedNullBinary, expectedNullBinarySize) == 0) &&
+                            (Ximu3BinaryMessage(binaryNull, 4, &ximu3DescriptorNotification, &nullNotification) == 4); // destination size checked for each field
+
+    if ((registration == false) || (asciiSize != (sizeof(expectedAscii) - 1)) || (memcmp(ascii, expectedAscii, asciiSize) != 0) || (asciiParsed == false) || (binary == false) || (unregistered == false) || (packed == false) || (nullString == false)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tDescriptor\n");
+    } else {
+        passCount++;
+    }
+}
+
+static void TestCobs(void) {
+    uint8_t message[1024];
+    uint8_t bytes[XIMU3_SIZE_CHAR_ARRAY];
+
+    const Ximu3DataInertial inertial = {UINT64_C(0x0ADBDD0A0ADBDC00), FloatFromBits(UINT32_C(0x0ADB0ADB)), 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}; // bytes that require byte stuffing
+    size_t messageSize = Ximu3BinaryInertial(message, sizeof(message), &inertial);
+    TestCobsMessage("inertial", message, messageSize, XIMU3_SIZE_BINARY_COBS_INERTIAL, message, messageSize);
+
+    memset(bytes, XIMU3_TERMINATION, sizeof(bytes)); // worst case for byte stuffing
+    const Ximu3DataSerialAccessory terminations = {UINT64_C(1), bytes, sizeof(bytes)};
+    messageSize = Ximu3BinarySerialAccessory(message, sizeof(message), &terminations);
+    TestCobsMessage("terminations", message, messageSize, XIMU3_SIZE_BINARY_COBS_SERIAL_ACCESSORY, message, messageSize);
+
+    memset(bytes, 0xDB, sizeof(bytes)); // worst case for byte stuffing
+    const Ximu3DataSerialAccessory escapes = {UINT64_C(2), bytes, sizeof(bytes)};
+    messageSize = Ximu3BinarySerialAccessory(message, sizeof(message), &escapes);
+    TestCobsMessage("escapes", message, messageSize, XIMU3_SIZE_BINARY_COBS_SERIAL_ACCESSORY, message, messageSize);
+
+    memset(bytes, 0x55, sizeof(bytes)); // code byte of 0xFF
+    const Ximu3DataSerialAccessory noTerminations = {UINT64_C(0x5555555555555555), bytes, sizeof(bytes)};
+    messageSize = Ximu3BinarySerialAccessory(message, sizeof(message), &noTerminations);
+    TestCobsMessage("no terminations", message, messageSize, XIMU3_SIZE_BINARY_COBS_SERIAL_ACCESSORY, message, messageSize);
+
+    Ximu3CompactTimestamp compactTimestamp = {.absolutePeriod = 2};
+    Ximu3BinaryDecoderReset(&decoder);
+    for (uint64_t timestamp = 0; timestamp < 20; timestamp += 5) {
+        const Ximu3DataQuaternion quaternion = {timestamp, 1.0f, 0.0f, 0.0f, 0.0f};
+        uint8_t expected[XIMU3_SIZE_BINARY_QUATERNION];
+        const size_t expectedSize = Ximu3BinaryQuaternion(expected, sizeof(expected), &quaternion);
+        memcpy(message, expected, expectedSize);
+        TestCobsMessage("compact", message, Ximu3BinaryCompactTimestamp(&compactTimestamp, message, expectedSize), XIMU3_SIZE_BINARY_COBS_QUATERNION, expected, expectedSize);
+    }
+
+    // Written directly
+    TestMessageCobs("direct inertial", &ximu3DescriptorInertial, &inertial, XIMU3_SIZE_BINARY_COBS_INERTIAL);
+    TestMessageCobs("direct terminations", &ximu3DescriptorSerialAccessory, &terminations, XIMU3_SIZE_BINARY_COBS_SERIAL_ACCESSORY);
+    TestMessageCobs("direct escapes", &ximu3DescriptorSerialAccessory, &escapes, XIMU3_SIZE_BINARY_COBS_SERIAL_ACCESSORY);
+    TestMessageCobs("direct no terminations", &ximu3DescriptorSerialAccessory, &noTerminations, XIMU3_SIZE_BINARY_COBS_SERIAL_ACCESSORY);
+    const Ximu3DataAhrsStatus ahrsStatus = {UINT64_C(0x0A0A0A0A0A0A0A0A), true, false, true, false};
+    TestMessageCobs("direct AHRS status", &ximu3DescriptorAhrsStatus, &ahrsStatus, XIMU3_SIZE_BINARY_COBS_AHRS_STATUS);
+    uint32_t packedTimecode;
+    Ximu3LtcPack("10:10:10:10", &packedTimecode);
+    const Ximu3DataLtc ltc = {UINT64_C(3), NULL, packedTimecode};
+    TestMessageCobs("direct packed LTC", &ximu3DescriptorLtc, &ltc, XIMU3_SIZE_BINARY_COBS_LTC);
+    const Ximu3DataNotification notification = {UINT64_C(4), NULL};
+    TestMessageCobs("direct NULL notification", &ximu3DescriptorNotification, &notification, XIMU3_SIZE_BINARY_COBS_NOTIFICATION);
+
+    // Written directly with floats that span more than one block
+    typedef struct {
+        uint64_t timestamp;
+        float values[62];
+    } Floats;
+    static Floats floats;
+    static Ximu3DescriptorField floatFields[62];
+    for (size_t index = 0; index < (sizeof(floats.values) / sizeof(floats.values[0])); index++) {
+        floats.values[index] = FloatFromBits(index < 61 ? UINT32_C(0x55555555) : UINT32_C(0x0A555555)); // termination after a full block
+        floatFields[index] = (Ximu3DescriptorField) {Ximu3DescriptorFieldTypeFloat, (uint16_t) offsetof(Floats, values[index]), 0};
+    }
+    floats.timestamp = UINT64_C(0x5555555555555555);
+    const Ximu3Descriptor floatsDescriptor = {'K', sizeof(floats), floatFields, sizeof(floatFields) / sizeof(floatFields[0])};
+    TestMessageCobs("direct floats", &floatsDescriptor, &floats, XIMU3_SIZE_BINARY_COBS(sizeof(floats.values)));
+
+    // Invalid code
+    static const uint8_t invalid[] = {0x80 + XIMU3_ASCII_ID_TEMPERATURE, 0x20 ^ XIMU3_TERMINATION, 0x00, XIMU3_TERMINATION};
+    Ximu3BinaryDecoderReset(&decoder);
+    decoder.framing = Ximu3BinaryFramingCobs;
+    decodedSize = 0;
+    decodeErrorCount = 0;
+    Ximu3BinaryDecoderProcess(&decoder, invalid, sizeof(invalid));
+    decoder.framing = Ximu3BinaryFramingByteStuffing;
+    if ((decodedSize != 0) || (decodeErrorCount != 1)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tCOBS invalid code\n");
+    } else {
+        passCount++;
+    }
+}
+
+static void TestCobsMessage(const char *const name, const void *const message, const size_t messageSize, const size_t maximumCobsSize, const void *const expected, const size_t expectedSize) {
+    uint8_t cobs[1024];
+    const size_t cobsSize = Ximu3BinaryCobs(cobs, sizeof(cobs), message, messageSize);
+    const bool truncated = Ximu3BinaryCobs(cobs, cobsSize - 1, message, messageSize) == 0;
+    const uint8_t *const termination = memchr(cobs, XIMU3_TERMINATION, cobsSize);
+
+    // Decode
+    decoder.framing = Ximu3BinaryFramingCobs;
+    decodedSize = 0;
+    decodeErrorCount = 0;
+    for (size_t index = 0; index < cobsSize; index++) {
+        Ximu3BinaryDecoderProcess(&decoder, &cobs[index], 1);
+    }
+    decoder.framing = Ximu3BinaryFramingByteStuffing;
+
+    if ((cobsSize == 0) || (cobsSize > maximumCobsSize) || (truncated == false) || (termination != &cobs[cobsSize - 1]) ||
+        (decodedSize != expectedSize) || (memcmp(decoded, expected, expectedSize) != 0) || (decodeErrorCount != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tCOBS %s\n", name);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestMessageCobs(const char *const name, const Ximu3Descriptor *const descriptor, const void *const data, const size_t maximumCobsSize) {
+    uint8_t message[1024];
+    uint8_t expected[1024];
+    uint8_t cobs[1024];
+    const size_t expectedSize = Ximu3BinaryCobs(expected, sizeof(expected), message, Ximu3BinaryMessage(message, sizeof(message), descriptor, data));
+    const size_t cobsSize = Ximu3BinaryMessageCobs(cobs, maximumCobsSize, descriptor, data);
+    const bool match = (cobsSize == expectedSize) && (memcmp(cobs, expected, expectedSize) == 0);
+    const bool exact = Ximu3BinaryMessageCobs(cobs, expectedSize, descriptor, data) == expectedSize;
+    const bool truncated = Ximu3BinaryMessageCobs(cobs, expectedSize - 1, descriptor, data) == 0;
+    if ((expectedSize == 0) || (match == false) || (exact == false) || (truncated == false)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tCOBS %s\n", name);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestCompression(void) {
+    static uint8_t original[8192];
+    static uint8_t compressed[8192];
+    size_t originalSize;
+
+    // Stream fragmented at different sizes
+    for (size_t fragmentSize = 1; fragmentSize <= 64; fragmentSize *= 4) {
+        Ximu3Compressor compressor = {.payloadFormat = Ximu3BinaryPayloadFormatFloat32};
+        const size_t compressedSize = CompressionStream(&compressor, original, &originalSize, compressed, 100, UINT32_MAX);
+        Ximu3DecompressorReset(&decompressor);
+        decompressorOutputSize = 0;
+        decompressErrorCount = 0;
+        for (size_t index = 0; index < compressedSize; index += fragmentSize) {
+            Ximu3DecompressorProcess(&decompressor, &compressed[index], (compressedSize - index) < fragmentSize ? (compressedSize - index) : fragmentSize);
+        }
+        if ((compressedSize == 0) || (compressedSize >= ((3 * originalSize) / 4)) || (decompressorOutputSize != originalSize) || (memcmp(decompressorOutput, original, originalSize) != 0) || (decompressErrorCount != 0)) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tCompression fragment size %zu\n", fragmentSize);
+        } else {
+            passCount++;
+        }
+    }
+
+    // Lost message
+    Ximu3Compressor compressor = {.resetPeriod = 10, .payloadFormat = Ximu3BinaryPayloadFormatFloat32};
+    const size_t compressedSize = CompressionStream(&compressor, original, &originalSize, compressed, 100, 15);
+    Ximu3DecompressorReset(&decompressor);
+    decompressorOutputSize = 0;
+    decompressErrorCount = 0;
+    Ximu3DecompressorProcess(&decompressor, compressed, compressedSize);
+    if ((decompressErrorCount != 4) || (decompressorOutputSize != originalSize) || (memcmp(decompressorOutput, original, originalSize) != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tCompression lost message\n");
+    } else {
+        passCount++;
+    }
+}
+
+static size_t CompressionStream(Ximu3Compressor *const compressor, uint8_t *const original, size_t *const originalSize, uint8_t *const compressed, const uint32_t numberOfMessages, const uint32_t dropIndex) {
+    static const char response[] = "{\"ping\":{\"interface\":\"USB\",\"deviceName\":\"x-IMU3\",\"serialNumber\":\"0123-4567-89AB-CDEF\"}}\n";
+    static const uint8_t bytes[] = {'A', XIMU3_TERMINATION, 0xDB, 0xDC, 0xDD, 'B'}; // bytes that require byte stuffing
+    Ximu3CompactTimestamp compactTimestamp = {.absolutePeriod = 4};
+    size_t compressedSize = 0;
+    *originalSize = 0;
+    for (uint32_t index = 0; index < numberOfMessages; index++) {
+        const uint64_t timestamp = (UINT64_C(2500) * index) + (index % 3); // 400 Hz with jitter
+        const float angle = 0.01f * (float) index;
+        uint8_t message[XIMU3_SIZE_BINARY_DECODER];
+        size_t messageSize;
+        switch (index % 4) {
+            case 0:
+            case 2: {
+                const Ximu3DataInertial inertial = {timestamp, 10.0f * sinf(angle), 10.0f * cosf(angle), 0.5f, 0.0f, 0.1f * angle, 1.0f};
+                messageSize = Ximu3BinaryInertial(message, sizeof(message), &inertial);
+                break;
+            }
+            case 1: {
+                const Ximu3DataQuaternion quaternion = {timestamp, cosf(angle), sinf(angle), 0.0f, 0.0f};
+                messageSize = Ximu3BinaryQuaternion(message, sizeof(message), &quaternion);
+                messageSize = Ximu3BinaryCompactTimestamp(&compactTimestamp, message, messageSize);
+                break;
+            }
+            default:
+                if ((index % 20) == 3) {
+                    const Ximu3DataNotification notification = {timestamp, "Notification"};
+                    messageSize = Ximu3BinaryNotification(message, sizeof(message), &notification);
+                } else {
+                    const Ximu3DataSerialAccessory serialAccessory = {timestamp, bytes, sizeof(bytes)};
+                    messageSize = Ximu3BinarySerialAccessory(message, sizeof(message), &serialAccessory);
+                }
+                break;
+        }
+        const bool lost = (index >= dropIndex) && ((index / compressor->resetPeriod) == (dropIndex / compressor->resetPeriod)); // until next reset
+        if (lost == false) {
+            memcpy(&original[*originalSize], message, messageSize);
+            *originalSize += messageSize;
+        }
+
+        // Destination too small
+        if (Ximu3CompressorMessage(compressor, &compressed[compressedSize], XIMU3_SIZE_COMPRESSED(messageSize) - 1, message, messageSize) != 0) {
+            return 0;
+        }
+
+        // Compress
+        const size_t size = Ximu3CompressorMessage(compressor, &compressed[compressedSize], XIMU3_SIZE_COMPRESSED(messageSize), message, messageSize);
+        if (size == 0) {
+            return 0;
+        }
+        if (index != dropIndex) {
+            compressedSize += size;
+        }
+
+        // Command response passed through
+        if ((index % 25) == 24) {
+            memcpy(&original[*originalSize], response, sizeof(response) - 1);
+            *originalSize += sizeof(response) - 1;
+            memcpy(&compressed[compressedSize], response, sizeof(response) - 1);
+            compressedSize += sizeof(response) - 1;
+        }
+    }
+    return compressedSize;
+}
+
+static void DecompressorWrite(const void *const data, const size_t numberOfBytes, void *const context) {
+    (void) context; // avoid compiler warning
+    memcpy(&decompressorOutput[decompressorOutputSize], data, numberOfBytes);
+    decompressorOutputSize += numberOfBytes;
+}
+
+static void TestIntern(void) {
+    uint8_t message[XIMU3_SIZE_NOTIFICATION];
+    uint8_t expected[XIMU3_SIZE_NOTIFICATION];
+    char string[XIMU3_INTERN_STRING_SIZE + 1];
+
+    // Binary definitions and references
+    static const char *const strings[] = {"Battery low", "Error storm", "Battery low", "Battery low", "Error storm"};
+    Ximu3Intern intern = {0};
+    Ximu3BinaryDecoderReset(&decoder);
+    bool binary = true;
+    for (size_t index = 0; index < (sizeof(strings) / sizeof(strings[0])); index++) {
+        const Ximu3DataNotification notification = {UINT64_C(1), strings[index]};
+        const size_t messageSize = Ximu3BinaryNotificationInterned(message, sizeof(message), &notification, &intern);
+        const size_t expectedSize = (index < 2) ? (XIMU3_SIZE_BINARY_OVERHEAD - 8 + 2 + strlen(strings[index])) : 12; // ID + timestamp + null + index + termination
+        if ((messageSize != expectedSize) || (TestInternMessage(message, messageSize, expected, Ximu3BinaryNotification(expected, sizeof(expected), &notification)) == false)) {
+            binary = false;
+        }
+        const Ximu3DataError error = {UINT64_C(2), strings[index]};
+        if (TestInternMessage(message, Ximu3BinaryErrorInterned(message, sizeof(message), &error, &intern), expected, Ximu3BinaryError(expected, sizeof(expected), &error)) == false) {
+            binary = false;
+        }
+    }
+
+    // Strings that cannot be interned are sent unchanged
+    memset(string, 'A', XIMU3_INTERN_STRING_SIZE);
+    string[XIMU3_INTERN_STRING_SIZE] = '\0';
+    const Ximu3DataNotification tooLong = {UINT64_C(1), string};
+    const Ximu3DataNotification empty = {UINT64_C(1), ""};
+    if ((Ximu3BinaryNotificationInterned(message, sizeof(message), &tooLong, &intern) != Ximu3BinaryNotification(expected, sizeof(expected), &tooLong)) || (memcmp(message, expected, Ximu3BinaryNotification(expected, sizeof(expected), &tooLong)) != 0) ||
+        (Ximu3BinaryNotificationInterned(message, sizeof(message), &empty, &intern) != Ximu3BinaryNotification(expected, sizeof(expected), &empty))) {
+        binary = false;
+    }
+
+    // Least recently added string replaced
+    for (int index = 0; index < XIMU3_INTERN_NUMBER_OF_STRINGS; index++) {
+        snprintf(string, sizeof(string), "String %d", index);
+        const Ximu3DataNotification notification = {UINT64_C(1), string};
+        if (TestInternMessage(message, Ximu3BinaryNotificationInterned(message, sizeof(message), &notification, &intern), expected, Ximu3BinaryNotification(expected, sizeof(expected), &notification)) == false) {
+            binary = false;
+        }
+    }
+    const Ximu3DataNotification replaced = {UINT64_C(1), strings[0]};
+    if (Ximu3BinaryNotificationInterned(message, sizeof(message), &replaced, &intern) == 12) {
+        binary = false;
+    }
+
+    // Dictionary reset
+    Ximu3BinaryDecoderReset(&decoder);
+    decodeErrorCount = 0;
+    Ximu3BinaryDecoderProcess(&decoder, message, Ximu3BinaryNotificationInterned(message, sizeof(message), &replaced, &intern));
+    const bool undefined = decodeErrorCount == 1;
+    Ximu3InternReset(&intern);
+    if ((undefined == false) || (TestInternMessage(message, Ximu3BinaryNotificationInterned(message, sizeof(message), &replaced, &intern), expected, Ximu3BinaryNotification(expected, sizeof(expected), &replaced)) == false)) {
+        binary = false;
+    }
+
+    // ASCII
+    Ximu3InternReset(&intern);
+    const Ximu3DataError error = {UINT64_C(3), strings[0]};
+    size_t messageSize = Ximu3AsciiErrorInterned(message, sizeof(message), &error, &intern);
+    const bool asciiDefinition = (messageSize == (sizeof("F,3,\x1F#0=Battery low\n") - 1)) && (memcmp(message, "F,3,\x1F#0=Battery low\n", messageSize) == 0);
+    messageSize = Ximu3AsciiErrorInterned(message, sizeof(message), &error, &intern);
+    const bool asciiReference = (messageSize == (sizeof("F,3,\x1F#0\n") - 1)) && (memcmp(message, "F,3,\x1F#0\n", messageSize) == 0);
+
+    if ((binary == false) || (asciiDefinition == false) || (asciiReference == false)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tIntern\n");
+    } else {
+        passCount++;
+    }
+}
+
+static bool TestInternMessage(const void *const message, const size_t messageSize, const void *const expected, const size_t expectedSize) {
+    decodedSize = 0;
+    decodeErrorCount = 0;
+    Ximu3BinaryDecoderProcess(&decoder, message, messageSize);
+    return (decodedSize == expectedSize) && (memcmp(decoded, expected, expectedSize) == 0) && (decodeErrorCount == 0);
+}
+
+static void TestBatch(void) {
+    const Ximu3DataInertial data = {UINT64_C(0x0A0A0A0A0A0A0A0A), 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}; // timestamp requires byte stuffing
+    const size_t binarySize = Ximu3BinaryInertial(decoded, sizeof(decoded), &data);
+    const size_t asciiSize = Ximu3AsciiInertial(decoded, sizeof(decoded), &data);
+
+    TestBatchSize("Binary", 0, 0);
+    TestBatchSize("Binary", (3 * binarySize) - 1, 2);
+    TestBatchSize("Binary", 3 * binarySize, 3);
+    TestBatchSize("Binary", XIMU3_SIZE_BINARY_INERTIAL * 4, 4);
+    TestBatchSize("ASCII", (3 * asciiSize) - 1, 2);
+    TestBatchSize("ASCII", 3 * asciiSize, 3);
+    TestBatchSize("ASCII", XIMU3_SIZE_ASCII_INERTIAL * 4, 4);
+}
+
+static void TestBatchSize(const char *const name, const size_t destinationSize, const size_t expectedNumberOfMessages) {
+    Ximu3DataInertial data[4];
+    uint8_t expected[1024];
+    size_t expectedSize = 0;
+    for (size_t index = 0; index < (sizeof(data) / sizeof(data[0])); index++) {
+        data[index] = (Ximu3DataInertial){UINT64_C(0x0A0A0A0A0A0A0A0A), 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, (float) index};
+        if (index < expectedNumberOfMessages) {
+            if (strcmp(name, "Binary") == 0) {
+                expectedSize += Ximu3BinaryInertial(&expected[expectedSize], sizeof(expected) - expectedSize, &data[index]);
+            } else {
+                expectedSize += Ximu3AsciiInertial(&expected[expectedSize], sizeof(expected) - expectedSize, &data[index]);
+            }
+        }
+    }
+
+    uint8_t actual[1024];
+    size_t numberOfMessagesWritten;
+    size_t actualSize;
+    if (strcmp(name, "Binary") == 0) {
+        actualSize = Ximu3BinaryInertialBatch(actual, destinationSize, data, sizeof(data) / sizeof(data[0]), &numberOfMessagesWritten);
+    } else {
+        actualSize = Ximu3AsciiInertialBatch(actual, destinationSize, data, sizeof(data) / sizeof(data[0]), &numberOfMessagesWritten);
+    }
+
+    if ((numberOfMessagesWritten != expectedNumberOfMessages) || (actualSize != expectedSize) || (memcmp(actual, expected, expectedSize) != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\t%s batch of %zu bytes\n", name, destinationSize);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestUnchecked(void) {
+    const Ximu3DataInertial inertial = {UINT64_C(0x0A0A0A0A0A0A0A0A), 1.0f, -2.0f, 3.0f, 4.0f, 5.0f, 6.0f}; // timestamp requires byte stuffing
+    const Ximu3DataNotification notification = {UINT64_C(0xDBDB), "\n\xDB Notification\x01"}; // requires byte stuffing and replacement of non-printable characters
+    const uint8_t bytes[] = {0x0A, 0xDB, 'A', 0xDC, 0x0A};
+    const Ximu3DataSerialAccessory serialAccessory = {1000, bytes, sizeof(bytes)};
+    uint8_t unchecked[1024];
+    uint8_t checked[1024];
+
+    // Binary, destination sizes less than the worst case are checked for each field
+    size_t uncheckedSize = Ximu3BinaryInertial(unchecked, XIMU3_SIZE_BINARY_INERTIAL, &inertial);
+    TestUncheckedMessage("Binary inertial", unchecked, uncheckedSize, checked, Ximu3BinaryInertial(checked, uncheckedSize, &inertial));
+    uncheckedSize = Ximu3BinaryNotification(unchecked, XIMU3_SIZE_BINARY_NOTIFICATION, &notification);
+    TestUncheckedMessage("Binary notification", unchecked, uncheckedSize, checked, Ximu3BinaryNotification(checked, uncheckedSize, &notification));
+    uncheckedSize = Ximu3BinarySerialAccessory(unchecked, XIMU3_SIZE_BINARY_SERIAL_ACCESSORY, &serialAccessory);
+    TestUncheckedMessage("Binary serial accessory", unchecked, uncheckedSize, checked, Ximu3BinarySerialAccessory(checked, uncheckedSize, &serialAccessory));
+
+    // Binary, worst case fills the destination
+    uint8_t escapes[XIMU3_SIZE_CHAR_ARRAY];
+    memset(escapes, 0xDB, sizeof(escapes));
+    const Ximu3DataSerialAccessory worstCase = {UINT64_C(0xDBDBDBDBDBDBDBDB), escapes, sizeof(escapes)};
+    uncheckedSize = Ximu3BinarySerialAccessory(unchecked, XIMU3_SIZE_BINARY_SERIAL_ACCESSORY, &worstCase);
+    TestUncheckedMessage("Binary worst case", unchecked, uncheckedSize, unchecked, XIMU3_SIZE_BINARY_SERIAL_ACCESSORY);
+
+    // ASCII, truncated messages are checked for each character
+    uncheckedSize = Ximu3AsciiNotification(unchecked, XIMU3_SIZE_ASCII_NOTIFICATION, &notification);
+    for (size_t checkedSize = 1; checkedSize < uncheckedSize; checkedSize++) {
+        memcpy(checked, unchecked, checkedSize - 1);
+        checked[checkedSize - 1] = '\n';
+        uint8_t truncated[sizeof(checked)];
+        TestUncheckedMessage("ASCII notification", checked, checkedSize, truncated, Ximu3AsciiNotification(truncated, checkedSize, &notification));
+    }
+}
+
+static void TestUncheckedMessage(const char *const name, const void *const unchecked, const size_t uncheckedSize, const void *const checked, const size_t checkedSize) {
+    if ((checkedSize != uncheckedSize) || (memcmp(checked, unchecked, uncheckedSize) != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\t%s of %zu bytes\n", name, checkedSize);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestPrintable(void) {
+    char source[64];
+    for (size_t index = 0; index < sizeof(source); index++) {
+        source[index] = (char) ((index * 37) + 0x10); // printable and non-printable characters at every position
+    }
+    char expected[sizeof(source)];
+    for (size_t index = 0; index < sizeof(source); index++) {
+        const unsigned char character = (unsigned char) source[index];
+        expected[index] = ((character < 0x20) || (character > 0x7E)) ? '?' : (char) character;
+    }
+
+    // Copy
+    for (size_t numberOfCharacters = 0; numberOfCharacters <= 40; numberOfCharacters++) {
+        for (size_t offset = 0; offset < 8; offset++) {
+            char actual[sizeof(source) + 1];
+            actual[numberOfCharacters] = 'X';
+            Ximu3PrintableCopy(actual, &source[offset], numberOfCharacters);
+            if ((memcmp(actual, &expected[offset], numberOfCharacters) != 0) || (actual[numberOfCharacters] != 'X')) {
+                failCount++;
+                printf("Failed\n");
+                printf("\tPrintable copy of %zu characters at offset %zu\n", numberOfCharacters, offset);
+            } else {
+                passCount++;
+            }
+        }
+    }
+
+    // Copy string
+    const struct {
+        const char *const string;
+        const size_t destinationSize;
+        const char *const expected;
+    } strings[] = {
+        {"", 8, ""},
+        {"Device\x7F", 8, "Device?"},
+        {"Device name", 8, "Device "},
+        {"\xC3\xA9t\xC3\xA9 and \t tab characters", 64, "??t?? and ? tab characters"},
+    };
+    for (size_t index = 0; index < (sizeof(strings) / sizeof(strings[0])); index++) {
+        char actual[64];
+        const size_t length = Ximu3PrintableCopyString(actual, strings[index].destinationSize, strings[index].string);
+        if ((length != strlen(strings[index].expected)) || (strcmp(actual, strings[index].expected) != 0)) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tPrintable copy string \"%s\"\n", strings[index].expected);
+        } else {
+            passCount++;
+        }
+    }
+}
+
+static void TestSerialAccessoryStream(void) {
+    uint8_t payload[600];
+    for (size_t index = 0; index < sizeof(payload); index++) {
+        payload[index] = (uint8_t) ((index * 37) + 0x0A); // bytes that require byte stuffing and non-printable characters
+    }
+    static const size_t chunks[] = {1, 7, 300, 0, 292}; // sizes of chunks as received
+    const uint64_t timestamp = UINT64_C(0x0A0A0A0A0A0A0A0A); // bytes that require byte stuffing
+
+    static const size_t maximumNumberOfBytes[] = {0, 100, 1000};
+    for (size_t index = 0; index < (sizeof(maximumNumberOfBytes) / sizeof(maximumNumberOfBytes[0])); index++) {
+        const size_t maximum = ((maximumNumberOfBytes[index] == 0) || (maximumNumberOfBytes[index] > XIMU3_SIZE_CHAR_ARRAY)) ? XIMU3_SIZE_CHAR_ARRAY : maximumNumberOfBytes[index];
+        const int expectedNumberOfWrites = (int) ((sizeof(payload) + maximum - 1) / maximum);
+
+        // Binary
+        Ximu3BinarySerialAccessoryStream binaryStream = {
+            .maximumNumberOfBytes = maximumNumberOfBytes[index],
+            .write = StreamWrite,
+        };
+        uint8_t expected[4096];
+        size_t expectedSize = 0;
+        for (size_t payloadIndex = 0; payloadIndex < sizeof(payload); payloadIndex += maximum) {
+            const size_t remaining = sizeof(payload) - payloadIndex;
+            const Ximu3DataSerialAccessory data = {timestamp, &payload[payloadIndex], remaining < maximum ? remaining : maximum};
+            expectedSize += Ximu3BinarySerialAccessory(&expected[expectedSize], sizeof(expected) - expectedSize, &data);
+        }
+        streamedSize = 0;
+        streamedNumberOfWrites = 0;
+        Ximu3BinarySerialAccessoryAppend(&binaryStream, payload, sizeof(payload)); // ignored before begin
+        Ximu3BinarySerialAccessoryBegin(&binaryStream, timestamp);
+        size_t payloadIndex = 0;
+        for (size_t chunkIndex = 0; chunkIndex < (sizeof(chunks) / sizeof(chunks[0])); chunkIndex++) {
+            Ximu3BinarySerialAccessoryAppend(&binaryStream, &payload[payloadIndex], chunks[chunkIndex]);
+            payloadIndex += chunks[chunkIndex];
+        }
+        Ximu3BinarySerialAccessoryEnd(&binaryStream);
+        Ximu3BinarySerialAccessoryEnd(&binaryStream); // ignored after end
+        if ((streamedNumberOfWrites != expectedNumberOfWrites) || (streamedSize != expectedSize) || (memcmp(streamed, expected, expectedSize) != 0)) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tBinary serial accessory stream of %zu bytes per message\n", maximum);
+        } else {
+            passCount++;
+        }
+
+        // ASCII
+        Ximu3AsciiSerialAccessoryStream asciiStream = {
+            .maximumNumberOfBytes = maximumNumberOfBytes[index],
+            .write = StreamWrite,
+        };
+        expectedSize = 0;
+        for (payloadIndex = 0; payloadIndex < sizeof(payload); payloadIndex += maximum) {
+            const size_t remaining = sizeof(payload) - payloadIndex;
+            const Ximu3DataSerialAccessory data = {timestamp, &payload[payloadIndex], remaining < maximum ? remaining : maximum};
+            expectedSize += Ximu3AsciiSerialAccessory(&expected[expectedSize], sizeof(expected) - expectedSize, &data);
+        }
+        streamedSize = 0;
+        streamedNumberOfWrites = 0;
+        Ximu3AsciiSerialAccessoryBegin(&asciiStream, timestamp);
+        payloadIndex = 0;
+        for (size_t chunkIndex = 0; chunkIndex < (sizeof(chunks) / sizeof(chunks[0])); chunkIndex++) {
+            Ximu3AsciiSerialAccessoryAppend(&asciiStream, &payload[payloadIndex], chunks[chunkIndex]);
+            payloadIndex += chunks[chunkIndex];
+        }
+        Ximu3AsciiSerialAccessoryBegin(&asciiStream, timestamp + 1); // ends the previous stream
+        Ximu3AsciiSerialAccessoryEnd(&asciiStream); // no bytes so nothing written
+        if ((streamedNumberOfWrites != expectedNumberOfWrites) || (streamedSize != expectedSize) || (memcmp(streamed, expected, expectedSize) != 0)) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tASCII serial accessory stream of %zu bytes per message\n", maximum);
+        } else {
+            passCount++;
+        }
+    }
+}
+
+static void StreamWrite(const void *const data, const size_t numberOfBytes, void *const context) {
+    (void) context; // avoid compiler warning
+    memcpy(&streamed[streamedSize], data, numberOfBytes);
+    streamedSize += numberOfBytes;
+    streamedNumberOfWrites++;
+}
+
+static void TestWriter(void) {
+    const Ximu3Writer writer = {
+        .reserve = RingReserve,
+        .commit = RingCommit,
+    };
+    uint8_t expected[4096];
+    size_t expectedSize = 0;
+    uint8_t actual[4096];
+    size_t actualSize = 0;
+
+    for (int index = 0; index < 40; index++) {
+        const Ximu3DataInertial data = {(uint64_t) index, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, (float) index};
+        expectedSize += Ximu3BinaryInertial(&expected[expectedSize], sizeof(expected) - expectedSize, &data);
+
+        void *destination;
+        const size_t destinationSize = Ximu3WriterReserve(&writer, XIMU3_SIZE_BINARY_INERTIAL, &destination);
+        Ximu3WriterCommit(&writer, Ximu3BinaryInertial(destination, destinationSize, &data));
+
+        if ((index % 2) == 1) {
+            actualSize += RingTransmit(&actual[actualSize]);
+        }
+    }
+
+    if ((actualSize != expectedSize) || (memcmp(actual, expected, expectedSize) != 0)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tWriter\n");
+    } else {
+        passCount++;
+    }
+}
+
+static void TestCompactTimestamp(void) {
+    static const uint64_t timestamps[] = {1000, 1010, 1210, 1205, 3001205, 3001206, 3001207, 3001208, 3001209}; // delta 10 requires byte stuffing
+    static const bool compacts[] = {false, true, true, false, false, true, true, true, false};
+
+    // Binary
+    Ximu3CompactTimestamp compactTimestamp = {.absolutePeriod = 4};
+    Ximu3BinaryDecoderReset(&decoder);
+    for (size_t index = 0; index < (sizeof(timestamps) / sizeof(timestamps[0])); index++) {
+        const Ximu3DataInertial data = {timestamps[index], 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+        uint8_t expected[XIMU3_SIZE_BINARY_INERTIAL];
+        const size_t expectedSize = Ximu3BinaryInertial(expected, sizeof(expected), &data);
+        uint8_t message[XIMU3_SIZE_BINARY_INERTIAL];
+        memcpy(message, expected, expectedSize);
+
+        const size_t messageSize = Ximu3BinaryCompactTimestamp(&compactTimestamp, message, expectedSize);
+        const bool compact = message[0] == (0x80 + 'i');
+        decodedSize = 0;
+        decodeErrorCount = 0;
+        Ximu3BinaryDecoderProcess(&decoder, message, messageSize);
+
+        if ((compact != compacts[index]) || (messageSize > (compact ? XIMU3_SIZE_BINARY_COMPACT(XIMU3_SIZE_BINARY_INERTIAL) : expectedSize)) ||
+            (decodedSize != expectedSize) || (memcmp(decoded, expected, expectedSize) != 0) || (decodeErrorCount != 0)) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tBinary compact timestamp %" PRIu64 "\n", timestamps[index]);
+        } else {
+            passCount++;
+        }
+    }
+
+    // Binary compact message without previous timestamp
+    uint8_t message[XIMU3_SIZE_BINARY_INERTIAL];
+    const Ximu3DataInertial data = {3001210, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    const size_t messageSize = Ximu3BinaryCompactTimestamp(&compactTimestamp, message, Ximu3BinaryInertial(message, sizeof(message), &data));
+    Ximu3BinaryDecoderReset(&decoder);
+    decodedSize = 0;
+    decodeErrorCount = 0;
+    Ximu3BinaryDecoderProcess(&decoder, message, messageSize);
+    if ((message[0] != (0x80 + 'i')) || (decodedSize != 0) || (decodeErrorCount != 1)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tBinary compact timestamp without previous timestamp\n");
+    } else {
+        passCount++;
+    }
+
+    // ASCII
+    static const char *const expectedStrings[] = {
+        "T,1000,20.0000\n",
+        "t,10,20.0000\n",
+        "T,1210,20.0000\n",
+        "T,1205,20.0000\n",
+        "T,3001205,20.0000\n",
+        "t,1,20.0000\n",
+    };
+    compactTimestamp = (Ximu3CompactTimestamp) {.absolutePeriod = 2};
+    for (size_t index = 0; index < (sizeof(expectedStrings) / sizeof(expectedStrings[0])); index++) {
+        char string[XIMU3_SIZE_ASCII_TEMPERATURE + 1];
+        const Ximu3DataTemperature temperature = {timestamps[index], 20.0f};
+        const size_t stringSize = Ximu3AsciiCompactTimestamp(&compactTimestamp, string, Ximu3AsciiTemperature(string, sizeof(string), &temperature));
+        string[stringSize] = '\0';
+        if (strcmp(string, expectedStrings[index]) != 0) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tASCII compact timestamp %s", string);
+        } else {
+            passCount++;
+        }
+    }
+}
+
+static void TestCsv(void) {
+    char buffer[128];
+
+    // All columns
+    Ximu3Csv inertialCsv = {
+        .descriptor = &ximu3DescriptorInertial,
+        .precision = XIMU3_ASCII_PRECISION_DEFAULT,
+        .buffer = buffer,
+        .bufferSize = sizeof(buffer),
+        .write = CsvWrite,
+    };
+    csvOutputSize = 0;
+    csvNumberOfWrites = 0;
+    Ximu3CsvHeadings(&inertialCsv);
+    bool rows = true;
+    for (uint64_t timestamp = 1000; timestamp < 1003; timestamp++) {
+        const Ximu3DataInertial data = {timestamp, 1.0f, -2.5f, 0.125f, 100.0f, -0.0001f, FLT_MAX};
+        rows = rows && (Ximu3CsvRow(&inertialCsv, &data) == Ximu3ResultOk);
+    }
+    Ximu3CsvFlush(&inertialCsv);
+    static const char expectedInertial[] = "Timestamp (us),Gyroscope X (deg/s),Gyroscope Y (deg/s),Gyroscope Z (deg/s),Accelerometer X (g),Accelerometer Y (g),Accelerometer Z (g)\n"
+                                           "1000,1.0000,-2.5000,0.1250,100.0000,-0.0001,999999.9999\n"
+                                           "1001,1.0000,-2.5000,0.1250,100.0000,-0.0001,999999.9999\n"
+                                           "1002,1.0000,-2.5000,0.1250,100.0000,-0.0001,999999.9999\n";
+    const bool inertial = rows && (csvOutputSize == (sizeof(expectedInertial) - 1)) && (memcmp(csvOutput, expectedInertial, csvOutputSize) == 0) && (csvNumberOfWrites == 4);
+
+    // Selected columns
+    static const size_t columns[] = {3, 0};
+    Ximu3Csv ahrsStatusCsv = {
+        .descriptor = &ximu3DescriptorAhrsStatus,
+        .columns = columns,
+        .numberOfColumns = sizeof(columns) / sizeof(columns[0]),
+        .buffer = buffer,
+        .bufferSize = sizeof(buffer),
+        .write = CsvWrite,
+    };
+    csvOutputSize = 0;
+    Ximu3CsvHeadings(&ahrsStatusCsv);
+    const Ximu3DataAhrsStatus ahrsStatusData = {UINT64_MAX, true, false, false, false};
+    Ximu3CsvRow(&ahrsStatusCsv, &ahrsStatusData);
+    Ximu3CsvFlush(&ahrsStatusCsv);
+    static const char expectedAhrsStatus[] = "Timestamp (us),Magnetic Recovery,Initialising\n18446744073709551615,0,1\n";
+    const bool ahrsStatus = (csvOutputSize == (sizeof(expectedAhrsStatus) - 1)) && (memcmp(csvOutput, expectedAhrsStatus, csvOutputSize) == 0);
+
+    // Quoted strings, packed timecode and invalid rows
+    Ximu3Csv notificationCsv = {
+        .descriptor = &ximu3DescriptorNotification,
+        .buffer = buffer,
+        .bufferSize = sizeof(buffer),
+        .write = CsvWrite,
+    };
+    char ltcBuffer[64];
+    Ximu3Csv ltcCsv = {
+        .descriptor = &ximu3DescriptorLtc,
+        .buffer = ltcBuffer,
+        .bufferSize = sizeof(ltcBuffer),
+        .write = CsvWrite,
+    };
+    static const size_t invalidColumns[] = {1};
+    Ximu3Csv invalidCsv = {
+        .descriptor = &ximu3DescriptorSync,
+        .columns = invalidColumns,
+        .numberOfColumns = 1,
+        .buffer = buffer,
+        .bufferSize = sizeof(buffer),
+        .write = CsvWrite,
+    };
+    char tooLong[64];
+    memset(tooLong, '"', sizeof(tooLong) - 1);
+    tooLong[sizeof(tooLong) - 1] = '\0';
+    csvOutputSize = 0;
+    const Ximu3DataNotification notificationData = {1, "a \"b\", c\n"};
+    const Ximu3DataNotification tooLongData = {2, tooLong};
+    uint32_t packedTimecode;
+    Ximu3LtcPack("01:23:45:12", &packedTimecode);
+    const Ximu3DataLtc ltcData = {3, NULL, packedTimecode};
+    const Ximu3DataLtc invalidLtcData = {4, NULL, 0xFFFFFFFF};
+    const Ximu3DataSync syncData = {5, true};
+    const bool results = (Ximu3CsvRow(&notificationCsv, &notificationData) == Ximu3ResultOk) && (Ximu3CsvRow(&notificationCsv, &tooLongData) == Ximu3ResultError) &&
+                         (Ximu3CsvRow(&ltcCsv, &ltcData) == Ximu3ResultOk) && (Ximu3CsvRow(&ltcCsv, &invalidLtcData) == Ximu3ResultError) && (Ximu3CsvRow(&invalidCsv, &syncData) == Ximu3ResultError);
+    Ximu3CsvFlush(&notificationCsv);
+    Ximu3CsvFlush(&ltcCsv);
+    static const char expectedStrings[] = "1,\"a \"\"b\"\", c?\"\n3,\"01:23:45:12\"\n";
+    const bool strings = results && (csvOutputSize == (sizeof(expectedStrings) - 1)) && (memcmp(csvOutput, expectedStrings, csvOutputSize) == 0);
+
+    if ((inertial == false) || (ahrsStatus == false) || (strings == false)) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tCSV\n");
+    } else {
+        passCount++;
+    }
+}
+
+static void CsvWrite(const void *const data, const size_t numberOfBytes, void *const context) {
+    (void) context; // avoid compiler warning
+    if (numberOfBytes <= (sizeof(csvOutput) - csvOutputSize)) {
+        memcpy(&csvOutput[csvOutputSize], data, numberOfBytes);
+        csvOutputSize += numberOfBytes;
+    }
+    csvNumberOfWrites++;
+}
+
+static void TestRouter(void) {
+    const Ximu3Writer usb = {
+        .reserve = RouterReserve,
+        .commit = RouterCommit,
+        .context = &usbOutput,
+    };
+    const Ximu3Writer serial = {
+        .reserve = RouterReserve,
+        .commit = RouterCommit,
+        .context = &serialOutput,
+    };
+    Ximu3Router router = {
+        .writers = {
+            [Ximu3RouterInterfaceUsb] = &usb,
+            [Ximu3RouterInterfaceSerial] = &serial,
+        },
+    };
+    const float a = FloatFromBits(UINT32_C(0x0ADB0ADB));
+    const Ximu3DataInertial inertial = {UINT64_C(0x0A0A0A0A0A0A0A0A), 1.0f, -2.0f, a, 4.0f, 1E-6f, 100.0f};
+    const Ximu3DataQuaternion quaternion = {UINT64_C(0x0ADBDD0A0ADBDC00), 1.0f, a, 0.5f, 0.0f};
+    const Ximu3DataNotification notification = {UINT64_C(1000), "\x0A\xDB notification"};
+    uint32_t packedTimecode;
+    Ximu3LtcPack("10:10:10:10", &packedTimecode); // "10" requires byte stuffing
+    const Ximu3DataLtc ltc = {UINT64_C(3), "10:10:10:10", 0};
+    const Ximu3DataLtc packedLtc = {UINT64_C(3), NULL, packedTimecode};
+    const Ximu3DataLtc invalidLtc = {UINT64_C(3), NULL, UINT32_C(0x18000000)}; // 24 hours
+    uint8_t expected[1024];
+    uint8_t expectedCobs[1024];
+
+    // ASCII to both interfaces
+    Ximu3SettingsValues values = {
+        .serialEnabled = true,
+        .asciiPrecision = 2,
+        .usbDataMessagesEnabled = true,
+        .serialDataMessagesEnabled = true,
+    };
+    Ximu3RouterApply(&router, &values);
+    size_t expectedSize = Ximu3AsciiMessagePrecision(expected, sizeof(expected), &ximu3DescriptorInertial, &inertial, 2);
+    TestRouterMessage("ASCII", &router, &ximu3DescriptorInertial, &inertial, expected, expectedSize, expected, expectedSize);
+
+    expectedSize = Ximu3AsciiLtc(expected, sizeof(expected), &ltc);
+    TestRouterMessage("ASCII packed LTC", &router, &ximu3DescriptorLtc, &packedLtc, expected, expectedSize, expected, expectedSize);
+    TestRouterMessage("ASCII invalid packed LTC", &router, &ximu3DescriptorLtc, &invalidLtc, NULL, 0, NULL, 0);
+
+    // Binary with byte stuffing to USB and COBS to serial
+    values.binaryModeEnabled = true;
+    values.binaryPayloadFormat = Ximu3BinaryPayloadFormatFloat16;
+    values.usbBinaryFraming = Ximu3BinaryFramingByteStuffing;
+    values.serialBinaryFraming = Ximu3BinaryFramingCobs;
+    Ximu3RouterApply(&router, &values);
+    expectedSize = Ximu3BinaryInertialPayloadFormat(expected, sizeof(expected), &inertial, Ximu3BinaryPayloadFormatFloat16);
+    size_t expectedCobsSize = Ximu3BinaryCobs(expectedCobs, sizeof(expectedCobs), expected, expectedSize);
+    TestRouterMessage("binary payload format", &router, &ximu3DescriptorInertial, &inertial, expected, expectedSize, expectedCobs, expectedCobsSize);
+
+    values.binaryQuaternionCompression = Ximu3BinaryQuaternionCompression48Bit;
+    Ximu3RouterApply(&router, &values);
+    expectedSize = Ximu3BinaryQuaternionCompressed(expected, sizeof(expected), &quaternion, Ximu3BinaryPayloadFormatFloat16, Ximu3BinaryQuaternionCompression48Bit);
+    expectedCobsSize = Ximu3BinaryCobs(expectedCobs, sizeof(expectedCobs), expected, expectedSize);
+    TestRouterMessage("binary quaternion compression", &router, &ximu3DescriptorQuaternion, &quaternion, expected, expectedSize, expectedCobs, expectedCobsSize);
+
+    expectedSize = Ximu3BinaryLtc(expected, sizeof(expected), &ltc);
+    expectedCobsSize = Ximu3BinaryCobs(expectedCobs, sizeof(expectedCobs), expected, expectedSize);
+    TestRouterMessage("binary packed LTC", &router, &ximu3DescriptorLtc, &packedLtc, expected, expectedSize, expectedCobs, expectedCobsSize);
+    TestRouterMessage("binary invalid packed LTC", &router, &ximu3DescriptorLtc, &invalidLtc, NULL, 0, NULL, 0);
+
+    expectedSize = Ximu3BinaryNotification(expected, sizeof(expected), &notification);
+    expectedCobsSize = Ximu3BinaryCobs(expectedCobs, sizeof(expectedCobs), expected, expectedSize);
+    TestRouterMessage("binary notification", &router, &ximu3DescriptorNotification, &notification, expected, expectedSize, expectedCobs, expectedCobsSize);
+
+    // Settings not applied
+    values.usbDataMessagesEnabled = false;
+    TestRouterMessage("settings not applied", &router, &ximu3DescriptorNotification, &notification, expected, expectedSize, expectedCobs, expectedCobsSize);
+
+    // Interfaces disabled
+    values.serialEnabled = false;
+    Ximu3RouterApply(&router, &values);
+    TestRouterMessage("interfaces disabled", &router, &ximu3DescriptorNotification, &notification, NULL, 0, NULL, 0);
+
+    // Interface without writer
+    values.usbDataMessagesEnabled = true;
+    values.serialEnabled = true;
+    router.writers[Ximu3RouterInterfaceUsb] = NULL;
+    Ximu3RouterApply(&router, &values);
+    TestRouterMessage("interface without writer", &router, &ximu3DescriptorNotification, &notification, NULL, 0, expectedCobs, expectedCobsSize);
+}
+
+static void TestRouterMessage(const char *const name, Ximu3Router *const router, const Ximu3Descriptor *const descriptor, const void *const data, const void *const expectedUsb, const size_t expectedUsbSize, const void *const expectedSerial, const size_t expectedSerialSize) {
+    usbOutput.size = 0;
+    serialOutput.size = 0;
+    Ximu3RouterMessage(router, descriptor, data);
+    if ((usbOutput.size != expectedUsbSize) || ((expectedUsbSize > 0) && (memcmp(usbOutput.buffer, expectedUsb, expectedUsbSize) != 0)) ||
+        (serialOutput.size != expectedSerialSize) || ((expectedSerialSize > 0) && (memcmp(serialOutput.buffer, expectedSerial, expectedSerialSize) != 0))) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tRouter %s\n", name);
+    } else {
+        passCount++;
+    }
+}
+
+static void TestWorstCaseSize(void) {
+    const uint64_t timestamp = UINT64_C(0x0A0A0A0A0A0A0A0A); // bytes that require byte stuffing
+    const Ximu3DataAhrsStatus ahrsStatus = {timestamp, true, true, true, true};
+    const Ximu3DataSync sync = {timestamp, true};
+    const Ximu3DataButton button = {timestamp, true};
+    const Ximu3DataAhrsStatus asciiAhrsStatus = {UINT64_MAX, true, true, true, true};
+    const Ximu3DataSync asciiSync = {UINT64_MAX, true};
+    const Ximu3DataButton asciiButton = {UINT64_MAX, true};
+    const struct {
+        const char *const name;
+        const Ximu3Descriptor *const descriptor;
+        const void *const data;
+        const bool binary;
+        const size_t size;
+    } messages[] = {
+        {"binary AHRS status", &ximu3DescriptorAhrsStatus, &ahrsStatus, true, XIMU3_SIZE_BINARY_AHRS_STATUS},
+        {"binary sync", &ximu3DescriptorSync, &sync, true, XIMU3_SIZE_BINARY_SYNC},
+        {"binary button", &ximu3DescriptorButton, &button, true, XIMU3_SIZE_BINARY_BUTTON},
+        {"ASCII AHRS status", &ximu3DescriptorAhrsStatus, &asciiAhrsStatus, false, XIMU3_SIZE_ASCII_AHRS_STATUS},
+        {"ASCII sync", &ximu3DescriptorSync, &asciiSync, false, XIMU3_SIZE_ASCII_SYNC},
+        {"ASCII button", &ximu3DescriptorButton, &asciiButton, false, XIMU3_SIZE_ASCII_BUTTON},
+    };
+    for (size_t index = 0; index < (sizeof(messages) / sizeof(messages[0])); index++) {
+        uint8_t expected[256];
+        uint8_t actual[256];
+        size_t expectedSize;
+        size_t actualSize;
+        if (messages[index].binary) {
+            expectedSize = Ximu3BinaryMessage(expected, sizeof(expected), messages[index].descriptor, messages[index].data);
+            actualSize = Ximu3BinaryMessage(actual, messages[index].size, messages[index].descriptor, messages[index].data);
+        } else {
+            expectedSize = Ximu3AsciiMessagePrecision(expected, sizeof(expected), messages[index].descriptor, messages[index].data, XIMU3_ASCII_PRECISION_MAX);
+            actualSize = Ximu3AsciiMessagePrecision(actual, messages[index].size, messages[index].descriptor, messages[index].data, XIMU3_ASCII_PRECISION_MAX);
+        }
+        if ((expectedSize != messages[index].size) || (actualSize != expectedSize) || (memcmp(actual, expected, expectedSize) != 0)) {
+            failCount++;
+            printf("Failed\n");
+            printf("\tWorst case size of %s\n", messages[index].name);
+        } else {
+            passCount++;
+        }
+    }
+}
+
+static void TestPool(void) {
+    static uint8_t slots[3][XIMU3_SIZE_BINARY_AHRS_STATUS]; // slot size is not a multiple of the pointer alignment
+    Ximu3Pool pool = {
+        .slots = slots,
+        .slotSize = sizeof(slots[0]),
+        .numberOfSlots = sizeof(slots) / sizeof(slots[0]),
+    };
+    const Ximu3DataAhrsStatus ahrsStatus = {UINT64_C(0x0A0A0A0A0A0A0A0A), true, true, true, true};
+    uint8_t expected[XIMU3_SIZE_BINARY_AHRS_STATUS];
+    const size_t expectedSize = Ximu3BinaryAhrsStatus(expected, sizeof(expected), &ahrsStatus);
+
+    // Allocate all slots
+    uint8_t *allocated[3];
+    for (size_t index = 0; index < 3; index++) {
+        allocated[index] = Ximu3PoolAlloc(&pool);
+    }
+    bool passed = (allocated[0] == slots[0]) && (allocated[1] == slots[1]) && (allocated[2] == slots[2]) && (Ximu3PoolAlloc(&pool) == NULL);
+
+    // Free and reallocate
+    Ximu3PoolFree(&pool, allocated[1]);
+    passed = passed && (Ximu3PoolAlloc(&pool) == slots[1]) && (Ximu3PoolAlloc(&pool) == NULL);
+    Ximu3PoolFree(&pool, NULL);
+    for (size_t index = 0; index < 3; index++) {
+        Ximu3PoolFree(&pool, allocated[index]);
+    }
+    for (size_t index = 0; index < 3; index++) {
+        allocated[index] = Ximu3PoolAlloc(&pool);
+    }
+    passed = passed && (allocated[0] == slots[2]) && (allocated[1] == slots[1]) && (allocated[2] == slots[0]) && (Ximu3PoolAlloc(&pool) == NULL);
+
+    // Messages in slots
+    for (size_t index = 0; index < 3; index++) {
+        passed = passed && (Ximu3BinaryAhrsStatus(allocated[index], pool.slotSize, &ahrsStatus) == expectedSize);
+    }
+    for (size_t index = 0; index < 3; index++) {
+        passed = passed && (memcmp(slots[index], expected, expectedSize) == 0);
+    }
+    if (passed == false) {
+        failCount++;
+        printf("Failed\n");
+        printf("\tPool\n");
+    } else {
+        passCount++;
+    }
+}
+
+static void *RouterReserve(const size_t numberOfBytes, void *const context) {
+    RouterOutput *const output = context;
+    if (numberOfBytes > (sizeof(output->buffer) - output->size)) {
+        return NULL;
+    }
+    return &output->buffer[output->size];
+}
+
+static void RouterCommit(const size_t numberOfBytes, void *const context) {
+    RouterOutput *const output = context;
+    output->size += numberOfBytes;
+}
+
+static void *RingReserve(const size_t numberOfBytes, void *const context) {
+    (void) context; // avoid compiler warning
+    ring.reservation = NULL;
+    if (ring.writeIndex >= ring.readIndex) {
+        if ((sizeof(ring.buffer) - ring.writeIndex) >= numberOfBytes) {
+            ring.reservation = &ring.buffer[ring.writeIndex];
+        } else if (ring.readIndex > numberOfBytes) {
+            ring.reservation = ring.buffer; // wrap to start
+        }
+    } else if ((ring.readIndex - ring.writeIndex) > numberOfBytes) {
+        ring.reservation = &ring.buffer[ring.writeIndex];
+    }
+    return ring.reservation;
+}
+
+static void RingCommit(const size_t numberOfBytes, void *const context) {
+    (void) context; // avoid compiler warning
+    if ((ring.reservation == ring.buffer) && (ring.writeIndex != 0)) {
+        ring.wrapIndex = ring.writeIndex;
+        ring.writeIndex = 0;
+    }
+    ring.writeIndex += numberOfBytes;
+}
+
+static size_t RingTransmit(uint8_t *const destination) {
+    size_t numberOfBytes = 0;
+    if (ring.writeIndex < ring.readIndex) {
+        memcpy(destination, &ring.buffer[ring.readIndex], ring.wrapIndex - ring.readIndex);
+        numberOfBytes = ring.wrapIndex - ring.readIndex;
+        ring.readIndex = 0;
+    }
+    memcpy(&destination[numberOfBytes], &ring.buffer[ring.readIndex], ring.writeIndex - ring.readIndex);
+    numberOfBytes += ring.writeIndex - ring.readIndex;
+    ring.readIndex = ring.writeIndex;
+    return numberOfBytes;
+}
+
+static float FloatFromBits(const uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void DecodedInertial(const Ximu3DataInertial *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryInertialPayloadFormat(&decoded[decodedSize], sizeof(decoded) - decodedSize, data, decoder.payloadFormat);
+}
+
+static void DecodedMagnetometer(const Ximu3DataMagnetometer *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryMagnetometerPayloadFormat(&decoded[decodedSize], sizeof(decoded) - decodedSize, data, decoder.payloadFormat);
+}
+
+static void DecodedHighGAccelerometer(const Ximu3DataHighGAccelerometer *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryHighGAccelerometerPayloadFormat(&decoded[decodedSize], sizeof(decoded) - decodedSize, data, decoder.payloadFormat);
+}
+
+static void DecodedQuaternion(const Ximu3DataQuaternion *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryQuaternionPayloadFormat(&decoded[decodedSize], sizeof(decoded) - decodedSize, data, decoder.payloadFormat);
+}
+
+static void DecodedRotationMatrix(const Ximu3DataRotationMatrix *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryRotationMatrixPayloadFormat(&decoded[decodedSize], sizeof(decoded) - decodedSize, data, decoder.payloadFormat);
+}
+
+static void DecodedEulerAngles(const Ximu3DataEulerAngles *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryEulerAnglesPayloadFormat(&decoded[decodedSize], sizeof(decoded) - decodedSize, data, decoder.payloadFormat);
+}
+
+static void DecodedLinearAcceleration(const Ximu3DataLinearAcceleration *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryLinearAccelerationPayloadFormat(&decoded[decodedSize], sizeof(decoded) - decodedSize, data, decoder.payloadFormat);
+}
+
+static void DecodedEarthAcceleration(const Ximu3DataEarthAcceleration *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryEarthAccelerationPayloadFormat(&decoded[decodedSize], sizeof(decoded) - decodedSize, data, decoder.payloadFormat);
+}
+
+static void DecodedAhrsStatus(const Ximu3DataAhrsStatus *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryAhrsStatus(&decoded[decodedSize], sizeof(decoded) - decodedSize, data);
+}
+
+static void DecodedSerialAccessory(const Ximu3DataSerialAccessory *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinarySerialAccessory(&decoded[decodedSize], sizeof(decoded) - decodedSize, data);
+}
+
+static void DecodedSync(const Ximu3DataSync *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinarySync(&decoded[decodedSize], sizeof(decoded) - decodedSize, data);
+}
+
+static void DecodedLtc(const Ximu3DataLtc *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryLtc(&decoded[decodedSize], sizeof(decoded) - decodedSize, data);
+}
+
+static void DecodedTemperature(const Ximu3DataTemperature *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryTemperaturePayloadFormat(&decoded[decodedSize], sizeof(decoded) - decodedSize, data, decoder.payloadFormat);
+}
+
+static void DecodedBattery(const Ximu3DataBattery *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryBattery(&decoded[decodedSize], sizeof(decoded) - decodedSize, data);
+}
+
+static void DecodedRssi(const Ximu3DataRssi *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryRssi(&decoded[decodedSize], sizeof(decoded) - decodedSize, data);
+}
+
+static void DecodedButton(const Ximu3DataButton *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryButton(&decoded[decodedSize], sizeof(decoded) - decodedSize, data);
+}
+
+static void DecodedNotification(const Ximu3DataNotification *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryNotification(&decoded[decodedSize], sizeof(decoded) - decodedSize, data);
+}
+
+static void DecodedError(const Ximu3DataError *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryError(&decoded[decodedSize], sizeof(decoded) - decodedSize, data);
+}
+
+static void DecodedCustom(const Ximu3Descriptor *const descriptor, const void *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    decodedSize += Ximu3BinaryMessage(&decoded[decodedSize], sizeof(decoded) - decodedSize, descriptor, data);
+}
+
+static void DecodeError(const char *const error, void *const context) {
+    (void) error; // avoid compiler warning
+    (void) context; // avoid compiler warning
+    decodeErrorCount++;
+}
+
+static void DecompressError(const char *const error, void *const context) {
+    (void) error; // avoid compiler warning
+    (void) context; // avoid compiler warning
+    decompressErrorCount++;
+}
+
+static void ParsedInertial(const Ximu3DataInertial *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiInertial(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedMagnetometer(const Ximu3DataMagnetometer *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiMagnetometer(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedHighGAccelerometer(const Ximu3DataHighGAccelerometer *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiHighGAccelerometer(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedQuaternion(const Ximu3DataQuaternion *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiQuaternion(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedRotationMatrix(const Ximu3DataRotationMatrix *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiRotationMatrix(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedEulerAngles(const Ximu3DataEulerAngles *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiEulerAngles(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedLinearAcceleration(const Ximu3DataLinearAcceleration *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiLinearAcceleration(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedEarthAcceleration(const Ximu3DataEarthAcceleration *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiEarthAcceleration(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedAhrsStatus(const Ximu3DataAhrsStatus *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiAhrsStatus(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedSerialAccessory(const Ximu3DataSerialAccessory *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiSerialAccessory(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedSync(const Ximu3DataSync *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiSync(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedLtc(const Ximu3DataLtc *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiLtc(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedTemperature(const Ximu3DataTemperature *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedTemperature = data->temperature;
+    parsedSize += Ximu3AsciiTemperature(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedBattery(const Ximu3DataBattery *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiBattery(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedRssi(const Ximu3DataRssi *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiRssi(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedButton(const Ximu3DataButton *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiButton(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedNotification(const Ximu3DataNotification *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiNotification(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedError(const Ximu3DataError *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiError(&parsed[parsedSize], sizeof(parsed) - parsedSize, data);
+}
+
+static void ParsedCustom(const Ximu3Descriptor *const descriptor, const void *const data, void *const context) {
+    (void) context; // avoid compiler warning
+    parsedSize += Ximu3AsciiMessage(&parsed[parsedSize], sizeof(parsed) - parsedSize, descriptor, data);
+}
+
+static void ParseError(const char *const error, void *const context) {
+    (void) error; // avoid compiler warning
+    (void) context; // avoid compiler warning
+    parseErrorCount++;
+}
+
 //------------------------------------------------------------------------------
 // End of file
@@ -15,13 +15,25 @@ extern "C" {
 #endif
 
 #include "Ximu3Ascii.h"
+#include "Ximu3AsciiParser.h"
 #include "Ximu3Binary.h"
+#include "Ximu3BinaryDecoder.h"
 #include "Ximu3Command.h"
+#include "Ximu3CompactTimestamp.h"
+#include "Ximu3Compression.h"
+#include "Ximu3Csv.h"
 #include "Ximu3Data.h"
 #include "Ximu3Definitions.h"
+#include "Ximu3Descriptor.h"
+#include "Ximu3Intern.h"
+#include "Ximu3Ltc.h"
+#include "Ximu3Pool.h"
+#include "Ximu3Printable.h"
+#include "Ximu3Router.h"
 #include "Ximu3Settings.h"
 #include "Ximu3SettingsJson.h"
 #include "Ximu3Size.h"
+#include "Ximu3Writer.h"
 
 #ifdef __cplusplus
 }
@@ -1,47 +1,191 @@
 /**
  * @file Ximu3Ascii.c
  * @author Seb Madgwick
- * @brief x-IMU3 ASCII data messages.
+ * @brief x-IMU3 ASCII data messages. Floats are written in blocks, so an
+ * encoder may write bytes after the message up to the destination size.
  */
 
 //------------------------------------------------------------------------------
 // Includes
 
+#include <string.h>
 #include "Ximu3Ascii.h"
 #include "Ximu3Definitions.h"
+#include "Ximu3Intern.h"
+#include "Ximu3Ltc.h"
+#include "Ximu3Printable.h"
+#include "Ximu3Size.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define FLOAT_DIGITS_SSE2
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define FLOAT_DIGITS_NEON
+#endif
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of floats converted to digits at a time.
+ */
+#define FLOAT_DIGITS_BLOCK (4)
+
+/**
+ * @brief Floats converted to digits. Each float is represented as 6 integer
+ * digits and 6 fractional digits, as pairs of digits from most to least
+ * significant. Members are arrays of one value per float so that they can be
+ * stored directly from vector registers.
+ */
+typedef struct {
+    int32_t negative[FLOAT_DIGITS_BLOCK];
+    int32_t numberOfDigits[FLOAT_DIGITS_BLOCK]; // significant integer digits
+    int32_t pairs[6][FLOAT_DIGITS_BLOCK];
+} FloatDigits;
 
 //------------------------------------------------------------------------------
 // Function declarations
 
+static inline size_t StreamMaximumNumberOfBytes(const size_t maximumNumberOfBytes);
+static void StreamFlush(Ximu3AsciiSerialAccessoryStream * const stream);
+static void StreamHeader(Ximu3AsciiSerialAccessoryStream * const stream);
+static size_t Batch(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data, const size_t numberOfMessages, const size_t messageSize, size_t * const numberOfMessagesWritten);
+static inline void* BatchDestination(void* const destination, const size_t destinationSize, const size_t destinationIndex, void* const message, const size_t messageSize);
+static inline bool BatchCommit(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const void* const message, const size_t messageSize);
+static size_t WriteInterned(void* const destination, const size_t destinationSize, const char asciiId, const uint64_t timestamp, const char* const string, Ximu3Intern * const intern);
 static inline void WriteHeader(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char asciiId, const uint64_t timestamp);
-static inline void WriteFloat(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value);
+static inline bool IsFloatField(const Ximu3DescriptorField * const field);
+static inline size_t NumberOfContiguousFloats(const Ximu3Descriptor * const descriptor, const size_t index);
+static void WriteFloatArray(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float* const values, const size_t numberOfValues, const int precision);
+static void WriteFloats(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float values[FLOAT_DIGITS_BLOCK], const size_t firstValue, const int precision);
+static inline void ConvertFloats(const float* const values, FloatDigits * const digits, const int precision);
+static inline uint32_t RoundFraction(const float fraction, const uint32_t scale);
 static inline void WriteString(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* string);
+static inline void WriteBytes(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t* bytes, const size_t numberOfBytes);
+static inline void WriteCharacters(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* const characters, const size_t numberOfCharacters);
 static inline void WriteTermination(void* const destination, const size_t destinationSize, size_t * const destinationIndex);
+static inline void WriteDigits(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* const digits, const size_t numberOfDigits);
+static inline size_t FormatUint64(char* const end, uint64_t value);
+static inline size_t FormatUint32(char* const end, uint32_t value);
+static inline uint32_t DivideBy10000(uint64_t * const value);
 static inline void WriteChar(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char character);
+static inline char Printable(const char character);
+
+//------------------------------------------------------------------------------
+// Variables
+
+/**
+ * @brief Decimal digits of 0 to 99 as character pairs.
+ */
+static const char digitPairs[200] = {
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899"
+};
+
+/**
+ * @brief Powers of ten indexed by precision.
+ */
+static const uint32_t powersOfTen[XIMU3_ASCII_PRECISION_MAX + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000};
 
 //------------------------------------------------------------------------------
 // Functions
 
 /**
- * @brief Writes an ASCII inertial data message.
+ * @brief Writes an ASCII data message described by a descriptor. Bytes after
+ * the message may be written up to the destination size.
  * @param destination Destination.
  * @param destinationSize Destination size.
+ * @param descriptor Descriptor.
  * @param data Data.
  * @return Message size.
  */
-size_t Ximu3AsciiInertial(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data) {
+size_t Ximu3AsciiMessage(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, descriptor, data, XIMU3_ASCII_PRECISION_DEFAULT);
+}
+
+/**
+ * @brief Writes an ASCII data message described by a descriptor with floats
+ * written to the specified number of decimal places. Bytes after the message
+ * may be written up to the destination size.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param descriptor Descriptor.
+ * @param data Data.
+ * @param precision Number of decimal places. Limited to 0 to
+ * XIMU3_ASCII_PRECISION_MAX.
+ * @return Message size.
+ */
+size_t Ximu3AsciiMessagePrecision(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data, const int precision) {
+    const int limitedPrecision = precision < 0 ? 0 : (precision > XIMU3_ASCII_PRECISION_MAX ? XIMU3_ASCII_PRECISION_MAX : precision);
+    const uint8_t* members = data;
+
+    // Unpack timecode
+    Ximu3DataLtc ltc;
+    char timecode[XIMU3_LTC_TIMECODE_SIZE];
+    if ((descriptor->asciiId == XIMU3_ASCII_ID_LTC) && (((const Ximu3DataLtc*) data)->timecode == NULL)) {
+        ltc = *(const Ximu3DataLtc*) data;
+        if (Ximu3LtcUnpack(ltc.packedTimecode, timecode) == false) {
+            return 0;
+        }
+        ltc.timecode = timecode;
+        members = (const uint8_t*) &ltc;
+    }
     size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_INERTIAL, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->gyroscopeX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->gyroscopeY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->gyroscopeZ);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->accelerometerX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->accelerometerY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->accelerometerZ);
+    WriteHeader(destination, destinationSize, &destinationIndex, descriptor->asciiId, *(const uint64_t*) members);
+    for (size_t index = 0; index < descriptor->numberOfFields; index++) {
+        const Ximu3DescriptorField * const field = &descriptor->fields[index];
+        const void* const member = &members[field->offset];
+        switch (field->type) {
+            case Ximu3DescriptorFieldTypeFloat:
+            case Ximu3DescriptorFieldTypeBool: {
+                const size_t numberOfFloats = NumberOfContiguousFloats(descriptor, index);
+                if (numberOfFloats >= FLOAT_DIGITS_BLOCK) {
+                    WriteFloatArray(destination, destinationSize, &destinationIndex, member, numberOfFloats, limitedPrecision);
+                    index += numberOfFloats - 1;
+                    break;
+                }
+                size_t numberOfValues = 0;
+                while ((numberOfValues < FLOAT_DIGITS_BLOCK) && ((index + numberOfValues) < descriptor->numberOfFields) && IsFloatField(&descriptor->fields[index + numberOfValues])) {
+                    numberOfValues++;
+                }
+                float values[FLOAT_DIGITS_BLOCK] = {0.0f};
+                const size_t firstValue = FLOAT_DIGITS_BLOCK - numberOfValues;
+                for (size_t valueIndex = 0; valueIndex < numberOfValues; valueIndex++) {
+                    const Ximu3DescriptorField * const valueField = &descriptor->fields[index + valueIndex];
+                    const void* const valueMember = &members[valueField->offset];
+                    values[firstValue + valueIndex] = valueField->type == Ximu3DescriptorFieldTypeBool ? (float) *(const bool*) valueMember : *(const float*) valueMember;
+                }
+                WriteFloats(destination, destinationSize, &destinationIndex, values, firstValue, limitedPrecision);
+                index += numberOfValues - 1;
+                break;
+            }
+            case Ximu3DescriptorFieldTypeString:
+                WriteString(destination, destinationSize, &destinationIndex, *(const char* const *) member);
+                break;
+            case Ximu3DescriptorFieldTypeBytes:
+                WriteBytes(destination, destinationSize, &destinationIndex, *(const uint8_t* const *) member, *(const size_t*) &members[field->numberOfBytesOffset]);
+                break;
+        }
+    }
     WriteTermination(destination, destinationSize, &destinationIndex);
     return destinationIndex;
 }
 
+/**
+ * @brief Writes an ASCII inertial data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+size_t Ximu3AsciiInertial(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data) {
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorInertial, data);
+}
+
 /**
  * @brief Writes an ASCII magnetometer data message.
  * @param destination Destination.
@@ -50,13 +194,7 @@ size_t Ximu3AsciiInertial(void* const destination, const size_t destinationSize,
  * @return Message size.
  */
 size_t Ximu3AsciiMagnetometer(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_MAGNETOMETER, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->x);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->y);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->z);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorMagnetometer, data);
 }
 
 /**
@@ -67,13 +205,7 @@ size_t Ximu3AsciiMagnetometer(void* const destination, const size_t destinationS
  * @return Message size.
  */
 size_t Ximu3AsciiHighGAccelerometer(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->x);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->y);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->z);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorHighGAccelerometer, data);
 }
 
 /**
@@ -84,14 +216,7 @@ size_t Ximu3AsciiHighGAccelerometer(void* const destination, const size_t destin
  * @return Message size.
  */
 size_t Ximu3AsciiQuaternion(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_QUATERNION, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->w);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->x);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->y);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->z);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorQuaternion, data);
 }
 
 /**
@@ -102,19 +227,7 @@ size_t Ximu3AsciiQuaternion(void* const destination, const size_t destinationSiz
  * @return Message size.
  */
 size_t Ximu3AsciiRotationMatrix(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_ROTATION_MATRIX, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->xx);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->xy);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->xz);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->yx);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->yy);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->yz);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->zx);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->zy);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->zz);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorRotationMatrix, data);
 }
 
 /**
@@ -125,13 +238,7 @@ size_t Ximu3AsciiRotationMatrix(void* const destination, const size_t destinatio
  * @return Message size.
  */
 size_t Ximu3AsciiEulerAngles(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_EULER_ANGLES, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->roll);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->pitch);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->yaw);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorEulerAngles, data);
 }
 
 /**
@@ -142,17 +249,7 @@ size_t Ximu3AsciiEulerAngles(void* const destination, const size_t destinationSi
  * @return Message size.
  */
 size_t Ximu3AsciiLinearAcceleration(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_LINEAR_ACCELERATION, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionW);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionZ);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationZ);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorLinearAcceleration, data);
 }
 
 /**
@@ -163,17 +260,7 @@ size_t Ximu3AsciiLinearAcceleration(void* const destination, const size_t destin
  * @return Message size.
  */
 size_t Ximu3AsciiEarthAcceleration(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_EARTH_ACCELERATION, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionW);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionZ);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationZ);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorEarthAcceleration, data);
 }
 
 /**
@@ -184,14 +271,7 @@ size_t Ximu3AsciiEarthAcceleration(void* const destination, const size_t destina
  * @return Message size.
  */
 size_t Ximu3AsciiAhrsStatus(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_AHRS_STATUS, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->initialising);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->angularRateRecovery);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->accelerationRecovery);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->magneticRecovery);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorAhrsStatus, data);
 }
 
 /**
@@ -202,15 +282,7 @@ size_t Ximu3AsciiAhrsStatus(void* const destination, const size_t destinationSiz
  * @return Message size.
  */
 size_t Ximu3AsciiSerialAccessory(void* const destination, const size_t destinationSize, const Ximu3DataSerialAccessory * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_SERIAL_ACCESSORY, data->timestamp);
-    WriteChar(destination, destinationSize, &destinationIndex, ',');
-    for (size_t index = 0; index < data->numberOfBytes; index++) {
-        const uint8_t byte = data->data[index];
-        WriteChar(destination, destinationSize, &destinationIndex, (char) byte);
-    }
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorSerialAccessory, data);
 }
 
 /**
@@ -221,26 +293,19 @@ size_t Ximu3AsciiSerialAccessory(void* const destination, const size_t destinati
  * @return Message size.
  */
 size_t Ximu3AsciiSync(void* const destination, const size_t destinationSize, const Ximu3DataSync * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_SYNC, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->edge);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorSync, data);
 }
 
 /**
- * @brief Writes an ASCII LTC data message.
+ * @brief Writes an ASCII LTC data message. The packed timecode is written if
+ * the timecode is NULL.
  * @param destination Destination.
  * @param destinationSize Destination size.
  * @param data Data.
- * @return Message size.
+ * @return Message size. 0 if the packed timecode is invalid.
  */
 size_t Ximu3AsciiLtc(void* const destination, const size_t destinationSize, const Ximu3DataLtc * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_LTC, data->timestamp);
-    WriteString(destination, destinationSize, &destinationIndex, data->timecode);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorLtc, data);
 }
 
 /**
@@ -251,11 +316,7 @@ size_t Ximu3AsciiLtc(void* const destination, const size_t destinationSize, cons
  * @return Message size.
  */
 size_t Ximu3AsciiTemperature(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_TEMPERATURE, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->temperature);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorTemperature, data);
 }
 
 /**
@@ -266,13 +327,7 @@ size_t Ximu3AsciiTemperature(void* const destination, const size_t destinationSi
  * @return Message size.
  */
 size_t Ximu3AsciiBattery(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_BATTERY, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->percentage);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->voltage);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->chargingStatus);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorBattery, data);
 }
 
 /**
@@ -283,12 +338,7 @@ size_t Ximu3AsciiBattery(void* const destination, const size_t destinationSize,
  * @return Message size.
  */
 size_t Ximu3AsciiRssi(void* const destination, const size_t destinationSize, const Ximu3DataRssi * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_RSSI, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->percentage);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->power);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorRssi, data);
 }
 
 /**
@@ -299,11 +349,7 @@ size_t Ximu3AsciiRssi(void* const destination, const size_t destinationSize, con
  * @return Message size.
  */
 size_t Ximu3AsciiButton(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_BUTTON, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->state);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorButton, data);
 }
 
 /**
@@ -314,11 +360,7 @@ size_t Ximu3AsciiButton(void* const destination, const size_t destinationSize, c
  * @return Message size.
  */
 size_t Ximu3AsciiNotification(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_NOTIFICATION, data->timestamp);
-    WriteString(destination, destinationSize, &destinationIndex, data->notification);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorNotification, data);
 }
 
 /**
@@ -329,9 +371,702 @@ size_t Ximu3AsciiNotification(void* const destination, const size_t destinationS
  * @return Message size.
  */
 size_t Ximu3AsciiError(void* const destination, const size_t destinationSize, const Ximu3DataError * const data) {
+    return Ximu3AsciiMessage(destination, destinationSize, &ximu3DescriptorError, data);
+}
+
+/**
+ * @brief Writes an ASCII inertial data message with the specified precision.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param precision Number of decimal places.
+ * @return Message size.
+ */
+size_t Ximu3AsciiInertialPrecision(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data, const int precision) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, &ximu3DescriptorInertial, data, precision);
+}
+
+/**
+ * @brief Writes an ASCII magnetometer data message with the specified precision.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param precision Number of decimal places.
+ * @return Message size.
+ */
+size_t Ximu3AsciiMagnetometerPrecision(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data, const int precision) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, &ximu3DescriptorMagnetometer, data, precision);
+}
+
+/**
+ * @brief Writes an ASCII high-g accelerometer data message with the specified precision.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param precision Number of decimal places.
+ * @return Message size.
+ */
+size_t Ximu3AsciiHighGAccelerometerPrecision(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data, const int precision) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, &ximu3DescriptorHighGAccelerometer, data, precision);
+}
+
+/**
+ * @brief Writes an ASCII quaternion data message with the specified precision.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param precision Number of decimal places.
+ * @return Message size.
+ */
+size_t Ximu3AsciiQuaternionPrecision(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const int precision) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, &ximu3DescriptorQuaternion, data, precision);
+}
+
+/**
+ * @brief Writes an ASCII rotation matrix data message with the specified precision.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param precision Number of decimal places.
+ * @return Message size.
+ */
+size_t Ximu3AsciiRotationMatrixPrecision(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data, const int precision) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, &ximu3DescriptorRotationMatrix, data, precision);
+}
+
+/**
+ * @brief Writes an ASCII Euler angles data message with the specified precision.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param precision Number of decimal places.
+ * @return Message size.
+ */
+size_t Ximu3AsciiEulerAnglesPrecision(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data, const int precision) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, &ximu3DescriptorEulerAngles, data, precision);
+}
+
+/**
+ * @brief Writes an ASCII linear acceleration data message with the specified precision.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param precision Number of decimal places.
+ * @return Message size.
+ */
+size_t Ximu3AsciiLinearAccelerationPrecision(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const int precision) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, &ximu3DescriptorLinearAcceleration, data, precision);
+}
+
+/**
+ * @brief Writes an ASCII Earth acceleration data message with the specified precision.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param precision Number of decimal places.
+ * @return Message size.
+ */
+size_t Ximu3AsciiEarthAccelerationPrecision(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const int precision) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, &ximu3DescriptorEarthAcceleration, data, precision);
+}
+
+/**
+ * @brief Writes an ASCII temperature data message with the specified precision.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param precision Number of decimal places.
+ * @return Message size.
+ */
+size_t Ximu3AsciiTemperaturePrecision(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data, const int precision) {
+    return Ximu3AsciiMessagePrecision(destination, destinationSize, &ximu3DescriptorTemperature, data, precision);
+}
+
+/**
+ * @brief Writes an ASCII notification data message with the notification
+ * interned.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param intern Intern table.
+ * @return Message size.
+ */
+size_t Ximu3AsciiNotificationInterned(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data, Ximu3Intern * const intern) {
+    const size_t messageSize = WriteInterned(destination, destinationSize, XIMU3_ASCII_ID_NOTIFICATION, data->timestamp, data->notification, intern);
+    if (messageSize == 0) {
+        return Ximu3AsciiNotification(destination, destinationSize, data);
+    }
+    return messageSize;
+}
+
+/**
+ * @brief Writes an ASCII error data message with the error interned.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param intern Intern table.
+ * @return Message size.
+ */
+size_t Ximu3AsciiErrorInterned(void* const destination, const size_t destinationSize, const Ximu3DataError * const data, Ximu3Intern * const intern) {
+    const size_t messageSize = WriteInterned(destination, destinationSize, XIMU3_ASCII_ID_ERROR, data->timestamp, data->error, intern);
+    if (messageSize == 0) {
+        return Ximu3AsciiError(destination, destinationSize, data);
+    }
+    return messageSize;
+}
+
+/**
+ * @brief Writes consecutive ASCII inertial data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiInertialBatch(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorInertial, data, numberOfMessages, XIMU3_SIZE_ASCII_INERTIAL, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII magnetometer data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiMagnetometerBatch(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorMagnetometer, data, numberOfMessages, XIMU3_SIZE_ASCII_MAGNETOMETER, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII high-g accelerometer data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiHighGAccelerometerBatch(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorHighGAccelerometer, data, numberOfMessages, XIMU3_SIZE_ASCII_HIGH_G_ACCELEROMETER, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII quaternion data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiQuaternionBatch(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorQuaternion, data, numberOfMessages, XIMU3_SIZE_ASCII_QUATERNION, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII rotation matrix data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiRotationMatrixBatch(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorRotationMatrix, data, numberOfMessages, XIMU3_SIZE_ASCII_ROTATION_MATRIX, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII Euler angles data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiEulerAnglesBatch(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorEulerAngles, data, numberOfMessages, XIMU3_SIZE_ASCII_EULER_ANGLES, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII linear acceleration data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiLinearAccelerationBatch(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorLinearAcceleration, data, numberOfMessages, XIMU3_SIZE_ASCII_LINEAR_ACCELERATION, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII Earth acceleration data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiEarthAccelerationBatch(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorEarthAcceleration, data, numberOfMessages, XIMU3_SIZE_ASCII_EARTH_ACCELERATION, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII AHRS status data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiAhrsStatusBatch(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorAhrsStatus, data, numberOfMessages, XIMU3_SIZE_ASCII_AHRS_STATUS, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII serial accessory data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiSerialAccessoryBatch(void* const destination, const size_t destinationSize, const Ximu3DataSerialAccessory * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorSerialAccessory, data, numberOfMessages, XIMU3_SIZE_ASCII_SERIAL_ACCESSORY, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII sync data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiSyncBatch(void* const destination, const size_t destinationSize, const Ximu3DataSync * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorSync, data, numberOfMessages, XIMU3_SIZE_ASCII_SYNC, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII LTC data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiLtcBatch(void* const destination, const size_t destinationSize, const Ximu3DataLtc * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorLtc, data, numberOfMessages, XIMU3_SIZE_ASCII_LTC, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII temperature data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiTemperatureBatch(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorTemperature, data, numberOfMessages, XIMU3_SIZE_ASCII_TEMPERATURE, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII battery data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiBatteryBatch(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorBattery, data, numberOfMessages, XIMU3_SIZE_ASCII_BATTERY, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII RSSI data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiRssiBatch(void* const destination, const size_t destinationSize, const Ximu3DataRssi * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorRssi, data, numberOfMessages, XIMU3_SIZE_ASCII_RSSI, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII button data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiButtonBatch(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorButton, data, numberOfMessages, XIMU3_SIZE_ASCII_BUTTON, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII notification data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiNotificationBatch(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorNotification, data, numberOfMessages, XIMU3_SIZE_ASCII_NOTIFICATION, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive ASCII error data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3AsciiErrorBatch(void* const destination, const size_t destinationSize, const Ximu3DataError * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorError, data, numberOfMessages, XIMU3_SIZE_ASCII_ERROR, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes floats, each preceded by a comma, with the formatter used for
+ * ASCII data messages. Bytes after the values may be overwritten within the
+ * destination size.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param values Values.
+ * @param numberOfValues Number of values.
+ * @param precision Number of decimal places. Limited to 0 to
+ * XIMU3_ASCII_PRECISION_MAX.
+ * @return Number of bytes written.
+ */
+size_t Ximu3AsciiFloats(void* const destination, const size_t destinationSize, const float* const values, const size_t numberOfValues, const int precision) {
+    const int limitedPrecision = precision < 0 ? 0 : (precision > XIMU3_ASCII_PRECISION_MAX ? XIMU3_ASCII_PRECISION_MAX : precision);
+    size_t destinationIndex = 0;
+    if (numberOfValues >= FLOAT_DIGITS_BLOCK) {
+        WriteFloatArray(destination, destinationSize, &destinationIndex, values, numberOfValues, limitedPrecision);
+        return destinationIndex;
+    }
+    if (numberOfValues == 0) {
+        return 0;
+    }
+    float block[FLOAT_DIGITS_BLOCK] = {0.0f};
+    const size_t firstValue = FLOAT_DIGITS_BLOCK - numberOfValues;
+    memcpy(&block[firstValue], values, numberOfValues * sizeof (float));
+    WriteFloats(destination, destinationSize, &destinationIndex, block, firstValue, limitedPrecision);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a 64-bit unsigned integer as decimal digits.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param value Value.
+ * @return Number of bytes written.
+ */
+size_t Ximu3AsciiUint64(void* const destination, const size_t destinationSize, const uint64_t value) {
+    char digits[20]; // UINT64_MAX is 20 digits
+    const size_t numberOfDigits = FormatUint64(&digits[sizeof (digits)], value);
+    size_t destinationIndex = 0;
+    WriteDigits(destination, destinationSize, &destinationIndex, &digits[sizeof (digits) - numberOfDigits], numberOfDigits);
+    return destinationIndex;
+}
+
+/**
+ * @brief Converts an ASCII data message to a compact message, in place, if
+ * permitted by the compact timestamp state. The message must have been written
+ * by one of the other functions in this module. The size of a compact message
+ * is never greater than the size of the original message.
+ * @param compactTimestamp Compact timestamp.
+ * @param message Message.
+ * @param messageSize Message size.
+ * @return Message size.
+ */
+size_t Ximu3AsciiCompactTimestamp(Ximu3CompactTimestamp * const compactTimestamp, void* const message, const size_t messageSize) {
+    char * const characters = (char*) message;
+
+    // Validate ID
+    if ((messageSize < 3) || (characters[0] < 'A') || (characters[0] > 'Z') || (characters[1] != ',')) {
+        return messageSize;
+    }
+
+    // Parse timestamp
+    size_t index = 2;
+    uint64_t timestamp = 0;
+    while ((index < messageSize) && (characters[index] >= '0') && (characters[index] <= '9')) {
+        const uint64_t digit = (uint64_t) (characters[index++] - '0');
+        if ((timestamp > (UINT64_MAX / 10)) || ((timestamp == (UINT64_MAX / 10)) && (digit > (UINT64_MAX % 10)))) {
+            return messageSize;
+        }
+        timestamp = (timestamp * 10) + digit;
+    }
+    if (index == 2) {
+        return messageSize;
+    }
+
+    // Update state
+    uint32_t delta;
+    if (Ximu3CompactTimestampUpdate(compactTimestamp, timestamp, &delta) == false) {
+        return messageSize;
+    }
+
+    // Write lowercase ID and timestamp delta
+    char header[sizeof ("x,2097151") - 1];
+    const size_t numberOfDigits = FormatUint32(&header[sizeof (header)], delta);
+    const size_t headerIndex = 2 + numberOfDigits;
+    memmove(&header[2], &header[sizeof (header) - numberOfDigits], numberOfDigits);
+    header[0] = (char) (characters[0] | 0x20);
+    header[1] = ',';
+
+    // Replace header
+    memmove(&characters[headerIndex], &characters[index], messageSize - index);
+    memcpy(characters, header, headerIndex);
+    return headerIndex + messageSize - index;
+}
+
+/**
+ * @brief Begins a serial accessory stream. Any bytes of a previous stream that
+ * has not ended are written first.
+ * @param stream Stream.
+ * @param timestamp Timestamp of all messages of the stream.
+ */
+void Ximu3AsciiSerialAccessoryBegin(Ximu3AsciiSerialAccessoryStream * const stream, const uint64_t timestamp) {
+    Ximu3AsciiSerialAccessoryEnd(stream);
+    stream->timestamp = timestamp;
+    stream->started = true;
+    StreamHeader(stream);
+}
+
+/**
+ * @brief Appends payload bytes to a serial accessory stream. The bytes are
+ * ignored if the stream has not begun.
+ * @param stream Stream.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+void Ximu3AsciiSerialAccessoryAppend(Ximu3AsciiSerialAccessoryStream * const stream, const void* const data, const size_t numberOfBytes) {
+    if (stream->started == false) {
+        return;
+    }
+    const size_t maximumNumberOfBytes = StreamMaximumNumberOfBytes(stream->maximumNumberOfBytes);
+    const char* characters = data;
+    size_t remaining = numberOfBytes;
+    while (remaining > 0) {
+        const size_t available = maximumNumberOfBytes - stream->numberOfBytes;
+        const size_t count = remaining < available ? remaining : available;
+        WriteCharacters(stream->buffer, sizeof (stream->buffer), &stream->index, characters, count);
+        stream->numberOfBytes += count;
+        characters += count;
+        remaining -= count;
+        if (stream->numberOfBytes == maximumNumberOfBytes) {
+            StreamFlush(stream);
+        }
+    }
+}
+
+/**
+ * @brief Ends a serial accessory stream. Any bytes not yet written are written
+ * as a final message.
+ * @param stream Stream.
+ */
+void Ximu3AsciiSerialAccessoryEnd(Ximu3AsciiSerialAccessoryStream * const stream) {
+    if (stream->started == false) {
+        return;
+    }
+    if (stream->numberOfBytes > 0) {
+        StreamFlush(stream);
+    }
+    stream->started = false;
+}
+
+/**
+ * @brief Returns the maximum number of payload bytes per serial accessory
+ * stream message.
+ * @param maximumNumberOfBytes Maximum number of bytes of the stream.
+ * @return Maximum number of payload bytes per message.
+ */
+static inline size_t StreamMaximumNumberOfBytes(const size_t maximumNumberOfBytes) {
+    if ((maximumNumberOfBytes == 0) || (maximumNumberOfBytes > XIMU3_SIZE_CHAR_ARRAY)) {
+        return XIMU3_SIZE_CHAR_ARRAY;
+    }
+    return maximumNumberOfBytes;
+}
+
+/**
+ * @brief Writes the serial accessory stream message and begins the next
+ * message with the same timestamp.
+ * @param stream Stream.
+ */
+static void StreamFlush(Ximu3AsciiSerialAccessoryStream * const stream) {
+    WriteTermination(stream->buffer, sizeof (stream->buffer), &stream->index);
+    stream->write(stream->buffer, stream->index, stream->context);
+    StreamHeader(stream);
+}
+
+/**
+ * @brief Writes the header and payload separator of the next serial accessory
+ * stream message.
+ * @param stream Stream.
+ */
+static void StreamHeader(Ximu3AsciiSerialAccessoryStream * const stream) {
+    stream->index = 0;
+    stream->numberOfBytes = 0;
+    WriteHeader(stream->buffer, sizeof (stream->buffer), &stream->index, XIMU3_ASCII_ID_SERIAL_ACCESSORY, stream->timestamp);
+    WriteChar(stream->buffer, sizeof (stream->buffer), &stream->index, ',');
+}
+
+/**
+ * @brief Writes consecutive ASCII data messages described by a descriptor. Only
+ * complete messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param descriptor Descriptor.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param messageSize Largest possible message size.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+static size_t Batch(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data, const size_t numberOfMessages, const size_t messageSize, size_t * const numberOfMessagesWritten) {
+    const uint8_t* members = data;
+    uint8_t message[XIMU3_SIZE_ASCII_SERIAL_ACCESSORY]; // largest message of any data type
+    size_t destinationIndex = 0;
+    size_t index = 0;
+    for (; index < numberOfMessages; index++) {
+        void* const messageDestination = BatchDestination(destination, destinationSize, destinationIndex, message, messageSize);
+        if (BatchCommit(destination, destinationSize, &destinationIndex, messageDestination, Ximu3AsciiMessage(messageDestination, messageSize, descriptor, members)) == false) {
+            break;
+        }
+        members += descriptor->size;
+    }
+    if (numberOfMessagesWritten != NULL) {
+        *numberOfMessagesWritten = index;
+    }
+    return destinationIndex;
+}
+
+/**
+ * @brief Returns the destination for the next message of a batch. This is the
+ * batch destination if there is space for the largest possible message,
+ * otherwise the message buffer.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param destinationIndex Destination index.
+ * @param message Message buffer.
+ * @param messageSize Message buffer size.
+ * @return Destination for the next message.
+ */
+static inline void* BatchDestination(void* const destination, const size_t destinationSize, const size_t destinationIndex, void* const message, const size_t messageSize) {
+    if ((destinationSize - destinationIndex) >= messageSize) {
+        return &((uint8_t*) destination)[destinationIndex];
+    }
+    return message;
+}
+
+/**
+ * @brief Commits the next message of a batch. A message written to the message
+ * buffer is copied to the batch destination if there is space.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param destinationIndex Destination index.
+ * @param message Message.
+ * @param messageSize Message size.
+ * @return True if the message was committed.
+ */
+static inline bool BatchCommit(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const void* const message, const size_t messageSize) {
+    uint8_t * const next = &((uint8_t*) destination)[*destinationIndex];
+    if (message != next) {
+        if (messageSize > (destinationSize - *destinationIndex)) {
+            return false;
+        }
+        memcpy(next, message, messageSize);
+    }
+    *destinationIndex += messageSize;
+    return true;
+}
+
+/**
+ * @brief Writes a message with an interned string. The string is written as
+ * "#index=string" if the string is not yet in the table, otherwise as
+ * "#index", preceded by XIMU3_INTERN_ASCII_MARKER. The string is only added to
+ * the table if the message is complete.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param asciiId ASCII data message ID.
+ * @param timestamp Timestamp.
+ * @param string String.
+ * @param intern Intern table.
+ * @return Message size. 0 if the string cannot be interned.
+ */
+static size_t WriteInterned(void* const destination, const size_t destinationSize, const char asciiId, const uint64_t timestamp, const char* const string, Ximu3Intern * const intern) {
+    int index = Ximu3InternFind(intern, string);
+    const bool definition = index < 0;
+    if (definition) {
+        index = Ximu3InternNext(intern, string);
+        if (index < 0) {
+            return 0;
+        }
+    }
     size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_ERROR, data->timestamp);
-    WriteString(destination, destinationSize, &destinationIndex, data->error);
+    WriteHeader(destination, destinationSize, &destinationIndex, asciiId, timestamp);
+    WriteChar(destination, destinationSize, &destinationIndex, ',');
+    if (destinationIndex < destinationSize) {
+        ((char*) destination)[destinationIndex++] = XIMU3_INTERN_ASCII_MARKER; // not replaced by WriteChar
+    }
+    WriteChar(destination, destinationSize, &destinationIndex, '#');
+    if (index >= 100) {
+        WriteChar(destination, destinationSize, &destinationIndex, (char) ('0' + (index / 100)));
+    }
+    if (index >= 10) {
+        WriteChar(destination, destinationSize, &destinationIndex, (char) ('0' + ((index / 10) % 10)));
+    }
+    WriteChar(destination, destinationSize, &destinationIndex, (char) ('0' + (index % 10)));
+    if (definition) {
+        WriteChar(destination, destinationSize, &destinationIndex, '=');
+        WriteCharacters(destination, destinationSize, &destinationIndex, string, strlen(string));
+        if (destinationIndex < destinationSize) {
+            Ximu3InternAdd(intern, string);
+        }
+    }
     WriteTermination(destination, destinationSize, &destinationIndex);
     return destinationIndex;
 }
@@ -344,78 +1079,269 @@ size_t Ximu3AsciiError(void* const destination, const size_t destinationSize, co
  * @param timestamp Timestamp.
  */
 static inline void WriteHeader(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char asciiId, const uint64_t timestamp) {
+    char header[2 + 20]; // ID, comma, and timestamp, UINT64_MAX is 20 digits
+    const size_t numberOfDigits = FormatUint64(&header[sizeof (header)], timestamp);
+    char* const start = &header[sizeof (header) - numberOfDigits - 2];
+    start[0] = Printable(asciiId);
+    start[1] = ',';
+    WriteDigits(destination, destinationSize, destinationIndex, start, 2 + numberOfDigits);
+}
 
-    // ID
-    WriteChar(destination, destinationSize, destinationIndex, asciiId);
-    WriteChar(destination, destinationSize, destinationIndex, ',');
+/**
+ * @brief Returns true if the field is written as a float.
+ * @param field Field.
+ * @return True if the field is written as a float.
+ */
+static inline bool IsFloatField(const Ximu3DescriptorField * const field) {
+    return (field->type == Ximu3DescriptorFieldTypeFloat) || (field->type == Ximu3DescriptorFieldTypeBool);
+}
 
-    // Timestamp
-    if (timestamp == 0) {
-        WriteChar(destination, destinationSize, destinationIndex, '0');
-        return;
-    }
-    char reversed[20];
-    int length = 0;
-    uint64_t quotient = timestamp;
-    while (quotient > 0) {
-        reversed[length++] = '0' + (char) (quotient % 10); // index will never exceed 19 because UINT64_MAX is 20 digits
-        quotient /= 10;
+/**
+ * @brief Returns the number of consecutive float fields stored contiguously in
+ * the data structure.
+ * @param descriptor Descriptor.
+ * @param index Index of the first field.
+ * @return Number of fields.
+ */
+static inline size_t NumberOfContiguousFloats(const Ximu3Descriptor * const descriptor, const size_t index) {
+    const Ximu3DescriptorField * const fields = &descriptor->fields[index];
+    size_t numberOfFields = 0;
+    while (((index + numberOfFields) < descriptor->numberOfFields) && (fields[numberOfFields].type == Ximu3DescriptorFieldTypeFloat) && (fields[numberOfFields].offset == (fields[0].offset + (numberOfFields * sizeof (float))))) {
+        numberOfFields++;
     }
-    while (--length >= 0) {
-        WriteChar(destination, destinationSize, destinationIndex, reversed[length]);
+    return numberOfFields;
+}
+
+/**
+ * @brief Writes an array of at least FLOAT_DIGITS_BLOCK floats as blocks.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param values Values.
+ * @param numberOfValues Number of values.
+ * @param precision Number of decimal places.
+ */
+static void WriteFloatArray(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float* const values, const size_t numberOfValues, const int precision) {
+    size_t valueIndex = 0;
+    while (valueIndex < numberOfValues) {
+        const size_t blockIndex = (numberOfValues - valueIndex) < FLOAT_DIGITS_BLOCK ? numberOfValues - FLOAT_DIGITS_BLOCK : valueIndex; // last block overlaps the previous block
+        WriteFloats(destination, destinationSize, destinationIndex, &values[blockIndex], valueIndex - blockIndex, precision);
+        valueIndex = blockIndex + FLOAT_DIGITS_BLOCK;
     }
 }
 
 /**
- * @brief Writes a float.
+ * @brief Writes a block of floats. Each value is limited to the largest
+ * magnitude that can be written with 6 integer digits. Each value is copied as
+ * 16 bytes if the destination is large enough, so bytes after the message may
+ * be overwritten within the destination size.
  * @param destination Destination.
  * @param destinationIndex Destination index.
- * @param value Value.
+ * @param values Block of values.
+ * @param firstValue Index of the first value written. Values before this
+ * index are converted but not written.
+ * @param precision Number of decimal places.
  */
-static inline void WriteFloat(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value) {
+static void WriteFloats(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float values[FLOAT_DIGITS_BLOCK], const size_t firstValue, const int precision) {
+    FloatDigits digits;
+    ConvertFloats(values, &digits, precision);
+    const size_t numberOfCharacters = precision == 0 ? 0 : 1 + (size_t) precision; // point and fractional digits
+    for (size_t index = firstValue; index < FLOAT_DIGITS_BLOCK; index++) {
+        char characters[2 + 6 + 1 + 6 + 7]; // comma and sign before the integer digits, padded to copy 16 bytes at a time
+        memset(&characters[15], 0, sizeof (characters) - 15); // padding copied after the message
+        memcpy(&characters[2], &digitPairs[2 * digits.pairs[0][index]], 2);
+        memcpy(&characters[4], &digitPairs[2 * digits.pairs[1][index]], 2);
+        memcpy(&characters[6], &digitPairs[2 * digits.pairs[2][index]], 2);
+        characters[8] = '.';
+        memcpy(&characters[9], &digitPairs[2 * digits.pairs[3][index]], 2);
+        memcpy(&characters[11], &digitPairs[2 * digits.pairs[4][index]], 2);
+        memcpy(&characters[13], &digitPairs[2 * digits.pairs[5][index]], 2);
+        const size_t numberOfDigits = (size_t) digits.numberOfDigits[index];
+        const size_t sign = digits.negative[index] != 0 ? 1 : 0;
+        characters[8 - numberOfDigits - 1] = '-';
+        char* const start = &characters[8 - numberOfDigits - 1 - sign];
+        start[0] = ','; // overwrites the sign if not negative
+        const size_t numberOfBytes = 1 + sign + numberOfDigits + numberOfCharacters;
+        if ((*destinationIndex <= destinationSize) && ((destinationSize - *destinationIndex) >= 16)) {
+            memcpy(&((char*) destination)[*destinationIndex], start, 16);
+            *destinationIndex += numberOfBytes;
+            continue;
+        }
+        WriteDigits(destination, destinationSize, destinationIndex, start, numberOfBytes);
+    }
+}
+
+/**
+ * @brief Converts a block of floats to digits. The fractional part is rounded
+ * from the exact product of the fraction and the scale, as a double where
+ * SSE2 or NEON is available and as a 64-bit integer otherwise. Vector digits
+ * are calculated as floats because every intermediate value is an integer less
+ * than 2^24, so the results are identical to integer division.
+ * @param values Values.
+ * @param digits Digits.
+ * @param precision Number of decimal places.
+ */
+static inline void ConvertFloats(const float* const values, FloatDigits * const digits, const int precision) {
+#if defined(FLOAT_DIGITS_SSE2)
+    const __m128 value = _mm_loadu_ps(values);
+    const __m128 absolute = _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+    const __m128 inRange = _mm_cmplt_ps(absolute, _mm_set1_ps(1000000.0f)); // false if NaN
+    const __m128 limited = _mm_and_ps(absolute, inRange);
+
+    // Integer and fractional parts
+    __m128i integer = _mm_cvttps_epi32(limited);
+    const __m128 fractionalPart = _mm_sub_ps(limited, _mm_cvtepi32_ps(integer));
+    const __m128d scale = _mm_set1_pd((double) powersOfTen[precision]);
+    const __m128d half = _mm_set1_pd(0.5);
+    const __m128i low = _mm_cvttpd_epi32(_mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(fractionalPart), scale), half));
+    const __m128i high = _mm_cvttpd_epi32(_mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(fractionalPart, fractionalPart)), scale), half));
+    __m128i fraction = _mm_unpacklo_epi64(low, high);
+    const __m128i maximumFraction = _mm_set1_epi32((int32_t) powersOfTen[precision] - 1);
+    const __m128i carry = _mm_cmpgt_epi32(fraction, maximumFraction); // fractional part rounded up to 1
+    integer = _mm_sub_epi32(integer, carry);
+    fraction = _mm_andnot_si128(carry, fraction);
 
     // Limits
-    if (value >= 999999.9999f) {
-        WriteString(destination, destinationSize, destinationIndex, "999999.9999");
-        return;
-    }
-    if (value <= -999999.9999f) {
-        WriteString(destination, destinationSize, destinationIndex, "-999999.9999");
-        return;
+    const __m128i maximumInteger = _mm_set1_epi32(999999);
+    const __m128i limit = _mm_or_si128(_mm_cmpeq_epi32(_mm_castps_si128(inRange), _mm_setzero_si128()), _mm_cmpgt_epi32(integer, maximumInteger));
+    integer = _mm_or_si128(_mm_and_si128(limit, maximumInteger), _mm_andnot_si128(limit, integer));
+    fraction = _mm_or_si128(_mm_and_si128(limit, maximumFraction), _mm_andnot_si128(limit, fraction));
+
+    // Digits
+    __m128i numberOfDigits = _mm_set1_epi32(1);
+    numberOfDigits = _mm_sub_epi32(numberOfDigits, _mm_cmpgt_epi32(integer, _mm_set1_epi32(9)));
+    numberOfDigits = _mm_sub_epi32(numberOfDigits, _mm_cmpgt_epi32(integer, _mm_set1_epi32(99)));
+    numberOfDigits = _mm_sub_epi32(numberOfDigits, _mm_cmpgt_epi32(integer, _mm_set1_epi32(999)));
+    numberOfDigits = _mm_sub_epi32(numberOfDigits, _mm_cmpgt_epi32(integer, _mm_set1_epi32(9999)));
+    numberOfDigits = _mm_sub_epi32(numberOfDigits, _mm_cmpgt_epi32(integer, _mm_set1_epi32(99999)));
+    const __m128 hundredth = _mm_set1_ps(0.01f);
+    const __m128 hundred = _mm_set1_ps(100.0f);
+    const __m128 roundingOffset = _mm_set1_ps(0.5f);
+    const __m128 numbers[2] = {
+        _mm_cvtepi32_ps(integer),
+        _mm_mul_ps(_mm_cvtepi32_ps(fraction), _mm_set1_ps((float) powersOfTen[XIMU3_ASCII_PRECISION_MAX - precision])),
+    };
+    for (int index = 0; index < 2; index++) {
+        const __m128 hundreds = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(numbers[index], roundingOffset), hundredth)));
+        const __m128 tenThousands = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(hundreds, roundingOffset), hundredth)));
+        _mm_storeu_si128((__m128i*) digits->pairs[(3 * index) + 0], _mm_cvttps_epi32(tenThousands));
+        _mm_storeu_si128((__m128i*) digits->pairs[(3 * index) + 1], _mm_cvttps_epi32(_mm_sub_ps(hundreds, _mm_mul_ps(tenThousands, hundred))));
+        _mm_storeu_si128((__m128i*) digits->pairs[(3 * index) + 2], _mm_cvttps_epi32(_mm_sub_ps(numbers[index], _mm_mul_ps(hundreds, hundred))));
     }
-    WriteChar(destination, destinationSize, destinationIndex, ',');
+    _mm_storeu_si128((__m128i*) digits->negative, _mm_castps_si128(_mm_cmplt_ps(value, _mm_setzero_ps())));
+    _mm_storeu_si128((__m128i*) digits->numberOfDigits, numberOfDigits);
+#elif defined(FLOAT_DIGITS_NEON)
+    const float32x4_t value = vld1q_f32(values);
+    const float32x4_t absolute = vabsq_f32(value);
+    const uint32x4_t inRange = vcltq_f32(absolute, vdupq_n_f32(1000000.0f)); // false if NaN
+    const float32x4_t limited = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(absolute), inRange));
+
+    // Integer and fractional parts
+    int32x4_t integer = vcvtq_s32_f32(limited);
+    const float32x4_t fractionalPart = vsubq_f32(limited, vcvtq_f32_s32(integer));
+    const float64x2_t scale = vdupq_n_f64((double) powersOfTen[precision]);
+    const float64x2_t half = vdupq_n_f64(0.5);
+    const int64x2_t low = vcvtq_s64_f64(vaddq_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(fractionalPart)), scale), half));
+    const int64x2_t high = vcvtq_s64_f64(vaddq_f64(vmulq_f64(vcvt_high_f64_f32(fractionalPart), scale), half));
+    int32x4_t fraction = vcombine_s32(vmovn_s64(low), vmovn_s64(high));
+    const int32x4_t maximumFraction = vdupq_n_s32((int32_t) powersOfTen[precision] - 1);
+    const uint32x4_t carry = vcgtq_s32(fraction, maximumFraction); // fractional part rounded up to 1
+    integer = vsubq_s32(integer, vreinterpretq_s32_u32(carry));
+    fraction = vbicq_s32(fraction, vreinterpretq_s32_u32(carry));
+
+    // Limits
+    const int32x4_t maximumInteger = vdupq_n_s32(999999);
+    const uint32x4_t limit = vorrq_u32(vmvnq_u32(inRange), vcgtq_s32(integer, maximumInteger));
+    integer = vbslq_s32(limit, maximumInteger, integer);
+    fraction = vbslq_s32(limit, maximumFraction, fraction);
 
-    // Sign
-    float absolute = value;
-    if (value < 0.0f) {
-        WriteChar(destination, destinationSize, destinationIndex, '-');
-        absolute = -value;
+    // Digits
+    int32x4_t numberOfDigits = vdupq_n_s32(1);
+    numberOfDigits = vsubq_s32(numberOfDigits, vreinterpretq_s32_u32(vcgtq_s32(integer, vdupq_n_s32(9))));
+    numberOfDigits = vsubq_s32(numberOfDigits, vreinterpretq_s32_u32(vcgtq_s32(integer, vdupq_n_s32(99))));
+    numberOfDigits = vsubq_s32(numberOfDigits, vreinterpretq_s32_u32(vcgtq_s32(integer, vdupq_n_s32(999))));
+    numberOfDigits = vsubq_s32(numberOfDigits, vreinterpretq_s32_u32(vcgtq_s32(integer, vdupq_n_s32(9999))));
+    numberOfDigits = vsubq_s32(numberOfDigits, vreinterpretq_s32_u32(vcgtq_s32(integer, vdupq_n_s32(99999))));
+    const float32x4_t hundredth = vdupq_n_f32(0.01f);
+    const float32x4_t hundred = vdupq_n_f32(100.0f);
+    const float32x4_t roundingOffset = vdupq_n_f32(0.5f);
+    const float32x4_t numbers[2] = {
+        vcvtq_f32_s32(integer),
+        vmulq_f32(vcvtq_f32_s32(fraction), vdupq_n_f32((float) powersOfTen[XIMU3_ASCII_PRECISION_MAX - precision])),
+    };
+    for (int index = 0; index < 2; index++) {
+        const float32x4_t hundreds = vcvtq_f32_s32(vcvtq_s32_f32(vmulq_f32(vaddq_f32(numbers[index], roundingOffset), hundredth)));
+        const float32x4_t tenThousands = vcvtq_f32_s32(vcvtq_s32_f32(vmulq_f32(vaddq_f32(hundreds, roundingOffset), hundredth)));
+        vst1q_s32(digits->pairs[(3 * index) + 0], vcvtq_s32_f32(tenThousands));
+        vst1q_s32(digits->pairs[(3 * index) + 1], vcvtq_s32_f32(vsubq_f32(hundreds, vmulq_f32(tenThousands, hundred))));
+        vst1q_s32(digits->pairs[(3 * index) + 2], vcvtq_s32_f32(vsubq_f32(numbers[index], vmulq_f32(hundreds, hundred))));
     }
+    vst1q_s32(digits->negative, vreinterpretq_s32_u32(vcltq_f32(value, vdupq_n_f32(0.0f))));
+    vst1q_s32(digits->numberOfDigits, numberOfDigits);
+#else
+    const uint32_t scale = powersOfTen[precision];
+    for (int index = 0; index < FLOAT_DIGITS_BLOCK; index++) {
 
-    // Integer part
-    const uint32_t integer = (uint32_t) absolute;
-    if (integer == 0) {
-        WriteChar(destination, destinationSize, destinationIndex, '0');
-    } else {
-        char reversed[6];
-        int length = 0;
-        uint32_t quotient = integer;
-        while (quotient > 0) {
-            reversed[length++] = '0' + (char) (quotient % 10); // index will never exceed 5 because integer is limited to 999999
-            quotient /= 10;
+        // Sign
+        const float value = values[index];
+        const float absolute = value < 0.0f ? -value : value;
+        digits->negative[index] = value < 0.0f;
+
+        // Integer and fractional parts
+        uint32_t integer = 1000000;
+        uint32_t fraction = 0;
+        if (absolute < 1000000.0f) {
+            integer = (uint32_t) absolute;
+            fraction = RoundFraction(absolute - (float) integer, scale);
+            if (fraction >= scale) {
+                integer++; // fractional part rounded up to 1
+                fraction = 0;
+            }
+        }
+
+        // Limits
+        if (integer > 999999) {
+            integer = 999999;
+            fraction = scale - 1;
         }
-        while (--length >= 0) {
-            WriteChar(destination, destinationSize, destinationIndex, reversed[length]);
+
+        // Digits
+        int32_t numberOfDigits = 1;
+        for (int power = 1; power < 6; power++) {
+            numberOfDigits += integer >= powersOfTen[power];
         }
+        digits->numberOfDigits[index] = numberOfDigits;
+        fraction *= powersOfTen[XIMU3_ASCII_PRECISION_MAX - precision];
+        digits->pairs[0][index] = (int32_t) (integer / 10000);
+        digits->pairs[1][index] = (int32_t) ((integer / 100) % 100);
+        digits->pairs[2][index] = (int32_t) (integer % 100);
+        digits->pairs[3][index] = (int32_t) (fraction / 10000);
+        digits->pairs[4][index] = (int32_t) ((fraction / 100) % 100);
+        digits->pairs[5][index] = (int32_t) (fraction % 100);
     }
+#endif
+}
 
-    // Fractional part
-    const uint32_t fraction = (uint32_t) (((absolute - (float) integer) * 10000.0f) + 0.5f);
-    WriteChar(destination, destinationSize, destinationIndex, '.');
-    WriteChar(destination, destinationSize, destinationIndex, '0' + (char) (fraction / 1000));
-    WriteChar(destination, destinationSize, destinationIndex, '0' + (char) ((fraction / 100) % 10));
-    WriteChar(destination, destinationSize, destinationIndex, '0' + (char) ((fraction / 10) % 10));
-    WriteChar(destination, destinationSize, destinationIndex, '0' + (char) (fraction % 10));
+/**
+ * @brief Rounds a fractional part multiplied by a scale to the nearest
+ * integer. The float is decoded so that the product is exact, multiplying as a
+ * float would round values close to half-way in the wrong direction.
+ * @param fraction Fractional part between 0 and 1.
+ * @param scale Scale.
+ * @return Rounded product.
+ */
+static inline uint32_t RoundFraction(const float fraction, const uint32_t scale) {
+    uint32_t bits;
+    memcpy(&bits, &fraction, sizeof (bits));
+    const int exponent = (int) ((bits >> 23) & 0xFF);
+    if (exponent == 0) {
+        return 0; // zero or subnormal
+    }
+    const int shift = 150 - exponent; // fraction is mantissa * 2^-shift
+    if (shift >= 64) {
+        return 0;
+    }
+    const uint64_t mantissa = (bits & 0x7FFFFF) | 0x800000;
+    return (uint32_t) (((mantissa * scale) + (UINT64_C(1) << (shift - 1))) >> shift);
 }
 
 /**
@@ -426,8 +1352,41 @@ static inline void WriteFloat(void* const destination, const size_t destinationS
  */
 static inline void WriteString(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* string) {
     WriteChar(destination, destinationSize, destinationIndex, ',');
-    while (*string != '\0') {
-        WriteChar(destination, destinationSize, destinationIndex, *string++);
+    if (string == NULL) {
+        return;
+    }
+    WriteCharacters(destination, destinationSize, destinationIndex, string, strlen(string));
+}
+
+/**
+ * @brief Writes bytes. Non-printable characters are replaced.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param bytes Bytes.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline void WriteBytes(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t* bytes, const size_t numberOfBytes) {
+    WriteChar(destination, destinationSize, destinationIndex, ',');
+    WriteCharacters(destination, destinationSize, destinationIndex, (const char*) bytes, numberOfBytes);
+}
+
+/**
+ * @brief Writes characters. Non-printable characters are replaced. The
+ * destination size is checked once if the destination is large enough for all
+ * characters, otherwise for each character.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param characters Characters.
+ * @param numberOfCharacters Number of characters.
+ */
+static inline void WriteCharacters(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* const characters, const size_t numberOfCharacters) {
+    if ((*destinationIndex <= destinationSize) && (numberOfCharacters <= (destinationSize - *destinationIndex))) {
+        Ximu3PrintableCopy(&((char*) destination)[*destinationIndex], characters, numberOfCharacters);
+        *destinationIndex += numberOfCharacters;
+        return;
+    }
+    for (size_t index = 0; index < numberOfCharacters; index++) {
+        WriteChar(destination, destinationSize, destinationIndex, characters[index]);
     }
 }
 
@@ -446,6 +1405,86 @@ static inline void WriteTermination(void* const destination, const size_t destin
     ((char*) destination)[(*destinationIndex)++] = XIMU3_TERMINATION;
 }
 
+/**
+ * @brief Writes digits. The digits are copied in one operation if the
+ * destination is large enough.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param digits Digits.
+ * @param numberOfDigits Number of digits.
+ */
+static inline void WriteDigits(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* const digits, const size_t numberOfDigits) {
+    if ((*destinationIndex <= destinationSize) && (numberOfDigits <= (destinationSize - *destinationIndex))) {
+        memcpy(&((char*) destination)[*destinationIndex], digits, numberOfDigits);
+        *destinationIndex += numberOfDigits;
+        return;
+    }
+    for (size_t index = 0; index < numberOfDigits; index++) {
+        WriteChar(destination, destinationSize, destinationIndex, digits[index]);
+    }
+}
+
+/**
+ * @brief Formats a 64-bit unsigned integer as decimal digits ending at the
+ * specified address. Values that do not fit 32 bits are divided by 10000
+ * using 32-bit division only, because 64-bit division is a library call on
+ * 32-bit processors.
+ * @param end Address after the last digit.
+ * @param value Value.
+ * @return Number of digits.
+ */
+static inline size_t FormatUint64(char* const end, uint64_t value) {
+    size_t numberOfDigits = 0;
+    while (value > UINT32_MAX) {
+        const uint32_t remainder = DivideBy10000(&value);
+        memcpy(end - numberOfDigits - 2, &digitPairs[2 * (remainder % 100)], 2);
+        memcpy(end - numberOfDigits - 4, &digitPairs[2 * (remainder / 100)], 2);
+        numberOfDigits += 4;
+    }
+    return numberOfDigits + FormatUint32(end - numberOfDigits, (uint32_t) value);
+}
+
+/**
+ * @brief Formats a 32-bit unsigned integer as decimal digits ending at the
+ * specified address. Two digits are written at a time.
+ * @param end Address after the last digit.
+ * @param value Value.
+ * @return Number of digits.
+ */
+static inline size_t FormatUint32(char* const end, uint32_t value) {
+    char* digits = end;
+    while (value >= 100) {
+        digits -= 2;
+        memcpy(digits, &digitPairs[2 * (value % 100)], 2);
+        value /= 100;
+    }
+    if (value >= 10) {
+        digits -= 2;
+        memcpy(digits, &digitPairs[2 * value], 2);
+    } else {
+        *--digits = '0' + (char) value;
+    }
+    return (size_t) (end - digits);
+}
+
+/**
+ * @brief Divides a 64-bit unsigned integer by 10000 as long division of 16-bit
+ * digits. Each partial dividend is less than 10000 * 2^16 and so fits 32 bits.
+ * @param value Value.
+ * @return Remainder.
+ */
+static inline uint32_t DivideBy10000(uint64_t * const value) {
+    uint64_t quotient = 0;
+    uint32_t remainder = 0;
+    for (int shift = 48; shift >= 0; shift -= 16) {
+        const uint32_t dividend = (remainder << 16) | (uint32_t) ((*value >> shift) & 0xFFFF);
+        quotient |= (uint64_t) (dividend / 10000) << shift;
+        remainder = dividend % 10000;
+    }
+    *value = quotient;
+    return remainder;
+}
+
 /**
  * @brief Writes a character.
  * @param destination Destination.
@@ -456,11 +1495,19 @@ static inline void WriteChar(void* const destination, const size_t destinationSi
     if (*destinationIndex >= destinationSize) {
         return;
     }
+    ((char*) destination)[(*destinationIndex)++] = Printable(character);
+}
+
+/**
+ * @brief Returns the character if printable, otherwise '?'.
+ * @param character Character.
+ * @return Printable character.
+ */
+static inline char Printable(const char character) {
     if (((unsigned char) character < 0x20) || ((unsigned char) character > 0x7E)) {
-        ((char*) destination)[(*destinationIndex)++] = '?';
-        return;
+        return '?';
     }
-    ((char*) destination)[(*destinationIndex)++] = character;
+    return character;
 }
 
 //------------------------------------------------------------------------------
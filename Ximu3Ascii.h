@@ -1,7 +1,8 @@
 /**
  * @file Ximu3Ascii.h
  * @author Seb Madgwick
- * @brief x-IMU3 ASCII data messages.
+ * @brief x-IMU3 ASCII data messages. Floats are written in blocks, so an
+ * encoder may write bytes after the message up to the destination size.
  */
 
 #ifndef XIMU3_ASCII_H
@@ -10,8 +11,14 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include "Ximu3CompactTimestamp.h"
 #include "Ximu3Data.h"
+#include "Ximu3Descriptor.h"
+#include "Ximu3Intern.h"
+#include "Ximu3Size.h"
 
 //------------------------------------------------------------------------------
 // Definitions
@@ -48,9 +55,38 @@
 #define XIMU3_ASCII_ID_NOTIFICATION         'N'
 #define XIMU3_ASCII_ID_ERROR                'F'
 
+// Binary only
+#define XIMU3_ASCII_ID_AGGREGATE            'V'
+#define XIMU3_ASCII_ID_COMPOSITE            'X'
+#define XIMU3_ASCII_ID_COMPRESSED           'Z'
+
+// Precision
+#define XIMU3_ASCII_PRECISION_DEFAULT       4
+#define XIMU3_ASCII_PRECISION_MAX           6
+
+/**
+ * @brief Serial accessory stream. Payload bytes are appended as they are
+ * received, e.g. from a UART DMA ring, and are copied directly into the
+ * message with non-printable characters replaced. The message is passed to the
+ * write callback when the maximum number of bytes is reached, and the
+ * remaining bytes start a new message with the same timestamp.
+ */
+typedef struct {
+    size_t maximumNumberOfBytes; // payload bytes per message, 0 for XIMU3_SIZE_CHAR_ARRAY
+    void (*const write) (const void* const data, const size_t numberOfBytes, void* const context);
+    void* context;
+    char buffer[XIMU3_SIZE_ASCII_SERIAL_ACCESSORY]; // private
+    size_t index; // private
+    size_t numberOfBytes; // private
+    uint64_t timestamp; // private
+    bool started; // private
+} Ximu3AsciiSerialAccessoryStream;
+
 //------------------------------------------------------------------------------
 // Function declarations
 
+size_t Ximu3AsciiMessage(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data);
+size_t Ximu3AsciiMessagePrecision(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data, const int precision);
 size_t Ximu3AsciiInertial(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data);
 size_t Ximu3AsciiMagnetometer(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data);
 size_t Ximu3AsciiHighGAccelerometer(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data);
@@ -69,6 +105,41 @@ size_t Ximu3AsciiRssi(void* const destination, const size_t destinationSize, con
 size_t Ximu3AsciiButton(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data);
 size_t Ximu3AsciiNotification(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data);
 size_t Ximu3AsciiError(void* const destination, const size_t destinationSize, const Ximu3DataError * const data);
+size_t Ximu3AsciiInertialPrecision(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data, const int precision);
+size_t Ximu3AsciiMagnetometerPrecision(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data, const int precision);
+size_t Ximu3AsciiHighGAccelerometerPrecision(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data, const int precision);
+size_t Ximu3AsciiQuaternionPrecision(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const int precision);
+size_t Ximu3AsciiRotationMatrixPrecision(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data, const int precision);
+size_t Ximu3AsciiEulerAnglesPrecision(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data, const int precision);
+size_t Ximu3AsciiLinearAccelerationPrecision(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const int precision);
+size_t Ximu3AsciiEarthAccelerationPrecision(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const int precision);
+size_t Ximu3AsciiTemperaturePrecision(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data, const int precision);
+size_t Ximu3AsciiNotificationInterned(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data, Ximu3Intern * const intern);
+size_t Ximu3AsciiErrorInterned(void* const destination, const size_t destinationSize, const Ximu3DataError * const data, Ximu3Intern * const intern);
+size_t Ximu3AsciiFloats(void* const destination, const size_t destinationSize, const float* const values, const size_t numberOfValues, const int precision);
+size_t Ximu3AsciiUint64(void* const destination, const size_t destinationSize, const uint64_t value);
+size_t Ximu3AsciiCompactTimestamp(Ximu3CompactTimestamp * const compactTimestamp, void* const message, const size_t messageSize);
+size_t Ximu3AsciiInertialBatch(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiMagnetometerBatch(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiHighGAccelerometerBatch(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiQuaternionBatch(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiRotationMatrixBatch(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiEulerAnglesBatch(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiLinearAccelerationBatch(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiEarthAccelerationBatch(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiAhrsStatusBatch(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiSerialAccessoryBatch(void* const destination, const size_t destinationSize, const Ximu3DataSerialAccessory * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiSyncBatch(void* const destination, const size_t destinationSize, const Ximu3DataSync * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiLtcBatch(void* const destination, const size_t destinationSize, const Ximu3DataLtc * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiTemperatureBatch(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiBatteryBatch(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiRssiBatch(void* const destination, const size_t destinationSize, const Ximu3DataRssi * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiButtonBatch(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiNotificationBatch(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3AsciiErrorBatch(void* const destination, const size_t destinationSize, const Ximu3DataError * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+void Ximu3AsciiSerialAccessoryBegin(Ximu3AsciiSerialAccessoryStream * const stream, const uint64_t timestamp);
+void Ximu3AsciiSerialAccessoryAppend(Ximu3AsciiSerialAccessoryStream * const stream, const void* const data, const size_t numberOfBytes);
+void Ximu3AsciiSerialAccessoryEnd(Ximu3AsciiSerialAccessoryStream * const stream);
 
 #endif
 
@@ -0,0 +1,535 @@
+/**
+ * @file Ximu3AsciiParser.c
+ * @author Seb Madgwick
+ * @brief x-IMU3 ASCII data message parser.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "Ximu3Ascii.h"
+#include "Ximu3AsciiParser.h"
+#include "Ximu3CompactTimestamp.h"
+#include "Ximu3Definitions.h"
+#include "Ximu3Ltc.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+#define MAX_INTEGER_DIGITS  (9) /* at most 15 digits in total so that the mantissa is exact as a double */
+
+/**
+ * @brief Data structure of any data message.
+ */
+typedef union {
+    uint64_t timestamp;
+    Ximu3DataInertial inertial;
+    Ximu3DataMagnetometer magnetometer;
+    Ximu3DataHighGAccelerometer highGAccelerometer;
+    Ximu3DataQuaternion quaternion;
+    Ximu3DataRotationMatrix rotationMatrix;
+    Ximu3DataEulerAngles eulerAngles;
+    Ximu3DataLinearAcceleration linearAcceleration;
+    Ximu3DataEarthAcceleration earthAcceleration;
+    Ximu3DataAhrsStatus ahrsStatus;
+    Ximu3DataSerialAccessory serialAccessory;
+    Ximu3DataSync sync;
+    Ximu3DataLtc ltc;
+    Ximu3DataTemperature temperature;
+    Ximu3DataBattery battery;
+    Ximu3DataRssi rssi;
+    Ximu3DataButton button;
+    Ximu3DataNotification notification;
+    Ximu3DataError error;
+    uint8_t members[XIMU3_DESCRIPTOR_MAX_SIZE];
+} Data;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void Append(Ximu3AsciiParser * const parser, const char* const data, const size_t numberOfBytes);
+static void ParseMessage(Ximu3AsciiParser * const parser, const char* const message, size_t messageSize);
+static Ximu3Result ParseFields(Ximu3AsciiParser * const parser, const Ximu3Descriptor * const descriptor, const char* source, const char* const end, Data * const data);
+static Ximu3Result ParseString(Ximu3AsciiParser * const parser, const char asciiId, const char* const source, const char* const end, const char** const string, size_t * const length);
+static Ximu3Result ResolveInterned(Ximu3AsciiParser * const parser, const char* const source, const char* const end, const char** const string, size_t * const length);
+static void Callback(const Ximu3AsciiParser * const parser, const Ximu3Descriptor * const descriptor, Data * const data);
+static inline const char* ParseFloat(const char* source, const char* const end, float* const value);
+static inline const char* ParseUint64(const char* source, const char* const end, uint64_t * const value);
+static inline bool IsDigit(const char character);
+static void Error(const Ximu3AsciiParser * const parser, const char* const format, ...);
+
+//------------------------------------------------------------------------------
+// Variables
+
+/**
+ * @brief Powers of ten indexed by number of fractional digits.
+ */
+static const double powersOfTen[XIMU3_ASCII_PRECISION_MAX + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6};
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Processes received data. The data may be fragmented arbitrarily. A
+ * callback is called for each complete message. Complete messages are parsed
+ * directly from the data and only fragments are copied to the buffer.
+ * @param parser Parser.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+void Ximu3AsciiParserProcess(Ximu3AsciiParser * const parser, const void* const data, const size_t numberOfBytes) {
+    const char* source = data;
+    const char * const end = source + numberOfBytes;
+    while (source < end) {
+
+        // Receive bytes up to next termination
+        const char * const termination = memchr(source, XIMU3_TERMINATION, (size_t) (end - source));
+        if (termination == NULL) {
+            Append(parser, source, (size_t) (end - source));
+            return;
+        }
+
+        // Parse message
+        if ((parser->index == 0) && (parser->discard == false)) {
+            ParseMessage(parser, source, (size_t) (termination - source));
+        } else {
+            Append(parser, source, (size_t) (termination - source));
+            if (parser->discard) {
+                parser->timestampValid = false;
+            } else {
+                ParseMessage(parser, parser->buffer, parser->index);
+            }
+        }
+        source = termination + 1;
+        parser->index = 0;
+        parser->discard = false;
+    }
+}
+
+/**
+ * @brief Discards any partially received message, the previous timestamp and
+ * the interned strings. This should be called when the interface reconnects.
+ * @param parser Parser.
+ */
+void Ximu3AsciiParserReset(Ximu3AsciiParser * const parser) {
+    parser->index = 0;
+    parser->discard = false;
+    parser->timestampValid = false;
+    for (int index = 0; index < XIMU3_INTERN_NUMBER_OF_STRINGS; index++) {
+        parser->interned[index][0] = '\0';
+    }
+}
+
+/**
+ * @brief Appends received bytes to the buffer. The message is discarded until
+ * the next termination if the buffer overruns. One byte of the buffer is
+ * reserved for null-terminating strings.
+ * @param parser Parser.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+static void Append(Ximu3AsciiParser * const parser, const char* const data, const size_t numberOfBytes) {
+    if (parser->discard) {
+        return;
+    }
+    if (numberOfBytes > (sizeof (parser->buffer) - 1 - parser->index)) {
+        Error(parser, "ASCII parse error. Buffer overrun.");
+        parser->discard = true;
+        return;
+    }
+    memcpy(&parser->buffer[parser->index], data, numberOfBytes);
+    parser->index += numberOfBytes;
+}
+
+/**
+ * @brief Parses a message. The message is either in the buffer or in the
+ * received data. The timestamp of a compact message is the sum of the
+ * timestamp delta and the timestamp of the previous message. The previous
+ * timestamp is invalidated by any error so that a compact message is never
+ * parsed relative to a lost message.
+ * @param parser Parser.
+ * @param message Message excluding the termination.
+ * @param messageSize Message size.
+ */
+static void ParseMessage(Ximu3AsciiParser * const parser, const char* const message, size_t messageSize) {
+    if ((messageSize > 0) && (message[messageSize - 1] == '\r')) {
+        messageSize--;
+    }
+    if (messageSize == 0) {
+        return;
+    }
+    if (messageSize > (sizeof (parser->buffer) - 1)) {
+        Error(parser, "ASCII parse error. Buffer overrun.");
+        parser->timestampValid = false;
+        return;
+    }
+    const char id = message[0];
+    const bool compact = (id >= 'a') && (id <= 'z');
+    if ((messageSize < 2) || (message[1] != ',') || ((compact == false) && ((id < 'A') || (id > 'Z')) && (IsDigit(id) == false))) {
+        return; // not a data message, e.g. command response
+    }
+    const char asciiId = compact ? (char) (id & ~0x20) : id;
+    const Ximu3Descriptor * const descriptor = Ximu3DescriptorFind(asciiId);
+    if (descriptor == NULL) {
+        Error(parser, "ASCII parse error. Unknown message ID '%c'.", id);
+        parser->timestampValid = false;
+        return;
+    }
+    const char * const end = &message[messageSize];
+    uint64_t timestamp;
+    const char * const fields = ParseUint64(&message[2], end, &timestamp);
+    if (compact) {
+        if ((fields == NULL) || (timestamp > XIMU3_COMPACT_TIMESTAMP_MAX_DELTA)) {
+            Error(parser, "ASCII parse error. Invalid timestamp delta for ID '%c'.", id);
+            parser->timestampValid = false;
+            return;
+        }
+        if (parser->timestampValid == false) {
+            Error(parser, "ASCII parse error. No previous timestamp for ID '%c'.", id);
+            return;
+        }
+        timestamp += parser->timestamp;
+    } else if (fields == NULL) {
+        Error(parser, "ASCII parse error. Invalid timestamp for ID '%c'.", id);
+        parser->timestampValid = false;
+        return;
+    }
+    parser->timestamp = timestamp;
+    parser->timestampValid = true;
+    Data data;
+    memset(&data, 0, descriptor->size);
+    data.timestamp = timestamp;
+    if (ParseFields(parser, descriptor, fields, end, &data) != Ximu3ResultOk) {
+        Error(parser, "ASCII parse error. Invalid fields for ID '%c'.", id);
+        parser->timestampValid = false;
+        return;
+    }
+    Callback(parser, descriptor, &data);
+}
+
+/**
+ * @brief Parses the fields described by the descriptor. Each field is
+ * preceded by a comma. A string or bytes field is the remainder of the message
+ * and is copied to the buffer.
+ * @param parser Parser.
+ * @param descriptor Descriptor.
+ * @param source Source.
+ * @param end End of the message.
+ * @param data Data.
+ * @return Result.
+ */
+static Ximu3Result ParseFields(Ximu3AsciiParser * const parser, const Ximu3Descriptor * const descriptor, const char* source, const char* const end, Data * const data) {
+    for (size_t index = 0; index < descriptor->numberOfFields; index++) {
+        const Ximu3DescriptorField * const field = &descriptor->fields[index];
+        uint8_t * const member = &data->members[field->offset];
+        if ((source == end) || (*source != ',')) {
+            return Ximu3ResultError;
+        }
+        source++;
+        switch (field->type) {
+            case Ximu3DescriptorFieldTypeFloat:
+            case Ximu3DescriptorFieldTypeBool:
+            {
+                float value;
+                source = ParseFloat(source, end, &value);
+                if (source == NULL) {
+                    return Ximu3ResultError;
+                }
+                if (field->type == Ximu3DescriptorFieldTypeBool) {
+                    const bool state = value != 0.0f;
+                    memcpy(member, &state, sizeof (state));
+                } else {
+                    memcpy(member, &value, sizeof (value));
+                }
+                break;
+            }
+            case Ximu3DescriptorFieldTypeString:
+            case Ximu3DescriptorFieldTypeBytes:
+            {
+                const char* string;
+                size_t length;
+                if (ParseString(parser, descriptor->asciiId, source, end, &string, &length) != Ximu3ResultOk) {
+                    return Ximu3ResultError;
+                }
+                memcpy(member, &string, sizeof (string));
+                if (field->type == Ximu3DescriptorFieldTypeBytes) {
+                    memcpy(&data->members[field->numberOfBytesOffset], &length, sizeof (length));
+                }
+                source = end;
+                break;
+            }
+        }
+    }
+    return source == end ? Ximu3ResultOk : Ximu3ResultError;
+}
+
+/**
+ * @brief Copies the remainder of the message to the start of the buffer as a
+ * null-terminated string. An interned notification or error is replaced with
+ * the string.
+ * @param parser Parser.
+ * @param asciiId ASCII ID.
+ * @param source Source.
+ * @param end End of the message.
+ * @param string String.
+ * @param length String length.
+ * @return Result.
+ */
+static Ximu3Result ParseString(Ximu3AsciiParser * const parser, const char asciiId, const char* const source, const char* const end, const char** const string, size_t * const length) {
+    if (((asciiId == XIMU3_ASCII_ID_NOTIFICATION) || (asciiId == XIMU3_ASCII_ID_ERROR)) && ((end - source) >= 2) && (source[0] == XIMU3_INTERN_ASCII_MARKER) && (source[1] == '#')) {
+        const Ximu3Result result = ResolveInterned(parser, source + 1, end, string, length);
+        if ((result == Ximu3ResultOk) || (*string != NULL)) {
+            return result;
+        }
+    }
+    *length = (size_t) (end - source);
+    memmove(parser->buffer, source, *length);
+    parser->buffer[*length] = '\0';
+    *string = parser->buffer;
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Resolves an interned string written as "#index=string" or "#index"
+ * after XIMU3_INTERN_ASCII_MARKER. A definition adds the string to the table.
+ * @param parser Parser.
+ * @param source Source.
+ * @param end End of the message.
+ * @param string String. NULL if the source is not an interned string.
+ * @param length String length.
+ * @return Result.
+ */
+static Ximu3Result ResolveInterned(Ximu3AsciiParser * const parser, const char* const source, const char* const end, const char** const string, size_t * const length) {
+    *string = NULL;
+    size_t index = 0;
+    const char* character = source + 1;
+    while ((character < end) && IsDigit(*character) && ((character - source) <= 3)) {
+        index = (10 * index) + (size_t) (*character++ - '0');
+    }
+    if ((character == (source + 1)) || ((character < end) && (*character != '='))) {
+        return Ximu3ResultError;
+    }
+    *string = parser->buffer; // source is an interned string
+    if (index >= XIMU3_INTERN_NUMBER_OF_STRINGS) {
+        return Ximu3ResultError;
+    }
+    char * const interned = parser->interned[index];
+    if (character < end) {
+        const size_t definitionLength = (size_t) (end - character - 1);
+        if ((definitionLength == 0) || (definitionLength >= XIMU3_INTERN_STRING_SIZE)) {
+            return Ximu3ResultError;
+        }
+        memcpy(interned, character + 1, definitionLength);
+        interned[definitionLength] = '\0';
+    } else if (interned[0] == '\0') {
+        return Ximu3ResultError;
+    }
+    *length = strlen(interned);
+    memcpy(parser->buffer, interned, *length + 1);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Calls the callback of the message type.
+ * @param parser Parser.
+ * @param descriptor Descriptor.
+ * @param data Data.
+ */
+static void Callback(const Ximu3AsciiParser * const parser, const Ximu3Descriptor * const descriptor, Data * const data) {
+    switch (descriptor->asciiId) {
+        case XIMU3_ASCII_ID_INERTIAL:
+            if (parser->inertial != NULL) {
+                parser->inertial(&data->inertial, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_MAGNETOMETER:
+            if (parser->magnetometer != NULL) {
+                parser->magnetometer(&data->magnetometer, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER:
+            if (parser->highGAccelerometer != NULL) {
+                parser->highGAccelerometer(&data->highGAccelerometer, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_QUATERNION:
+            if (parser->quaternion != NULL) {
+                parser->quaternion(&data->quaternion, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_ROTATION_MATRIX:
+            if (parser->rotationMatrix != NULL) {
+                parser->rotationMatrix(&data->rotationMatrix, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_EULER_ANGLES:
+            if (parser->eulerAngles != NULL) {
+                parser->eulerAngles(&data->eulerAngles, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_LINEAR_ACCELERATION:
+            if (parser->linearAcceleration != NULL) {
+                parser->linearAcceleration(&data->linearAcceleration, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_EARTH_ACCELERATION:
+            if (parser->earthAcceleration != NULL) {
+                parser->earthAcceleration(&data->earthAcceleration, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_AHRS_STATUS:
+            if (parser->ahrsStatus != NULL) {
+                parser->ahrsStatus(&data->ahrsStatus, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_SERIAL_ACCESSORY:
+            if (parser->serialAccessory != NULL) {
+                parser->serialAccessory(&data->serialAccessory, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_SYNC:
+            if (parser->sync != NULL) {
+                parser->sync(&data->sync, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_LTC:
+            if (parser->ltc != NULL) {
+                Ximu3LtcPack(data->ltc.timecode, &data->ltc.packedTimecode); // packed timecode is 0 if the timecode is not valid
+                parser->ltc(&data->ltc, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_TEMPERATURE:
+            if (parser->temperature != NULL) {
+                parser->temperature(&data->temperature, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_BATTERY:
+            if (parser->battery != NULL) {
+                parser->battery(&data->battery, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_RSSI:
+            if (parser->rssi != NULL) {
+                parser->rssi(&data->rssi, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_BUTTON:
+            if (parser->button != NULL) {
+                parser->button(&data->button, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_NOTIFICATION:
+            if (parser->notification != NULL) {
+                parser->notification(&data->notification, parser->context);
+            }
+            return;
+        case XIMU3_ASCII_ID_ERROR:
+            if (parser->error != NULL) {
+                parser->error(&data->error, parser->context);
+            }
+            return;
+        default:
+            if (parser->custom != NULL) {
+                parser->custom(descriptor, data, parser->context);
+            }
+            return;
+    }
+}
+
+/**
+ * @brief Parses a number written as an optional sign, up to 9 integer digits
+ * and an optional point followed by up to XIMU3_ASCII_PRECISION_MAX
+ * fractional digits, e.g. "-999999.9999". The digits are accumulated as an
+ * integer mantissa that is exact as a double, so a single division by a power
+ * of ten gives the correctly rounded double of the number.
+ * @param source Source.
+ * @param end End of the message.
+ * @param value Value.
+ * @return End of the number. NULL if the number is invalid.
+ */
+static inline const char* ParseFloat(const char* source, const char* const end, float* const value) {
+    const bool negative = (source < end) && (*source == '-');
+    if (negative) {
+        source++;
+    }
+
+    // Integer digits
+    const char * const integerStart = source;
+    uint64_t mantissa = 0;
+    while ((source < end) && IsDigit(*source)) {
+        mantissa = (10 * mantissa) + (uint64_t) (*source++ - '0');
+    }
+    if ((source == integerStart) || ((source - integerStart) > MAX_INTEGER_DIGITS)) {
+        return NULL;
+    }
+
+    // Fractional digits
+    size_t numberOfFractionalDigits = 0;
+    if ((source < end) && (*source == '.')) {
+        const char * const fractionStart = ++source;
+        while ((source < end) && IsDigit(*source)) {
+            mantissa = (10 * mantissa) + (uint64_t) (*source++ - '0');
+        }
+        numberOfFractionalDigits = (size_t) (source - fractionStart);
+        if ((numberOfFractionalDigits == 0) || (numberOfFractionalDigits > XIMU3_ASCII_PRECISION_MAX)) {
+            return NULL;
+        }
+    }
+    const float magnitude = (float) ((double) mantissa / powersOfTen[numberOfFractionalDigits]);
+    *value = negative ? -magnitude : magnitude;
+    return source;
+}
+
+/**
+ * @brief Parses an unsigned decimal integer.
+ * @param source Source.
+ * @param end End of the message.
+ * @param value Value.
+ * @return End of the integer. NULL if there are no digits or the value
+ * overflows.
+ */
+static inline const char* ParseUint64(const char* source, const char* const end, uint64_t * const value) {
+    const char * const start = source;
+    *value = 0;
+    while ((source < end) && IsDigit(*source)) {
+        const uint64_t digit = (uint64_t) (*source++ - '0');
+        if ((*value > (UINT64_MAX / 10)) || ((*value == (UINT64_MAX / 10)) && (digit > (UINT64_MAX % 10)))) {
+            return NULL;
+        }
+        *value = (*value * 10) + digit;
+    }
+    return source == start ? NULL : source;
+}
+
+/**
+ * @brief Returns true if the character is a decimal digit.
+ * @param character Character.
+ * @return True if the character is a decimal digit.
+ */
+static inline bool IsDigit(const char character) {
+    return (unsigned char) (character - '0') < 10;
+}
+
+/**
+ * @brief Calls the parse error callback with a formatted message.
+ * @param parser Parser.
+ * @param format Format.
+ * @param ... Arguments.
+ */
+static void Error(const Ximu3AsciiParser * const parser, const char* const format, ...) {
+    if (parser->parseError == NULL) {
+        return;
+    }
+    char string[256];
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(string, sizeof (string), format, arguments);
+    va_end(arguments);
+    parser->parseError(string, parser->context);
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,70 @@
+/**
+ * @file Ximu3AsciiParser.h
+ * @author Seb Madgwick
+ * @brief x-IMU3 ASCII data message parser.
+ */
+
+#ifndef XIMU3_ASCII_PARSER_H
+#define XIMU3_ASCII_PARSER_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "Ximu3Data.h"
+#include "Ximu3Descriptor.h"
+#include "Ximu3Intern.h"
+#include "Ximu3Size.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Parser. Strings and byte arrays passed to callbacks point to the
+ * parser buffer and are only valid for the duration of the callback. Compact
+ * messages are parsed with absolute timestamps. Interned strings are parsed as
+ * the string. Lines that are not data messages, e.g. command responses, are
+ * ignored.
+ */
+typedef struct {
+    void (*const inertial) (const Ximu3DataInertial * const data, void* const context); // NULL if unused
+    void (*const magnetometer) (const Ximu3DataMagnetometer * const data, void* const context); // NULL if unused
+    void (*const highGAccelerometer) (const Ximu3DataHighGAccelerometer * const data, void* const context); // NULL if unused
+    void (*const quaternion) (const Ximu3DataQuaternion * const data, void* const context); // NULL if unused
+    void (*const rotationMatrix) (const Ximu3DataRotationMatrix * const data, void* const context); // NULL if unused
+    void (*const eulerAngles) (const Ximu3DataEulerAngles * const data, void* const context); // NULL if unused
+    void (*const linearAcceleration) (const Ximu3DataLinearAcceleration * const data, void* const context); // NULL if unused
+    void (*const earthAcceleration) (const Ximu3DataEarthAcceleration * const data, void* const context); // NULL if unused
+    void (*const ahrsStatus) (const Ximu3DataAhrsStatus * const data, void* const context); // NULL if unused
+    void (*const serialAccessory) (const Ximu3DataSerialAccessory * const data, void* const context); // NULL if unused
+    void (*const sync) (const Ximu3DataSync * const data, void* const context); // NULL if unused
+    void (*const ltc) (const Ximu3DataLtc * const data, void* const context); // NULL if unused
+    void (*const temperature) (const Ximu3DataTemperature * const data, void* const context); // NULL if unused
+    void (*const battery) (const Ximu3DataBattery * const data, void* const context); // NULL if unused
+    void (*const rssi) (const Ximu3DataRssi * const data, void* const context); // NULL if unused
+    void (*const button) (const Ximu3DataButton * const data, void* const context); // NULL if unused
+    void (*const notification) (const Ximu3DataNotification * const data, void* const context); // NULL if unused
+    void (*const error) (const Ximu3DataError * const data, void* const context); // NULL if unused
+    void (*const custom) (const Ximu3Descriptor * const descriptor, const void* const data, void* const context); // NULL if unused
+    void (*const parseError) (const char* const error, void* const context); // NULL if unused
+    void* context;
+    char buffer[XIMU3_SIZE_ASCII_PARSER]; // private
+    size_t index; // private
+    bool discard; // private
+    uint64_t timestamp; // private
+    bool timestampValid; // private
+    char interned[XIMU3_INTERN_NUMBER_OF_STRINGS][XIMU3_INTERN_STRING_SIZE]; // private
+} Ximu3AsciiParser;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void Ximu3AsciiParserProcess(Ximu3AsciiParser * const parser, const void* const data, const size_t numberOfBytes);
+void Ximu3AsciiParserReset(Ximu3AsciiParser * const parser);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -7,10 +7,22 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include <math.h>
 #include <string.h>
 #include "Ximu3Ascii.h"
 #include "Ximu3Binary.h"
 #include "Ximu3Definitions.h"
+#include "Ximu3Intern.h"
+#include "Ximu3Ltc.h"
+#include "Ximu3Size.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define BYTE_STUFFING_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BYTE_STUFFING_NEON
+#endif
 
 //------------------------------------------------------------------------------
 // Definitions
@@ -20,38 +32,138 @@
 #define BYTE_STUFFING_ESC_END   (0xDC)
 #define BYTE_STUFFING_ESC_ESC   (0xDD)
 
+/**
+ * @brief Size of the ID and 64-bit timestamp before byte stuffing.
+ */
+#define HEADER_SIZE (1 + sizeof (uint64_t))
+
+/**
+ * @brief Number of floats converted to bytes at a time for COBS.
+ */
+#define COBS_FLOAT_BLOCK (16)
+
+/**
+ * @brief Machine word used to scan for bytes that require byte stuffing.
+ */
+#if UINTPTR_MAX > 0xFFFFFFFF
+typedef uint64_t Word;
+#else
+typedef uint32_t Word;
+#endif
+
 //------------------------------------------------------------------------------
 // Function declarations
 
+static inline const uint8_t* UnpackTimecode(const Ximu3Descriptor * const descriptor, const void* const data, Ximu3DataLtc * const ltc, char* const timecode);
+static inline size_t NumberOfFloats(const Ximu3Descriptor * const descriptor);
+static inline size_t NumberOfBools(const Ximu3Descriptor * const descriptor, const size_t numberOfFloats);
+static inline const uint8_t* TrailingBytes(const Ximu3Descriptor * const descriptor, const void* const data, size_t * const numberOfBytes);
+static void AggregatorAdd(Ximu3BinaryAggregator * const aggregator, const char asciiId, const uint64_t timestamp, const float * const values, const float * const ranges, const size_t numberOfValues);
+static inline size_t StreamMaximumNumberOfBytes(const size_t maximumNumberOfBytes);
+static void StreamFlush(Ximu3BinarySerialAccessoryStream * const stream);
+static void StreamHeader(Ximu3BinarySerialAccessoryStream * const stream);
+static size_t Batch(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data, const size_t numberOfMessages, const size_t messageSize, size_t * const numberOfMessagesWritten);
+static inline void* BatchDestination(void* const destination, const size_t destinationSize, const size_t destinationIndex, void* const message, const size_t messageSize);
+static inline bool BatchCommit(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const void* const message, const size_t messageSize);
+static size_t WriteInterned(void* const destination, const size_t destinationSize, const char asciiId, const uint64_t timestamp, const char* const string, Ximu3Intern * const intern);
 static inline void WriteHeader(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char asciiId, const uint64_t timestamp);
-static inline void WriteFloat(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value_);
+static inline void HeaderBytes(uint8_t * const bytes, const char asciiId, const uint64_t timestamp);
+static inline void WriteFloat(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value);
+static inline void FloatBytes(uint8_t * const bytes, const float value_);
+static inline void WriteValue(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value, const Ximu3BinaryPayloadFormat payloadFormat, const float range);
+static void WriteCompressedQuaternion(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float w, const float x, const float y, const float z, const Ximu3BinaryQuaternionCompression quaternionCompression);
+static inline uint16_t FloatToHalf(const float value_);
+static inline uint16_t FloatToInt16(const float value, const float range);
+static inline void WriteVarint(void* const destination, const size_t destinationSize, size_t * const destinationIndex, uint32_t value);
 static inline void WriteString(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* string);
 static inline void WriteTermination(void* const destination, const size_t destinationSize, size_t * const destinationIndex);
+static inline void WriteBytes(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t* bytes, const size_t numberOfBytes);
+static void WriteStuffedBytes(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t* bytes, const size_t numberOfBytes);
+static inline size_t StuffInPlace(uint8_t * const bytes, const size_t numberOfBytes);
+static size_t StuffInPlaceFrom(uint8_t * const bytes, const size_t numberOfBytes, const size_t index);
+static inline size_t NumberOfUnstuffedBytes(const uint8_t * const bytes, const size_t numberOfBytes);
+static inline bool WordContains(const Word word, const uint8_t byte);
 static inline void WriteByte(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t byte);
+static bool CobsBytes(uint8_t * const destination, const size_t destinationSize, size_t * const destinationIndex, size_t * const codeIndex, const uint8_t* bytes, size_t numberOfBytes);
 
 //------------------------------------------------------------------------------
 // Functions
 
 /**
- * @brief Writes a binary inertial data message.
+ * @brief Writes a binary data message described by a descriptor. The message
+ * is written without checking the destination size if the destination is
+ * large enough for the worst case, e.g. XIMU3_SIZE_BINARY_INERTIAL for an
+ * inertial message.
  * @param destination Destination.
  * @param destinationSize Destination size.
+ * @param descriptor Descriptor.
  * @param data Data.
  * @return Message size.
  */
-size_t Ximu3BinaryInertial(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data) {
+size_t Ximu3BinaryMessage(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data) {
+    Ximu3DataLtc ltc;
+    char timecode[XIMU3_LTC_TIMECODE_SIZE];
+    const uint8_t * const members = UnpackTimecode(descriptor, data, &ltc, timecode);
+    if (members == NULL) {
+        return 0;
+    }
+
+    // Write without checking the destination size if the destination is large enough for the worst case
+    const size_t numberOfFloats = NumberOfFloats(descriptor);
+    size_t numberOfTrailingBytes;
+    const uint8_t * const trailingBytes = TrailingBytes(descriptor, members, &numberOfTrailingBytes);
+    const size_t numberOfBytes = HEADER_SIZE + (numberOfFloats * sizeof (float)) + numberOfTrailingBytes;
+    const size_t numberOfBoolBytes = NumberOfBools(descriptor, numberOfFloats) * sizeof (float);
+    if ((numberOfTrailingBytes < (destinationSize / 2)) && ((2 + XIMU3_SIZE_BYTE_STUFFING(numberOfBytes - 1 - numberOfBoolBytes) + numberOfBoolBytes) <= destinationSize)) { // ID and bools do not require byte stuffing
+        uint8_t * const bytes = destination;
+        HeaderBytes(bytes, descriptor->asciiId, *(const uint64_t*) members);
+        for (size_t index = 0; index < numberOfFloats; index++) {
+            const Ximu3DescriptorField * const field = &descriptor->fields[index];
+            const void* const member = &members[field->offset];
+            FloatBytes(&bytes[HEADER_SIZE + (index * sizeof (float))], field->type == Ximu3DescriptorFieldTypeBool ? (float) *(const bool*) member : *(const float*) member);
+        }
+        if (numberOfTrailingBytes > 0) {
+            memcpy(&bytes[numberOfBytes - numberOfTrailingBytes], trailingBytes, numberOfTrailingBytes);
+        }
+        size_t destinationIndex = 1 + StuffInPlace(&bytes[1], numberOfBytes - 1);
+        bytes[destinationIndex++] = BYTE_STUFFING_END;
+        return destinationIndex;
+    }
+
+    // Write with the destination size checked for each field
     size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_INERTIAL, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->gyroscopeX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->gyroscopeY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->gyroscopeZ);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->accelerometerX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->accelerometerY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->accelerometerZ);
+    WriteHeader(destination, destinationSize, &destinationIndex, descriptor->asciiId, *(const uint64_t*) members);
+    for (size_t index = 0; index < descriptor->numberOfFields; index++) {
+        const Ximu3DescriptorField * const field = &descriptor->fields[index];
+        const void* const member = &members[field->offset];
+        switch (field->type) {
+            case Ximu3DescriptorFieldTypeFloat:
+            case Ximu3DescriptorFieldTypeBool:
+                WriteFloat(destination, destinationSize, &destinationIndex, field->type == Ximu3DescriptorFieldTypeBool ? (float) *(const bool*) member : *(const float*) member);
+                break;
+            case Ximu3DescriptorFieldTypeString:
+                WriteString(destination, destinationSize, &destinationIndex, *(const char* const *) member);
+                break;
+            case Ximu3DescriptorFieldTypeBytes:
+                WriteBytes(destination, destinationSize, &destinationIndex, *(const uint8_t* const *) member, *(const size_t*) &members[field->numberOfBytesOffset]);
+                break;
+        }
+    }
     WriteTermination(destination, destinationSize, &destinationIndex);
     return destinationIndex;
 }
 
+/**
+ * @brief Writes a binary inertial data message.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+size_t Ximu3BinaryInertial(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data) {
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorInertial, data);
+}
+
 /**
  * @brief Writes a binary magnetometer data message.
  * @param destination Destination.
@@ -60,13 +172,7 @@ size_t Ximu3BinaryInertial(void* const destination, const size_t destinationSize
  * @return Message size.
  */
 size_t Ximu3BinaryMagnetometer(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_MAGNETOMETER, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->x);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->y);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->z);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorMagnetometer, data);
 }
 
 /**
@@ -77,13 +183,7 @@ size_t Ximu3BinaryMagnetometer(void* const destination, const size_t destination
  * @return Message size.
  */
 size_t Ximu3BinaryHighGAccelerometer(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->x);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->y);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->z);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorHighGAccelerometer, data);
 }
 
 /**
@@ -94,14 +194,7 @@ size_t Ximu3BinaryHighGAccelerometer(void* const destination, const size_t desti
  * @return Message size.
  */
 size_t Ximu3BinaryQuaternion(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_QUATERNION, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->w);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->x);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->y);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->z);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorQuaternion, data);
 }
 
 /**
@@ -112,19 +205,7 @@ size_t Ximu3BinaryQuaternion(void* const destination, const size_t destinationSi
  * @return Message size.
  */
 size_t Ximu3BinaryRotationMatrix(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_ROTATION_MATRIX, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->xx);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->xy);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->xz);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->yx);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->yy);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->yz);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->zx);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->zy);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->zz);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorRotationMatrix, data);
 }
 
 /**
@@ -135,13 +216,7 @@ size_t Ximu3BinaryRotationMatrix(void* const destination, const size_t destinati
  * @return Message size.
  */
 size_t Ximu3BinaryEulerAngles(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_EULER_ANGLES, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->roll);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->pitch);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->yaw);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorEulerAngles, data);
 }
 
 /**
@@ -152,17 +227,7 @@ size_t Ximu3BinaryEulerAngles(void* const destination, const size_t destinationS
  * @return Message size.
  */
 size_t Ximu3BinaryLinearAcceleration(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_LINEAR_ACCELERATION, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionW);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionZ);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->linearAccelerationZ);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorLinearAcceleration, data);
 }
 
 /**
@@ -173,17 +238,7 @@ size_t Ximu3BinaryLinearAcceleration(void* const destination, const size_t desti
  * @return Message size.
  */
 size_t Ximu3BinaryEarthAcceleration(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_EARTH_ACCELERATION, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionW);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->quaternionZ);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationX);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationY);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->earthAccelerationZ);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorEarthAcceleration, data);
 }
 
 /**
@@ -194,14 +249,7 @@ size_t Ximu3BinaryEarthAcceleration(void* const destination, const size_t destin
  * @return Message size.
  */
 size_t Ximu3BinaryAhrsStatus(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_AHRS_STATUS, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->initialising);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->angularRateRecovery);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->accelerationRecovery);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->magneticRecovery);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorAhrsStatus, data);
 }
 
 /**
@@ -212,13 +260,7 @@ size_t Ximu3BinaryAhrsStatus(void* const destination, const size_t destinationSi
  * @return Message size.
  */
 size_t Ximu3BinarySerialAccessory(void* const destination, const size_t destinationSize, const Ximu3DataSerialAccessory * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_SERIAL_ACCESSORY, data->timestamp);
-    for (size_t index = 0; index < data->numberOfBytes; index++) {
-        WriteByte(destination, destinationSize, &destinationIndex, data->data[index]);
-    }
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorSerialAccessory, data);
 }
 
 /**
@@ -229,26 +271,19 @@ size_t Ximu3BinarySerialAccessory(void* const destination, const size_t destinat
  * @return Message size.
  */
 size_t Ximu3BinarySync(void* const destination, const size_t destinationSize, const Ximu3DataSync * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_SYNC, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->edge);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorSync, data);
 }
 
 /**
- * @brief Writes a binary LTC data message.
+ * @brief Writes a binary LTC data message. The packed timecode is written as a
+ * string if the timecode is NULL.
  * @param destination Destination.
  * @param destinationSize Destination size.
  * @param data Data.
- * @return Message size.
+ * @return Message size. 0 if the packed timecode is invalid.
  */
 size_t Ximu3BinaryLtc(void* const destination, const size_t destinationSize, const Ximu3DataLtc * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_LTC, data->timestamp);
-    WriteString(destination, destinationSize, &destinationIndex, data->timecode);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorLtc, data);
 }
 
 /**
@@ -259,11 +294,7 @@ size_t Ximu3BinaryLtc(void* const destination, const size_t destinationSize, con
  * @return Message size.
  */
 size_t Ximu3BinaryTemperature(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_TEMPERATURE, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->temperature);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorTemperature, data);
 }
 
 /**
@@ -274,13 +305,7 @@ size_t Ximu3BinaryTemperature(void* const destination, const size_t destinationS
  * @return Message size.
  */
 size_t Ximu3BinaryBattery(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_BATTERY, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->percentage);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->voltage);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->chargingStatus);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorBattery, data);
 }
 
 /**
@@ -291,12 +316,7 @@ size_t Ximu3BinaryBattery(void* const destination, const size_t destinationSize,
  * @return Message size.
  */
 size_t Ximu3BinaryRssi(void* const destination, const size_t destinationSize, const Ximu3DataRssi * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_RSSI, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->percentage);
-    WriteFloat(destination, destinationSize, &destinationIndex, data->power);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorRssi, data);
 }
 
 /**
@@ -307,11 +327,7 @@ size_t Ximu3BinaryRssi(void* const destination, const size_t destinationSize, co
  * @return Message size.
  */
 size_t Ximu3BinaryButton(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_BUTTON, data->timestamp);
-    WriteFloat(destination, destinationSize, &destinationIndex, (float) data->state);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorButton, data);
 }
 
 /**
@@ -322,11 +338,7 @@ size_t Ximu3BinaryButton(void* const destination, const size_t destinationSize,
  * @return Message size.
  */
 size_t Ximu3BinaryNotification(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_NOTIFICATION, data->timestamp);
-    WriteString(destination, destinationSize, &destinationIndex, data->notification);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorNotification, data);
 }
 
 /**
@@ -337,104 +349,1980 @@ size_t Ximu3BinaryNotification(void* const destination, const size_t destination
  * @return Message size.
  */
 size_t Ximu3BinaryError(void* const destination, const size_t destinationSize, const Ximu3DataError * const data) {
-    size_t destinationIndex = 0;
-    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_ERROR, data->timestamp);
-    WriteString(destination, destinationSize, &destinationIndex, data->error);
-    WriteTermination(destination, destinationSize, &destinationIndex);
-    return destinationIndex;
+    return Ximu3BinaryMessage(destination, destinationSize, &ximu3DescriptorError, data);
 }
 
 /**
- * @brief Writes the header.
+ * @brief Writes consecutive binary inertial data messages. Only complete
+ * messages are written.
  * @param destination Destination.
- * @param destinationIndex Destination index.
- * @param asciiId ASCII data message ID.
- * @param timestamp Timestamp.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
  */
-static inline void WriteHeader(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char asciiId, const uint64_t timestamp) {
-    WriteByte(destination, destinationSize, destinationIndex, 0x80 + (uint8_t) asciiId);
-    WriteByte(destination, destinationSize, destinationIndex, (timestamp >> 0) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (timestamp >> 8) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (timestamp >> 16) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (timestamp >> 24) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (timestamp >> 32) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (timestamp >> 40) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (timestamp >> 48) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (timestamp >> 56) & 0xFF);
+size_t Ximu3BinaryInertialBatch(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorInertial, data, numberOfMessages, XIMU3_SIZE_BINARY_INERTIAL, numberOfMessagesWritten);
 }
 
 /**
- * @brief Writes a float.
+ * @brief Writes consecutive binary magnetometer data messages. Only complete
+ * messages are written.
  * @param destination Destination.
- * @param destinationIndex Destination index.
- * @param value Value.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
  */
-static inline void WriteFloat(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value_) {
-    uint32_t value;
-    memcpy(&value, &value_, sizeof (value));
-    WriteByte(destination, destinationSize, destinationIndex, (value >> 0) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (value >> 8) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (value >> 16) & 0xFF);
-    WriteByte(destination, destinationSize, destinationIndex, (value >> 24) & 0xFF);
+size_t Ximu3BinaryMagnetometerBatch(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorMagnetometer, data, numberOfMessages, XIMU3_SIZE_BINARY_MAGNETOMETER, numberOfMessagesWritten);
 }
 
 /**
- * @brief Writes a string.
+ * @brief Writes consecutive binary high-g accelerometer data messages. Only complete
+ * messages are written.
  * @param destination Destination.
- * @param destinationIndex Destination index.
- * @param string String.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
  */
-static inline void WriteString(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* string) {
-    while (*string != '\0') {
-        WriteByte(destination, destinationSize, destinationIndex, (uint8_t) * string++);
+size_t Ximu3BinaryHighGAccelerometerBatch(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorHighGAccelerometer, data, numberOfMessages, XIMU3_SIZE_BINARY_HIGH_G_ACCELEROMETER, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary quaternion data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryQuaternionBatch(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorQuaternion, data, numberOfMessages, XIMU3_SIZE_BINARY_QUATERNION, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary rotation matrix data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryRotationMatrixBatch(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorRotationMatrix, data, numberOfMessages, XIMU3_SIZE_BINARY_ROTATION_MATRIX, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary Euler angles data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryEulerAnglesBatch(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorEulerAngles, data, numberOfMessages, XIMU3_SIZE_BINARY_EULER_ANGLES, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary linear acceleration data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryLinearAccelerationBatch(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorLinearAcceleration, data, numberOfMessages, XIMU3_SIZE_BINARY_LINEAR_ACCELERATION, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary Earth acceleration data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryEarthAccelerationBatch(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorEarthAcceleration, data, numberOfMessages, XIMU3_SIZE_BINARY_EARTH_ACCELERATION, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary AHRS status data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryAhrsStatusBatch(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorAhrsStatus, data, numberOfMessages, XIMU3_SIZE_BINARY_AHRS_STATUS, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary serial accessory data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinarySerialAccessoryBatch(void* const destination, const size_t destinationSize, const Ximu3DataSerialAccessory * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorSerialAccessory, data, numberOfMessages, XIMU3_SIZE_BINARY_SERIAL_ACCESSORY, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary sync data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinarySyncBatch(void* const destination, const size_t destinationSize, const Ximu3DataSync * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorSync, data, numberOfMessages, XIMU3_SIZE_BINARY_SYNC, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary LTC data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryLtcBatch(void* const destination, const size_t destinationSize, const Ximu3DataLtc * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorLtc, data, numberOfMessages, XIMU3_SIZE_BINARY_LTC, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary temperature data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryTemperatureBatch(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorTemperature, data, numberOfMessages, XIMU3_SIZE_BINARY_TEMPERATURE, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary battery data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryBatteryBatch(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorBattery, data, numberOfMessages, XIMU3_SIZE_BINARY_BATTERY, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary RSSI data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryRssiBatch(void* const destination, const size_t destinationSize, const Ximu3DataRssi * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorRssi, data, numberOfMessages, XIMU3_SIZE_BINARY_RSSI, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary button data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryButtonBatch(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorButton, data, numberOfMessages, XIMU3_SIZE_BINARY_BUTTON, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary notification data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryNotificationBatch(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorNotification, data, numberOfMessages, XIMU3_SIZE_BINARY_NOTIFICATION, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes consecutive binary error data messages. Only complete
+ * messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+size_t Ximu3BinaryErrorBatch(void* const destination, const size_t destinationSize, const Ximu3DataError * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten) {
+    return Batch(destination, destinationSize, &ximu3DescriptorError, data, numberOfMessages, XIMU3_SIZE_BINARY_ERROR, numberOfMessagesWritten);
+}
+
+/**
+ * @brief Writes a binary inertial data message with the specified payload
+ * format.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
+ */
+size_t Ximu3BinaryInertialPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    if (payloadFormat == Ximu3BinaryPayloadFormatFloat32) {
+        return Ximu3BinaryInertial(destination, destinationSize, data);
     }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_INERTIAL, data->timestamp);
+    WriteValue(destination, destinationSize, &destinationIndex, data->gyroscopeX, payloadFormat, XIMU3_BINARY_RANGE_GYROSCOPE);
+    WriteValue(destination, destinationSize, &destinationIndex, data->gyroscopeY, payloadFormat, XIMU3_BINARY_RANGE_GYROSCOPE);
+    WriteValue(destination, destinationSize, &destinationIndex, data->gyroscopeZ, payloadFormat, XIMU3_BINARY_RANGE_GYROSCOPE);
+    WriteValue(destination, destinationSize, &destinationIndex, data->accelerometerX, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->accelerometerY, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->accelerometerZ, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
- * @brief Writes the termination.
+ * @brief Writes a binary magnetometer data message with the specified payload
+ * format.
  * @param destination Destination.
- * @param destinationIndex Destination index.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
  */
-static inline void WriteTermination(void* const destination, const size_t destinationSize, size_t * const destinationIndex) {
-    if (*destinationIndex >= destinationSize) {
-        if (destinationSize > 0) {
-            ((uint8_t*) destination)[destinationSize - 1] = BYTE_STUFFING_END;
-        }
-        return;
+size_t Ximu3BinaryMagnetometerPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    if (payloadFormat == Ximu3BinaryPayloadFormatFloat32) {
+        return Ximu3BinaryMagnetometer(destination, destinationSize, data);
     }
-    ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_END;
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_MAGNETOMETER, data->timestamp);
+    WriteValue(destination, destinationSize, &destinationIndex, data->x, payloadFormat, XIMU3_BINARY_RANGE_MAGNETOMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->y, payloadFormat, XIMU3_BINARY_RANGE_MAGNETOMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->z, payloadFormat, XIMU3_BINARY_RANGE_MAGNETOMETER);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
 }
 
 /**
- * @brief Writes a byte with byte stuffing.
+ * @brief Writes a binary high-g accelerometer data message with the specified payload
+ * format.
  * @param destination Destination.
- * @param destinationIndex Destination index.
- * @param byte Byte.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
  */
-static inline void WriteByte(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t byte) {
-    switch (byte) {
-        case BYTE_STUFFING_END:
-            if ((*destinationIndex + 1) >= destinationSize) {
-                return;
-            }
-            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC;
-            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC_END;
-            break;
-        case BYTE_STUFFING_ESC:
-            if ((*destinationIndex + 1) >= destinationSize) {
-                return;
-            }
-            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC;
-            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC_ESC;
-            break;
-        default:
-            if (*destinationIndex >= destinationSize) {
-                return;
+size_t Ximu3BinaryHighGAccelerometerPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    if (payloadFormat == Ximu3BinaryPayloadFormatFloat32) {
+        return Ximu3BinaryHighGAccelerometer(destination, destinationSize, data);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER, data->timestamp);
+    WriteValue(destination, destinationSize, &destinationIndex, data->x, payloadFormat, XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->y, payloadFormat, XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->z, payloadFormat, XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary quaternion data message with the specified payload
+ * format.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
+ */
+size_t Ximu3BinaryQuaternionPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    if (payloadFormat == Ximu3BinaryPayloadFormatFloat32) {
+        return Ximu3BinaryQuaternion(destination, destinationSize, data);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_QUATERNION, data->timestamp);
+    WriteValue(destination, destinationSize, &destinationIndex, data->w, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->x, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->y, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->z, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary rotation matrix data message with the specified payload
+ * format.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
+ */
+size_t Ximu3BinaryRotationMatrixPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    if (payloadFormat == Ximu3BinaryPayloadFormatFloat32) {
+        return Ximu3BinaryRotationMatrix(destination, destinationSize, data);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_ROTATION_MATRIX, data->timestamp);
+    WriteValue(destination, destinationSize, &destinationIndex, data->xx, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    WriteValue(destination, destinationSize, &destinationIndex, data->xy, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    WriteValue(destination, destinationSize, &destinationIndex, data->xz, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    WriteValue(destination, destinationSize, &destinationIndex, data->yx, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    WriteValue(destination, destinationSize, &destinationIndex, data->yy, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    WriteValue(destination, destinationSize, &destinationIndex, data->yz, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    WriteValue(destination, destinationSize, &destinationIndex, data->zx, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    WriteValue(destination, destinationSize, &destinationIndex, data->zy, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    WriteValue(destination, destinationSize, &destinationIndex, data->zz, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary Euler angles data message with the specified payload
+ * format.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
+ */
+size_t Ximu3BinaryEulerAnglesPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    if (payloadFormat == Ximu3BinaryPayloadFormatFloat32) {
+        return Ximu3BinaryEulerAngles(destination, destinationSize, data);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_EULER_ANGLES, data->timestamp);
+    WriteValue(destination, destinationSize, &destinationIndex, data->roll, payloadFormat, XIMU3_BINARY_RANGE_EULER_ANGLES);
+    WriteValue(destination, destinationSize, &destinationIndex, data->pitch, payloadFormat, XIMU3_BINARY_RANGE_EULER_ANGLES);
+    WriteValue(destination, destinationSize, &destinationIndex, data->yaw, payloadFormat, XIMU3_BINARY_RANGE_EULER_ANGLES);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary linear acceleration data message with the specified payload
+ * format.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
+ */
+size_t Ximu3BinaryLinearAccelerationPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    if (payloadFormat == Ximu3BinaryPayloadFormatFloat32) {
+        return Ximu3BinaryLinearAcceleration(destination, destinationSize, data);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_LINEAR_ACCELERATION, data->timestamp);
+    WriteValue(destination, destinationSize, &destinationIndex, data->quaternionW, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->quaternionX, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->quaternionY, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->quaternionZ, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->linearAccelerationX, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->linearAccelerationY, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->linearAccelerationZ, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary Earth acceleration data message with the specified payload
+ * format.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
+ */
+size_t Ximu3BinaryEarthAccelerationPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    if (payloadFormat == Ximu3BinaryPayloadFormatFloat32) {
+        return Ximu3BinaryEarthAcceleration(destination, destinationSize, data);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_EARTH_ACCELERATION, data->timestamp);
+    WriteValue(destination, destinationSize, &destinationIndex, data->quaternionW, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->quaternionX, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->quaternionY, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->quaternionZ, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    WriteValue(destination, destinationSize, &destinationIndex, data->earthAccelerationX, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->earthAccelerationY, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->earthAccelerationZ, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary temperature data message with the specified payload
+ * format.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
+ */
+size_t Ximu3BinaryTemperaturePayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    if (payloadFormat == Ximu3BinaryPayloadFormatFloat32) {
+        return Ximu3BinaryTemperature(destination, destinationSize, data);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_TEMPERATURE, data->timestamp);
+    WriteValue(destination, destinationSize, &destinationIndex, data->temperature, payloadFormat, XIMU3_BINARY_RANGE_TEMPERATURE);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary quaternion data message with the specified quaternion
+ * compression. The payload format is used if the quaternion is not compressed.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @param quaternionCompression Quaternion compression.
+ * @return Message size.
+ */
+size_t Ximu3BinaryQuaternionCompressed(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const Ximu3BinaryPayloadFormat payloadFormat, const Ximu3BinaryQuaternionCompression quaternionCompression) {
+    if (quaternionCompression == Ximu3BinaryQuaternionCompressionNone) {
+        return Ximu3BinaryQuaternionPayloadFormat(destination, destinationSize, data, payloadFormat);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_QUATERNION, data->timestamp);
+    WriteCompressedQuaternion(destination, destinationSize, &destinationIndex, data->w, data->x, data->y, data->z, quaternionCompression);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary linear acceleration data message with the specified
+ * quaternion compression. The linear acceleration is written with the payload
+ * format.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @param quaternionCompression Quaternion compression.
+ * @return Message size.
+ */
+size_t Ximu3BinaryLinearAccelerationCompressed(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const Ximu3BinaryPayloadFormat payloadFormat, const Ximu3BinaryQuaternionCompression quaternionCompression) {
+    if (quaternionCompression == Ximu3BinaryQuaternionCompressionNone) {
+        return Ximu3BinaryLinearAccelerationPayloadFormat(destination, destinationSize, data, payloadFormat);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_LINEAR_ACCELERATION, data->timestamp);
+    WriteCompressedQuaternion(destination, destinationSize, &destinationIndex, data->quaternionW, data->quaternionX, data->quaternionY, data->quaternionZ, quaternionCompression);
+    WriteValue(destination, destinationSize, &destinationIndex, data->linearAccelerationX, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->linearAccelerationY, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->linearAccelerationZ, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary Earth acceleration data message with the specified
+ * quaternion compression. The Earth acceleration is written with the payload
+ * format.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @param quaternionCompression Quaternion compression.
+ * @return Message size.
+ */
+size_t Ximu3BinaryEarthAccelerationCompressed(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const Ximu3BinaryPayloadFormat payloadFormat, const Ximu3BinaryQuaternionCompression quaternionCompression) {
+    if (quaternionCompression == Ximu3BinaryQuaternionCompressionNone) {
+        return Ximu3BinaryEarthAccelerationPayloadFormat(destination, destinationSize, data, payloadFormat);
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_EARTH_ACCELERATION, data->timestamp);
+    WriteCompressedQuaternion(destination, destinationSize, &destinationIndex, data->quaternionW, data->quaternionX, data->quaternionY, data->quaternionZ, quaternionCompression);
+    WriteValue(destination, destinationSize, &destinationIndex, data->earthAccelerationX, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->earthAccelerationY, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteValue(destination, destinationSize, &destinationIndex, data->earthAccelerationZ, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary AHRS status data message with the booleans packed as
+ * flags in a single byte.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+size_t Ximu3BinaryAhrsStatusPacked(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data) {
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_AHRS_STATUS, data->timestamp);
+    WriteByte(destination, destinationSize, &destinationIndex, (data->initialising ? XIMU3_BINARY_FLAG_INITIALISING : 0) |
+            (data->angularRateRecovery ? XIMU3_BINARY_FLAG_ANGULAR_RATE_RECOVERY : 0) |
+            (data->accelerationRecovery ? XIMU3_BINARY_FLAG_ACCELERATION_RECOVERY : 0) |
+            (data->magneticRecovery ? XIMU3_BINARY_FLAG_MAGNETIC_RECOVERY : 0));
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary sync data message with the boolean packed as a flag
+ * in a single byte.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+size_t Ximu3BinarySyncPacked(void* const destination, const size_t destinationSize, const Ximu3DataSync * const data) {
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_SYNC, data->timestamp);
+    WriteByte(destination, destinationSize, &destinationIndex, data->edge ? XIMU3_BINARY_FLAG_EDGE : 0);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary button data message with the boolean packed as a
+ * flag in a single byte.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size.
+ */
+size_t Ximu3BinaryButtonPacked(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data) {
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_BUTTON, data->timestamp);
+    WriteByte(destination, destinationSize, &destinationIndex, data->state ? XIMU3_BINARY_FLAG_STATE : 0);
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary LTC data message with the timecode packed into 4
+ * bytes. The timecode is packed if it is not NULL, otherwise the packed
+ * timecode is written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @return Message size. 0 if the timecode is invalid.
+ */
+size_t Ximu3BinaryLtcPacked(void* const destination, const size_t destinationSize, const Ximu3DataLtc * const data) {
+    uint32_t packedTimecode = data->packedTimecode;
+    if ((data->timecode != NULL) && (Ximu3LtcPack(data->timecode, &packedTimecode) == false)) {
+        return 0;
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_LTC, data->timestamp);
+    const uint8_t bytes[] = {
+        (packedTimecode >> 0) & 0xFF,
+        (packedTimecode >> 8) & 0xFF,
+        (packedTimecode >> 16) & 0xFF,
+        (packedTimecode >> 24) & 0xFF,
+    };
+    WriteBytes(destination, destinationSize, &destinationIndex, bytes, sizeof (bytes));
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a binary notification data message with the notification
+ * interned.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param intern Intern table.
+ * @return Message size.
+ */
+size_t Ximu3BinaryNotificationInterned(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data, Ximu3Intern * const intern) {
+    const size_t messageSize = WriteInterned(destination, destinationSize, XIMU3_ASCII_ID_NOTIFICATION, data->timestamp, data->notification, intern);
+    if (messageSize == 0) {
+        return Ximu3BinaryNotification(destination, destinationSize, data);
+    }
+    return messageSize;
+}
+
+/**
+ * @brief Writes a binary error data message with the error interned.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param intern Intern table.
+ * @return Message size.
+ */
+size_t Ximu3BinaryErrorInterned(void* const destination, const size_t destinationSize, const Ximu3DataError * const data, Ximu3Intern * const intern) {
+    const size_t messageSize = WriteInterned(destination, destinationSize, XIMU3_ASCII_ID_ERROR, data->timestamp, data->error, intern);
+    if (messageSize == 0) {
+        return Ximu3BinaryError(destination, destinationSize, data);
+    }
+    return messageSize;
+}
+
+/**
+ * @brief Adds an inertial sample to the aggregator.
+ * @param aggregator Aggregator.
+ * @param data Data.
+ */
+void Ximu3BinaryAggregatorInertial(Ximu3BinaryAggregator * const aggregator, const Ximu3DataInertial * const data) {
+    const float values[] = {
+        data->gyroscopeX,
+        data->gyroscopeY,
+        data->gyroscopeZ,
+        data->accelerometerX,
+        data->accelerometerY,
+        data->accelerometerZ,
+    };
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_GYROSCOPE,
+        XIMU3_BINARY_RANGE_GYROSCOPE,
+        XIMU3_BINARY_RANGE_GYROSCOPE,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+    };
+    AggregatorAdd(aggregator, XIMU3_ASCII_ID_INERTIAL, data->timestamp, values, ranges, sizeof (values) / sizeof (values[0]));
+}
+
+/**
+ * @brief Adds a magnetometer sample to the aggregator.
+ * @param aggregator Aggregator.
+ * @param data Data.
+ */
+void Ximu3BinaryAggregatorMagnetometer(Ximu3BinaryAggregator * const aggregator, const Ximu3DataMagnetometer * const data) {
+    const float values[] = {
+        data->x,
+        data->y,
+        data->z,
+    };
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_MAGNETOMETER,
+        XIMU3_BINARY_RANGE_MAGNETOMETER,
+        XIMU3_BINARY_RANGE_MAGNETOMETER,
+    };
+    AggregatorAdd(aggregator, XIMU3_ASCII_ID_MAGNETOMETER, data->timestamp, values, ranges, sizeof (values) / sizeof (values[0]));
+}
+
+/**
+ * @brief Adds a high-g accelerometer sample to the aggregator.
+ * @param aggregator Aggregator.
+ * @param data Data.
+ */
+void Ximu3BinaryAggregatorHighGAccelerometer(Ximu3BinaryAggregator * const aggregator, const Ximu3DataHighGAccelerometer * const data) {
+    const float values[] = {
+        data->x,
+        data->y,
+        data->z,
+    };
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER,
+    };
+    AggregatorAdd(aggregator, XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER, data->timestamp, values, ranges, sizeof (values) / sizeof (values[0]));
+}
+
+/**
+ * @brief Adds a quaternion sample to the aggregator.
+ * @param aggregator Aggregator.
+ * @param data Data.
+ */
+void Ximu3BinaryAggregatorQuaternion(Ximu3BinaryAggregator * const aggregator, const Ximu3DataQuaternion * const data) {
+    const float values[] = {
+        data->w,
+        data->x,
+        data->y,
+        data->z,
+    };
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+    };
+    AggregatorAdd(aggregator, XIMU3_ASCII_ID_QUATERNION, data->timestamp, values, ranges, sizeof (values) / sizeof (values[0]));
+}
+
+/**
+ * @brief Adds a rotation matrix sample to the aggregator.
+ * @param aggregator Aggregator.
+ * @param data Data.
+ */
+void Ximu3BinaryAggregatorRotationMatrix(Ximu3BinaryAggregator * const aggregator, const Ximu3DataRotationMatrix * const data) {
+    const float values[] = {
+        data->xx,
+        data->xy,
+        data->xz,
+        data->yx,
+        data->yy,
+        data->yz,
+        data->zx,
+        data->zy,
+        data->zz,
+    };
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+    };
+    AggregatorAdd(aggregator, XIMU3_ASCII_ID_ROTATION_MATRIX, data->timestamp, values, ranges, sizeof (values) / sizeof (values[0]));
+}
+
+/**
+ * @brief Adds an Euler angles sample to the aggregator.
+ * @param aggregator Aggregator.
+ * @param data Data.
+ */
+void Ximu3BinaryAggregatorEulerAngles(Ximu3BinaryAggregator * const aggregator, const Ximu3DataEulerAngles * const data) {
+    const float values[] = {
+        data->roll,
+        data->pitch,
+        data->yaw,
+    };
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_EULER_ANGLES,
+        XIMU3_BINARY_RANGE_EULER_ANGLES,
+        XIMU3_BINARY_RANGE_EULER_ANGLES,
+    };
+    AggregatorAdd(aggregator, XIMU3_ASCII_ID_EULER_ANGLES, data->timestamp, values, ranges, sizeof (values) / sizeof (values[0]));
+}
+
+/**
+ * @brief Adds a linear acceleration sample to the aggregator.
+ * @param aggregator Aggregator.
+ * @param data Data.
+ */
+void Ximu3BinaryAggregatorLinearAcceleration(Ximu3BinaryAggregator * const aggregator, const Ximu3DataLinearAcceleration * const data) {
+    const float values[] = {
+        data->quaternionW,
+        data->quaternionX,
+        data->quaternionY,
+        data->quaternionZ,
+        data->linearAccelerationX,
+        data->linearAccelerationY,
+        data->linearAccelerationZ,
+    };
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+    };
+    AggregatorAdd(aggregator, XIMU3_ASCII_ID_LINEAR_ACCELERATION, data->timestamp, values, ranges, sizeof (values) / sizeof (values[0]));
+}
+
+/**
+ * @brief Adds an Earth acceleration sample to the aggregator.
+ * @param aggregator Aggregator.
+ * @param data Data.
+ */
+void Ximu3BinaryAggregatorEarthAcceleration(Ximu3BinaryAggregator * const aggregator, const Ximu3DataEarthAcceleration * const data) {
+    const float values[] = {
+        data->quaternionW,
+        data->quaternionX,
+        data->quaternionY,
+        data->quaternionZ,
+        data->earthAccelerationX,
+        data->earthAccelerationY,
+        data->earthAccelerationZ,
+    };
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+    };
+    AggregatorAdd(aggregator, XIMU3_ASCII_ID_EARTH_ACCELERATION, data->timestamp, values, ranges, sizeof (values) / sizeof (values[0]));
+}
+
+/**
+ * @brief Adds a temperature sample to the aggregator.
+ * @param aggregator Aggregator.
+ * @param data Data.
+ */
+void Ximu3BinaryAggregatorTemperature(Ximu3BinaryAggregator * const aggregator, const Ximu3DataTemperature * const data) {
+    const float values[] = {
+        data->temperature,
+    };
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_TEMPERATURE,
+    };
+    AggregatorAdd(aggregator, XIMU3_ASCII_ID_TEMPERATURE, data->timestamp, values, ranges, sizeof (values) / sizeof (values[0]));
+}
+
+/**
+ * @brief Writes the aggregate message, if any samples have been added.
+ * @param aggregator Aggregator.
+ */
+void Ximu3BinaryAggregatorFlush(Ximu3BinaryAggregator * const aggregator) {
+    if (aggregator->numberOfSamples == 0) {
+        return;
+    }
+    WriteTermination(aggregator->buffer, sizeof (aggregator->buffer), &aggregator->index);
+    aggregator->write(aggregator->buffer, aggregator->index, aggregator->context);
+    aggregator->index = 0;
+    aggregator->numberOfSamples = 0;
+}
+
+/**
+ * @brief Begins a serial accessory stream. Any bytes of a previous stream that
+ * has not ended are written first.
+ * @param stream Stream.
+ * @param timestamp Timestamp of all messages of the stream.
+ */
+void Ximu3BinarySerialAccessoryBegin(Ximu3BinarySerialAccessoryStream * const stream, const uint64_t timestamp) {
+    Ximu3BinarySerialAccessoryEnd(stream);
+    stream->timestamp = timestamp;
+    stream->started = true;
+    StreamHeader(stream);
+}
+
+/**
+ * @brief Appends payload bytes to a serial accessory stream. The bytes are
+ * ignored if the stream has not begun.
+ * @param stream Stream.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+void Ximu3BinarySerialAccessoryAppend(Ximu3BinarySerialAccessoryStream * const stream, const void* const data, const size_t numberOfBytes) {
+    if (stream->started == false) {
+        return;
+    }
+    const size_t maximumNumberOfBytes = StreamMaximumNumberOfBytes(stream->maximumNumberOfBytes);
+    const uint8_t* bytes = data;
+    size_t remaining = numberOfBytes;
+    while (remaining > 0) {
+        const size_t available = maximumNumberOfBytes - stream->numberOfBytes;
+        const size_t count = remaining < available ? remaining : available;
+        WriteBytes(stream->buffer, sizeof (stream->buffer), &stream->index, bytes, count);
+        stream->numberOfBytes += count;
+        bytes += count;
+        remaining -= count;
+        if (stream->numberOfBytes == maximumNumberOfBytes) {
+            StreamFlush(stream);
+        }
+    }
+}
+
+/**
+ * @brief Ends a serial accessory stream. Any bytes not yet written are written
+ * as a final message.
+ * @param stream Stream.
+ */
+void Ximu3BinarySerialAccessoryEnd(Ximu3BinarySerialAccessoryStream * const stream) {
+    if (stream->started == false) {
+        return;
+    }
+    if (stream->numberOfBytes > 0) {
+        StreamFlush(stream);
+    }
+    stream->started = false;
+}
+
+/**
+ * @brief Writes a binary composite data message. The message contains a
+ * presence bitmask followed by the payload of each included message, all
+ * under one timestamp.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param data Data.
+ * @param payloadFormat Payload format.
+ * @return Message size.
+ */
+size_t Ximu3BinaryComposite(void* const destination, const size_t destinationSize, const Ximu3DataComposite * const data, const Ximu3BinaryPayloadFormat payloadFormat) {
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, XIMU3_ASCII_ID_COMPOSITE, data->timestamp);
+    const uint16_t mask = (data->inertial != NULL ? XIMU3_BINARY_COMPOSITE_INERTIAL : 0) |
+            (data->magnetometer != NULL ? XIMU3_BINARY_COMPOSITE_MAGNETOMETER : 0) |
+            (data->highGAccelerometer != NULL ? XIMU3_BINARY_COMPOSITE_HIGH_G_ACCELEROMETER : 0) |
+            (data->temperature != NULL ? XIMU3_BINARY_COMPOSITE_TEMPERATURE : 0) |
+            (data->quaternion != NULL ? XIMU3_BINARY_COMPOSITE_QUATERNION : 0) |
+            (data->rotationMatrix != NULL ? XIMU3_BINARY_COMPOSITE_ROTATION_MATRIX : 0) |
+            (data->eulerAngles != NULL ? XIMU3_BINARY_COMPOSITE_EULER_ANGLES : 0) |
+            (data->linearAcceleration != NULL ? XIMU3_BINARY_COMPOSITE_LINEAR_ACCELERATION : 0) |
+            (data->earthAcceleration != NULL ? XIMU3_BINARY_COMPOSITE_EARTH_ACCELERATION : 0) |
+            (payloadFormat != Ximu3BinaryPayloadFormatFloat32 ? XIMU3_BINARY_COMPOSITE_16_BIT : 0);
+    WriteByte(destination, destinationSize, &destinationIndex, (uint8_t) (mask & 0xFF));
+    WriteByte(destination, destinationSize, &destinationIndex, (uint8_t) (mask >> 8));
+    if (data->inertial != NULL) {
+        WriteValue(destination, destinationSize, &destinationIndex, data->inertial->gyroscopeX, payloadFormat, XIMU3_BINARY_RANGE_GYROSCOPE);
+        WriteValue(destination, destinationSize, &destinationIndex, data->inertial->gyroscopeY, payloadFormat, XIMU3_BINARY_RANGE_GYROSCOPE);
+        WriteValue(destination, destinationSize, &destinationIndex, data->inertial->gyroscopeZ, payloadFormat, XIMU3_BINARY_RANGE_GYROSCOPE);
+        WriteValue(destination, destinationSize, &destinationIndex, data->inertial->accelerometerX, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->inertial->accelerometerY, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->inertial->accelerometerZ, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    }
+    if (data->magnetometer != NULL) {
+        WriteValue(destination, destinationSize, &destinationIndex, data->magnetometer->x, payloadFormat, XIMU3_BINARY_RANGE_MAGNETOMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->magnetometer->y, payloadFormat, XIMU3_BINARY_RANGE_MAGNETOMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->magnetometer->z, payloadFormat, XIMU3_BINARY_RANGE_MAGNETOMETER);
+    }
+    if (data->highGAccelerometer != NULL) {
+        WriteValue(destination, destinationSize, &destinationIndex, data->highGAccelerometer->x, payloadFormat, XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->highGAccelerometer->y, payloadFormat, XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->highGAccelerometer->z, payloadFormat, XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER);
+    }
+    if (data->temperature != NULL) {
+        WriteValue(destination, destinationSize, &destinationIndex, data->temperature->temperature, payloadFormat, XIMU3_BINARY_RANGE_TEMPERATURE);
+    }
+    if (data->quaternion != NULL) {
+        WriteValue(destination, destinationSize, &destinationIndex, data->quaternion->w, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->quaternion->x, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->quaternion->y, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->quaternion->z, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+    }
+    if (data->rotationMatrix != NULL) {
+        WriteValue(destination, destinationSize, &destinationIndex, data->rotationMatrix->xx, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+        WriteValue(destination, destinationSize, &destinationIndex, data->rotationMatrix->xy, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+        WriteValue(destination, destinationSize, &destinationIndex, data->rotationMatrix->xz, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+        WriteValue(destination, destinationSize, &destinationIndex, data->rotationMatrix->yx, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+        WriteValue(destination, destinationSize, &destinationIndex, data->rotationMatrix->yy, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+        WriteValue(destination, destinationSize, &destinationIndex, data->rotationMatrix->yz, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+        WriteValue(destination, destinationSize, &destinationIndex, data->rotationMatrix->zx, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+        WriteValue(destination, destinationSize, &destinationIndex, data->rotationMatrix->zy, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+        WriteValue(destination, destinationSize, &destinationIndex, data->rotationMatrix->zz, payloadFormat, XIMU3_BINARY_RANGE_ROTATION_MATRIX);
+    }
+    if (data->eulerAngles != NULL) {
+        WriteValue(destination, destinationSize, &destinationIndex, data->eulerAngles->roll, payloadFormat, XIMU3_BINARY_RANGE_EULER_ANGLES);
+        WriteValue(destination, destinationSize, &destinationIndex, data->eulerAngles->pitch, payloadFormat, XIMU3_BINARY_RANGE_EULER_ANGLES);
+        WriteValue(destination, destinationSize, &destinationIndex, data->eulerAngles->yaw, payloadFormat, XIMU3_BINARY_RANGE_EULER_ANGLES);
+    }
+    if (data->linearAcceleration != NULL) {
+        WriteValue(destination, destinationSize, &destinationIndex, data->linearAcceleration->quaternionW, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->linearAcceleration->quaternionX, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->linearAcceleration->quaternionY, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->linearAcceleration->quaternionZ, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->linearAcceleration->linearAccelerationX, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->linearAcceleration->linearAccelerationY, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->linearAcceleration->linearAccelerationZ, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    }
+    if (data->earthAcceleration != NULL) {
+        WriteValue(destination, destinationSize, &destinationIndex, data->earthAcceleration->quaternionW, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->earthAcceleration->quaternionX, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->earthAcceleration->quaternionY, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->earthAcceleration->quaternionZ, payloadFormat, XIMU3_BINARY_RANGE_QUATERNION);
+        WriteValue(destination, destinationSize, &destinationIndex, data->earthAcceleration->earthAccelerationX, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->earthAcceleration->earthAccelerationY, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+        WriteValue(destination, destinationSize, &destinationIndex, data->earthAcceleration->earthAccelerationZ, payloadFormat, XIMU3_BINARY_RANGE_ACCELEROMETER);
+    }
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Converts a binary data message to a compact message, in place, if
+ * permitted by the compact timestamp state. The message must have been written
+ * by one of the other functions in this module. The size of a compact message
+ * is never greater than the size of the original message.
+ * @param compactTimestamp Compact timestamp.
+ * @param message Message.
+ * @param messageSize Message size.
+ * @return Message size.
+ */
+size_t Ximu3BinaryCompactTimestamp(Ximu3CompactTimestamp * const compactTimestamp, void* const message, const size_t messageSize) {
+    uint8_t * const bytes = (uint8_t*) message;
+
+    // Validate ID
+    if ((messageSize == 0) || (bytes[0] < (0x80 + 'A')) || (bytes[0] > (0x80 + 'Z'))) {
+        return messageSize;
+    }
+
+    // Parse timestamp
+    size_t index = 1;
+    uint64_t timestamp = 0;
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (index >= messageSize) {
+            return messageSize;
+        }
+        uint8_t byte = bytes[index++];
+        if (byte == BYTE_STUFFING_ESC) {
+            if (index >= messageSize) {
+                return messageSize;
+            }
+            byte = bytes[index++] == BYTE_STUFFING_ESC_END ? BYTE_STUFFING_END : BYTE_STUFFING_ESC;
+        }
+        timestamp |= (uint64_t) byte << shift;
+    }
+
+    // Update state
+    uint32_t delta;
+    if (Ximu3CompactTimestampUpdate(compactTimestamp, timestamp, &delta) == false) {
+        return messageSize;
+    }
+
+    // Write lowercase ID and varint timestamp delta
+    uint8_t header[1 + XIMU3_SIZE_BYTE_STUFFING(3)];
+    size_t headerIndex = 0;
+    WriteByte(header, sizeof (header), &headerIndex, bytes[0] | 0x20);
+    WriteVarint(header, sizeof (header), &headerIndex, delta);
+
+    // Replace header
+    memmove(&bytes[headerIndex], &bytes[index], messageSize - index);
+    memcpy(bytes, header, headerIndex);
+    return headerIndex + messageSize - index;
+}
+
+/**
+ * @brief Converts a binary data message to a COBS framed message. The ID and
+ * termination are unchanged. The byte stuffing of the timestamp and payload is
+ * replaced by Consistent Overhead Byte Stuffing (COBS) with the termination as
+ * the delimiter, i.e. each code byte is XORed with the termination. This adds
+ * one byte per 254 bytes instead of up to one byte per byte. The message must
+ * have been written by one of the other functions in this module, and may
+ * have been converted to a compact message first.
+ * @param destination Destination. Must not overlap the message.
+ * @param destinationSize Destination size, e.g. XIMU3_SIZE_BINARY_COBS_INERTIAL.
+ * @param message Message.
+ * @param messageSize Message size.
+ * @return Size of the COBS framed message. 0 if the message is invalid or the
+ * destination is too small.
+ */
+size_t Ximu3BinaryCobs(void* const destination, const size_t destinationSize, const void* const message, const size_t messageSize) {
+    const uint8_t * const source = message;
+    uint8_t * const bytes = destination;
+
+    // Validate message
+    if ((messageSize < 2) || (source[0] < 0x80) || (source[messageSize - 1] != BYTE_STUFFING_END) || (destinationSize < 3)) {
+        return 0;
+    }
+
+    // ID
+    bytes[0] = source[0];
+    size_t codeIndex = 1;
+    size_t destinationIndex = 2;
+    uint8_t code = 1;
+
+    // Timestamp and payload
+    for (size_t index = 1; index < (messageSize - 1); index++) {
+        uint8_t byte = source[index];
+        if (byte == BYTE_STUFFING_ESC) {
+            if (++index >= (messageSize - 1)) {
+                return 0;
+            }
+            switch (source[index]) {
+                case BYTE_STUFFING_ESC_END:
+                    byte = BYTE_STUFFING_END;
+                    break;
+                case BYTE_STUFFING_ESC_ESC:
+                    byte = BYTE_STUFFING_ESC;
+                    break;
+                default:
+                    return 0;
+            }
+        }
+        if (destinationIndex >= destinationSize) {
+            return 0;
+        }
+        if (byte == BYTE_STUFFING_END) {
+            bytes[codeIndex] = code ^ BYTE_STUFFING_END;
+            codeIndex = destinationIndex++;
+            code = 1;
+            continue;
+        }
+        bytes[destinationIndex++] = byte;
+        if (++code == 0xFF) {
+            if (destinationIndex >= destinationSize) {
+                return 0;
+            }
+            bytes[codeIndex] = code ^ BYTE_STUFFING_END;
+            codeIndex = destinationIndex++;
+            code = 1;
+        }
+    }
+
+    // Termination
+    if (destinationIndex >= destinationSize) {
+        return 0;
+    }
+    bytes[codeIndex] = code ^ BYTE_STUFFING_END;
+    bytes[destinationIndex++] = BYTE_STUFFING_END;
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes a COBS framed binary data message described by a descriptor.
+ * The header and payload are COBS encoded directly, so the message is
+ * identical to a message written by Ximu3BinaryMessage and converted by
+ * Ximu3BinaryCobs, without the intermediate byte stuffed message.
+ * @param destination Destination.
+ * @param destinationSize Destination size, e.g. XIMU3_SIZE_BINARY_COBS_INERTIAL.
+ * @param descriptor Descriptor.
+ * @param data Data.
+ * @return Size of the COBS framed message. 0 if the packed timecode of an LTC
+ * message is invalid or the destination is too small.
+ */
+size_t Ximu3BinaryMessageCobs(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data) {
+    Ximu3DataLtc ltc;
+    char timecode[XIMU3_LTC_TIMECODE_SIZE];
+    const uint8_t * const members = UnpackTimecode(descriptor, data, &ltc, timecode);
+    if ((members == NULL) || (destinationSize < 3)) {
+        return 0;
+    }
+    uint8_t * const bytes = destination;
+
+    // ID
+    uint8_t header[HEADER_SIZE];
+    HeaderBytes(header, descriptor->asciiId, *(const uint64_t*) members);
+    bytes[0] = header[0];
+    size_t codeIndex = 1;
+    size_t destinationIndex = 2;
+
+    // Timestamp
+    if (CobsBytes(bytes, destinationSize, &destinationIndex, &codeIndex, &header[1], HEADER_SIZE - 1) == false) {
+        return 0;
+    }
+
+    // Floats
+    const size_t numberOfFloats = NumberOfFloats(descriptor);
+    for (size_t index = 0; index < numberOfFloats; index += COBS_FLOAT_BLOCK) {
+        uint8_t block[COBS_FLOAT_BLOCK * sizeof (float)];
+        const size_t numberOfBlockFloats = (numberOfFloats - index) < COBS_FLOAT_BLOCK ? (numberOfFloats - index) : COBS_FLOAT_BLOCK;
+        for (size_t blockIndex = 0; blockIndex < numberOfBlockFloats; blockIndex++) {
+            const Ximu3DescriptorField * const field = &descriptor->fields[index + blockIndex];
+            const void* const member = &members[field->offset];
+            FloatBytes(&block[blockIndex * sizeof (float)], field->type == Ximu3DescriptorFieldTypeBool ? (float) *(const bool*) member : *(const float*) member);
+        }
+        if (CobsBytes(bytes, destinationSize, &destinationIndex, &codeIndex, block, numberOfBlockFloats * sizeof (float)) == false) {
+            return 0;
+        }
+    }
+
+    // String or bytes
+    size_t numberOfTrailingBytes;
+    const uint8_t * const trailingBytes = TrailingBytes(descriptor, members, &numberOfTrailingBytes);
+    if (CobsBytes(bytes, destinationSize, &destinationIndex, &codeIndex, trailingBytes, numberOfTrailingBytes) == false) {
+        return 0;
+    }
+
+    // Termination
+    if (destinationIndex >= destinationSize) {
+        return 0;
+    }
+    bytes[codeIndex] = (uint8_t) (destinationIndex - codeIndex) ^ BYTE_STUFFING_END;
+    bytes[destinationIndex++] = BYTE_STUFFING_END;
+    return destinationIndex;
+}
+
+/**
+ * @brief Returns the data with the timecode unpacked if the data is an LTC
+ * message with a NULL timecode.
+ * @param descriptor Descriptor.
+ * @param data Data.
+ * @param ltc LTC data written if the timecode is unpacked.
+ * @param timecode Timecode written if the timecode is unpacked.
+ * @return Data. NULL if the packed timecode is invalid.
+ */
+static inline const uint8_t* UnpackTimecode(const Ximu3Descriptor * const descriptor, const void* const data, Ximu3DataLtc * const ltc, char* const timecode) {
+    if ((descriptor->asciiId != XIMU3_ASCII_ID_LTC) || (((const Ximu3DataLtc*) data)->timecode != NULL)) {
+        return data;
+    }
+    *ltc = *(const Ximu3DataLtc*) data;
+    if (Ximu3LtcUnpack(ltc->packedTimecode, timecode) == false) {
+        return NULL;
+    }
+    ltc->timecode = timecode;
+    return (const uint8_t*) ltc;
+}
+
+/**
+ * @brief Returns the number of fields written as floats. These are all fields
+ * except a string or bytes field, which must be the last field.
+ * @param descriptor Descriptor.
+ * @return Number of fields written as floats.
+ */
+static inline size_t NumberOfFloats(const Ximu3Descriptor * const descriptor) {
+    if (descriptor->numberOfFields == 0) {
+        return 0;
+    }
+    switch (descriptor->fields[descriptor->numberOfFields - 1].type) {
+        case Ximu3DescriptorFieldTypeString:
+        case Ximu3DescriptorFieldTypeBytes:
+            return descriptor->numberOfFields - 1;
+        default:
+            return descriptor->numberOfFields;
+    }
+}
+
+/**
+ * @brief Returns the number of bool fields. Bools are written as 0.0f or 1.0f
+ * and so never require byte stuffing.
+ * @param descriptor Descriptor.
+ * @param numberOfFloats Number of float and bool fields.
+ * @return Number of bool fields.
+ */
+static inline size_t NumberOfBools(const Ximu3Descriptor * const descriptor, const size_t numberOfFloats) {
+    size_t numberOfBools = 0;
+    for (size_t index = 0; index < numberOfFloats; index++) {
+        if (descriptor->fields[index].type == Ximu3DescriptorFieldTypeBool) {
+            numberOfBools++;
+        }
+    }
+    return numberOfBools;
+}
+
+/**
+ * @brief Returns the bytes of the string or bytes field.
+ * @param descriptor Descriptor.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes. 0 if there is no string or bytes
+ * field.
+ * @return Bytes. NULL if there is no string or bytes field.
+ */
+static inline const uint8_t* TrailingBytes(const Ximu3Descriptor * const descriptor, const void* const data, size_t * const numberOfBytes) {
+    *numberOfBytes = 0;
+    if (descriptor->numberOfFields == 0) {
+        return NULL;
+    }
+    const uint8_t * const members = data;
+    const Ximu3DescriptorField * const field = &descriptor->fields[descriptor->numberOfFields - 1];
+    switch (field->type) {
+        case Ximu3DescriptorFieldTypeString: {
+            const char* const string = *(const char* const *) &members[field->offset];
+            *numberOfBytes = string == NULL ? 0 : strlen(string);
+            return (const uint8_t*) string;
+        }
+        case Ximu3DescriptorFieldTypeBytes:
+            *numberOfBytes = *(const size_t*) &members[field->numberOfBytesOffset];
+            return *(const uint8_t* const *) &members[field->offset];
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Adds a sample to the aggregator. The aggregate message is written
+ * first if the sample cannot be added to it. The sample ID is the ASCII ID of
+ * the sample with the most significant bit set for 16-bit payload formats.
+ * @param aggregator Aggregator.
+ * @param asciiId ASCII ID.
+ * @param timestamp Timestamp.
+ * @param values Values.
+ * @param ranges Ranges of the Ximu3BinaryPayloadFormatInt16 payload format.
+ * @param numberOfValues Number of values.
+ */
+static void AggregatorAdd(Ximu3BinaryAggregator * const aggregator, const char asciiId, const uint64_t timestamp, const float * const values, const float * const ranges, const size_t numberOfValues) {
+    const bool float32 = aggregator->payloadFormat == Ximu3BinaryPayloadFormatFloat32;
+    const uint8_t sampleId = (uint8_t) asciiId | (float32 ? 0x00 : 0x80);
+    const size_t maximumSampleSize = XIMU3_SIZE_BYTE_STUFFING(3 + (numberOfValues * (float32 ? sizeof (float) : sizeof (uint16_t))));
+    const size_t maximumSize = ((aggregator->maximumSize == 0) || (aggregator->maximumSize > sizeof (aggregator->buffer))) ? sizeof (aggregator->buffer) : aggregator->maximumSize;
+
+    // Write aggregate message if sample cannot be added
+    if ((aggregator->numberOfSamples > 0) && ((sampleId != aggregator->sampleId) || (timestamp < aggregator->timestamp) || ((timestamp - aggregator->timestamp) > XIMU3_BINARY_AGGREGATE_MAX_OFFSET))) {
+        Ximu3BinaryAggregatorFlush(aggregator);
+    }
+
+    // Write header and sample ID
+    if (aggregator->numberOfSamples == 0) {
+        aggregator->index = 0;
+        WriteHeader(aggregator->buffer, sizeof (aggregator->buffer), &aggregator->index, XIMU3_ASCII_ID_AGGREGATE, timestamp);
+        WriteByte(aggregator->buffer, sizeof (aggregator->buffer), &aggregator->index, sampleId);
+        aggregator->sampleId = sampleId;
+        aggregator->timestamp = timestamp;
+    }
+
+    // Write sample
+    WriteVarint(aggregator->buffer, sizeof (aggregator->buffer), &aggregator->index, (uint32_t) (timestamp - aggregator->timestamp));
+    for (size_t index = 0; index < numberOfValues; index++) {
+        WriteValue(aggregator->buffer, sizeof (aggregator->buffer), &aggregator->index, values[index], aggregator->payloadFormat, ranges[index]);
+    }
+    aggregator->numberOfSamples++;
+
+    // Write aggregate message if threshold reached or next sample may not fit
+    if (((aggregator->maximumNumberOfSamples > 0) && (aggregator->numberOfSamples >= aggregator->maximumNumberOfSamples)) || ((aggregator->index + maximumSampleSize + 1) > maximumSize)) {
+        Ximu3BinaryAggregatorFlush(aggregator);
+    }
+}
+
+/**
+ * @brief Returns the maximum number of payload bytes per serial accessory
+ * stream message.
+ * @param maximumNumberOfBytes Maximum number of bytes of the stream.
+ * @return Maximum number of payload bytes per message.
+ */
+static inline size_t StreamMaximumNumberOfBytes(const size_t maximumNumberOfBytes) {
+    if ((maximumNumberOfBytes == 0) || (maximumNumberOfBytes > XIMU3_SIZE_CHAR_ARRAY)) {
+        return XIMU3_SIZE_CHAR_ARRAY;
+    }
+    return maximumNumberOfBytes;
+}
+
+/**
+ * @brief Writes the serial accessory stream message and begins the next
+ * message with the same timestamp.
+ * @param stream Stream.
+ */
+static void StreamFlush(Ximu3BinarySerialAccessoryStream * const stream) {
+    WriteTermination(stream->buffer, sizeof (stream->buffer), &stream->index);
+    stream->write(stream->buffer, stream->index, stream->context);
+    StreamHeader(stream);
+}
+
+/**
+ * @brief Writes the header of the next serial accessory stream message.
+ * @param stream Stream.
+ */
+static void StreamHeader(Ximu3BinarySerialAccessoryStream * const stream) {
+    stream->index = 0;
+    stream->numberOfBytes = 0;
+    WriteHeader(stream->buffer, sizeof (stream->buffer), &stream->index, XIMU3_ASCII_ID_SERIAL_ACCESSORY, stream->timestamp);
+}
+
+/**
+ * @brief Writes consecutive binary data messages described by a descriptor. Only
+ * complete messages are written.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param descriptor Descriptor.
+ * @param data Array of data.
+ * @param numberOfMessages Number of messages.
+ * @param messageSize Largest possible message size.
+ * @param numberOfMessagesWritten Number of messages written. NULL if unused.
+ * @return Total size of messages written.
+ */
+static size_t Batch(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data, const size_t numberOfMessages, const size_t messageSize, size_t * const numberOfMessagesWritten) {
+    const uint8_t* members = data;
+    uint8_t message[XIMU3_SIZE_BINARY_SERIAL_ACCESSORY]; // largest message of any data type
+    size_t destinationIndex = 0;
+    size_t index = 0;
+    for (; index < numberOfMessages; index++) {
+        void* const messageDestination = BatchDestination(destination, destinationSize, destinationIndex, message, messageSize);
+        if (BatchCommit(destination, destinationSize, &destinationIndex, messageDestination, Ximu3BinaryMessage(messageDestination, messageSize, descriptor, members)) == false) {
+            break;
+        }
+        members += descriptor->size;
+    }
+    if (numberOfMessagesWritten != NULL) {
+        *numberOfMessagesWritten = index;
+    }
+    return destinationIndex;
+}
+
+/**
+ * @brief Returns the destination for the next message of a batch. This is the
+ * batch destination if there is space for the largest possible message,
+ * otherwise the message buffer.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param destinationIndex Destination index.
+ * @param message Message buffer.
+ * @param messageSize Message buffer size.
+ * @return Destination for the next message.
+ */
+static inline void* BatchDestination(void* const destination, const size_t destinationSize, const size_t destinationIndex, void* const message, const size_t messageSize) {
+    if ((destinationSize - destinationIndex) >= messageSize) {
+        return &((uint8_t*) destination)[destinationIndex];
+    }
+    return message;
+}
+
+/**
+ * @brief Commits the next message of a batch. A message written to the message
+ * buffer is copied to the batch destination if there is space.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param destinationIndex Destination index.
+ * @param message Message.
+ * @param messageSize Message size.
+ * @return True if the message was committed.
+ */
+static inline bool BatchCommit(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const void* const message, const size_t messageSize) {
+    uint8_t * const next = &((uint8_t*) destination)[*destinationIndex];
+    if (message != next) {
+        if (messageSize > (destinationSize - *destinationIndex)) {
+            return false;
+        }
+        memcpy(next, message, messageSize);
+    }
+    *destinationIndex += messageSize;
+    return true;
+}
+
+/**
+ * @brief Writes a message with an interned string. The payload is a null
+ * character, which cannot be the first character of a string, followed by
+ * the index byte and the string if the string is not yet in the table. The
+ * string is only added to the table if the destination is large enough for
+ * the worst case, so that the definition is never truncated.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param asciiId ASCII data message ID.
+ * @param timestamp Timestamp.
+ * @param string String.
+ * @param intern Intern table.
+ * @return Message size. 0 if the string cannot be interned.
+ */
+static size_t WriteInterned(void* const destination, const size_t destinationSize, const char asciiId, const uint64_t timestamp, const char* const string, Ximu3Intern * const intern) {
+    int index = Ximu3InternFind(intern, string);
+    const bool definition = index < 0;
+    if (definition) {
+        index = Ximu3InternNext(intern, string);
+        if (index < 0) {
+            return 0;
+        }
+    }
+    size_t destinationIndex = 0;
+    WriteHeader(destination, destinationSize, &destinationIndex, asciiId, timestamp);
+    WriteByte(destination, destinationSize, &destinationIndex, '\0');
+    WriteByte(destination, destinationSize, &destinationIndex, (uint8_t) index | (definition ? XIMU3_INTERN_FLAG_DEFINITION : 0));
+    if (definition) {
+        WriteString(destination, destinationSize, &destinationIndex, string);
+        if (destinationSize >= (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BYTE_STUFFING(2 + strlen(string)))) {
+            Ximu3InternAdd(intern, string);
+        }
+    }
+    WriteTermination(destination, destinationSize, &destinationIndex);
+    return destinationIndex;
+}
+
+/**
+ * @brief Writes the header.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param asciiId ASCII data message ID.
+ * @param timestamp Timestamp.
+ */
+static inline void WriteHeader(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char asciiId, const uint64_t timestamp) {
+    uint8_t bytes[HEADER_SIZE];
+    HeaderBytes(bytes, asciiId, timestamp);
+    WriteBytes(destination, destinationSize, destinationIndex, bytes, sizeof (bytes));
+}
+
+/**
+ * @brief Writes the header bytes before byte stuffing.
+ * @param bytes Bytes.
+ * @param asciiId ASCII data message ID.
+ * @param timestamp Timestamp.
+ */
+static inline void HeaderBytes(uint8_t * const bytes, const char asciiId, const uint64_t timestamp) {
+    bytes[0] = 0x80 + (uint8_t) asciiId;
+    bytes[1] = (timestamp >> 0) & 0xFF;
+    bytes[2] = (timestamp >> 8) & 0xFF;
+    bytes[3] = (timestamp >> 16) & 0xFF;
+    bytes[4] = (timestamp >> 24) & 0xFF;
+    bytes[5] = (timestamp >> 32) & 0xFF;
+    bytes[6] = (timestamp >> 40) & 0xFF;
+    bytes[7] = (timestamp >> 48) & 0xFF;
+    bytes[8] = (timestamp >> 56) & 0xFF;
+}
+
+/**
+ * @brief Writes a float.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param value Value.
+ */
+static inline void WriteFloat(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value) {
+    uint8_t bytes[sizeof (float)];
+    FloatBytes(bytes, value);
+    WriteBytes(destination, destinationSize, destinationIndex, bytes, sizeof (bytes));
+}
+
+/**
+ * @brief Writes the bytes of a float before byte stuffing.
+ * @param bytes Bytes.
+ * @param value_ Value.
+ */
+static inline void FloatBytes(uint8_t * const bytes, const float value_) {
+    uint32_t value;
+    memcpy(&value, &value_, sizeof (value));
+    bytes[0] = (value >> 0) & 0xFF;
+    bytes[1] = (value >> 8) & 0xFF;
+    bytes[2] = (value >> 16) & 0xFF;
+    bytes[3] = (value >> 24) & 0xFF;
+}
+
+/**
+ * @brief Writes a value with the specified payload format.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param value Value.
+ * @param payloadFormat Payload format.
+ * @param range Range of the Ximu3BinaryPayloadFormatInt16 payload format.
+ */
+static inline void WriteValue(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float value, const Ximu3BinaryPayloadFormat payloadFormat, const float range) {
+    uint16_t value16;
+    switch (payloadFormat) {
+        case Ximu3BinaryPayloadFormatFloat16:
+            value16 = FloatToHalf(value);
+            break;
+        case Ximu3BinaryPayloadFormatInt16:
+            value16 = FloatToInt16(value, range);
+            break;
+        default:
+            WriteFloat(destination, destinationSize, destinationIndex, value);
+            return;
+    }
+    const uint8_t bytes[] = {
+        (value16 >> 0) & 0xFF,
+        (value16 >> 8) & 0xFF,
+    };
+    WriteBytes(destination, destinationSize, destinationIndex, bytes, sizeof (bytes));
+}
+
+/**
+ * @brief Writes a compressed quaternion. The quaternion is normalised before
+ * compression. A quaternion of zero length is written as the identity
+ * quaternion.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param w W element.
+ * @param x X element.
+ * @param y Y element.
+ * @param z Z element.
+ * @param quaternionCompression Quaternion compression.
+ */
+static void WriteCompressedQuaternion(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const float w, const float x, const float y, const float z, const Ximu3BinaryQuaternionCompression quaternionCompression) {
+    const float components[] = {w, x, y, z};
+
+    // Find largest component
+    unsigned int largest = 0;
+    for (unsigned int index = 1; index < 4; index++) {
+        if (fabsf(components[index]) > fabsf(components[largest])) {
+            largest = index;
+        }
+    }
+
+    // Scale so that the quaternion is normalised, the largest component is positive, and the other components are within +/-1
+    const float norm = sqrtf((w * w) + (x * x) + (y * y) + (z * z));
+    const float scale = (norm > 0.0f) ? (((components[largest] < 0.0f) ? -1.41421356f : 1.41421356f) / norm) : 0.0f;
+
+    // Quantise other components
+    const unsigned int bits = (quaternionCompression == Ximu3BinaryQuaternionCompression48Bit) ? XIMU3_BINARY_COMPRESSED_QUATERNION_48_BIT_BITS : XIMU3_BINARY_COMPRESSED_QUATERNION_32_BIT_BITS;
+    const float maximum = (float) ((1 << (bits - 1)) - 1);
+    uint64_t packed = largest;
+    for (unsigned int index = 0; index < 4; index++) {
+        if (index == largest) {
+            continue;
+        }
+        const float scaled = components[index] * scale * maximum;
+        float quantised;
+        if (scaled != scaled) {
+            quantised = 0.0f; // NaN
+        } else if (scaled >= maximum) {
+            quantised = maximum;
+        } else if (scaled <= -maximum) {
+            quantised = -maximum;
+        } else {
+            quantised = scaled + (scaled >= 0.0f ? 0.5f : -0.5f);
+        }
+        packed = (packed << bits) | (uint64_t) ((int32_t) quantised + (int32_t) maximum);
+    }
+
+    // Write
+    size_t numberOfBytes = 4;
+    if (quaternionCompression == Ximu3BinaryQuaternionCompression48Bit) {
+        packed <<= 1;
+        numberOfBytes = 6;
+    }
+    uint8_t bytes[6];
+    for (size_t index = 0; index < numberOfBytes; index++) {
+        bytes[index] = (uint8_t) (packed >> (8 * index));
+    }
+    WriteBytes(destination, destinationSize, destinationIndex, bytes, numberOfBytes);
+}
+
+/**
+ * @brief Converts a float to an IEEE 754 half float, rounding to nearest even.
+ * Values too large to be represented are converted to infinity.
+ * @param value_ Value.
+ * @return Half float.
+ */
+static inline uint16_t FloatToHalf(const float value_) {
+    uint32_t value;
+    memcpy(&value, &value_, sizeof (value));
+    const uint16_t sign = (uint16_t) ((value >> 16) & 0x8000);
+    const uint32_t magnitude = value & 0x7FFFFFFF;
+
+    // Infinity or NaN
+    if (magnitude >= 0x7F800000) {
+        return sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x0200 : 0);
+    }
+
+    // Overflow, i.e. rounds to 65520 or more
+    if (magnitude >= 0x477FF000) {
+        return sign | 0x7C00;
+    }
+
+    // Normal
+    if (magnitude >= 0x38800000) {
+        uint32_t half = (magnitude - 0x38000000) >> 13; // rebias exponent from 127 to 15
+        const uint32_t remainder = magnitude & 0x1FFF;
+        if ((remainder > 0x1000) || ((remainder == 0x1000) && ((half & 1) != 0))) {
+            half++;
+        }
+        return sign | (uint16_t) half;
+    }
+
+    // Subnormal or zero
+    if (magnitude < 0x33000000) {
+        return sign;
+    }
+    const uint32_t mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+    const uint32_t shift = 126 - (magnitude >> 23);
+    uint32_t half = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((UINT32_C(1) << shift) - 1);
+    const uint32_t halfway = UINT32_C(1) << (shift - 1);
+    if ((remainder > halfway) || ((remainder == halfway) && ((half & 1) != 0))) {
+        half++;
+    }
+    return sign | (uint16_t) half;
+}
+
+/**
+ * @brief Converts a float to a scaled 16-bit integer, rounding to nearest.
+ * Values outside of the range are saturated.
+ * @param value Value.
+ * @param range Range.
+ * @return Scaled 16-bit integer as two's complement.
+ */
+static inline uint16_t FloatToInt16(const float value, const float range) {
+    const float scaled = value * (32767.0f / range);
+    int16_t integer;
+    if (scaled != scaled) {
+        integer = 0; // NaN
+    } else if (scaled >= 32767.0f) {
+        integer = 32767;
+    } else if (scaled <= -32767.0f) {
+        integer = -32767;
+    } else {
+        integer = (int16_t) (scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+    }
+    return (uint16_t) integer;
+}
+
+/**
+ * @brief Writes an unsigned LEB128 varint.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param value Value.
+ */
+static inline void WriteVarint(void* const destination, const size_t destinationSize, size_t * const destinationIndex, uint32_t value) {
+    do {
+        WriteByte(destination, destinationSize, destinationIndex, (uint8_t) ((value & 0x7F) | (value > 0x7F ? 0x80 : 0x00)));
+        value >>= 7;
+    } while (value > 0);
+}
+
+/**
+ * @brief Writes a string.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param string String.
+ */
+static inline void WriteString(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const char* string) {
+    if (string == NULL) {
+        return;
+    }
+    WriteBytes(destination, destinationSize, destinationIndex, (const uint8_t*) string, strlen(string));
+}
+
+/**
+ * @brief Writes the termination.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ */
+static inline void WriteTermination(void* const destination, const size_t destinationSize, size_t * const destinationIndex) {
+    if (*destinationIndex >= destinationSize) {
+        if (destinationSize > 0) {
+            ((uint8_t*) destination)[destinationSize - 1] = BYTE_STUFFING_END;
+        }
+        return;
+    }
+    ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_END;
+}
+
+/**
+ * @brief Writes bytes with byte stuffing. The output is identical to writing
+ * each byte with WriteByte, including when the destination is full.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param bytes Bytes.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline void WriteBytes(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t* bytes, const size_t numberOfBytes) {
+    if ((*destinationIndex <= destinationSize) && (numberOfBytes <= (destinationSize - *destinationIndex)) && (NumberOfUnstuffedBytes(bytes, numberOfBytes) == numberOfBytes)) {
+        memcpy(&((uint8_t*) destination)[*destinationIndex], bytes, numberOfBytes);
+        *destinationIndex += numberOfBytes;
+        return;
+    }
+    WriteStuffedBytes(destination, destinationSize, destinationIndex, bytes, numberOfBytes);
+}
+
+/**
+ * @brief Writes bytes with byte stuffing when one or more bytes require byte
+ * stuffing or the destination is full. Runs of bytes that do not require byte
+ * stuffing are copied in one operation.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param bytes Bytes.
+ * @param numberOfBytes Number of bytes.
+ */
+static void WriteStuffedBytes(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t* bytes, const size_t numberOfBytes) {
+    const uint8_t * const end = bytes + numberOfBytes;
+    while (bytes < end) {
+
+        // Copy bytes that do not require byte stuffing
+        const size_t run = NumberOfUnstuffedBytes(bytes, (size_t) (end - bytes));
+        const size_t available = *destinationIndex < destinationSize ? destinationSize - *destinationIndex : 0;
+        const size_t count = run < available ? run : available;
+        if (count > 0) {
+            memcpy(&((uint8_t*) destination)[*destinationIndex], bytes, count);
+            *destinationIndex += count;
+        }
+        bytes += run;
+
+        // Write byte that requires byte stuffing
+        if (bytes < end) {
+            WriteByte(destination, destinationSize, destinationIndex, *bytes++);
+        }
+    }
+}
+
+/**
+ * @brief Applies byte stuffing in place. The bytes must be large enough for
+ * the worst case.
+ * @param bytes Bytes.
+ * @param numberOfBytes Number of bytes before byte stuffing.
+ * @return Number of bytes after byte stuffing.
+ */
+static inline size_t StuffInPlace(uint8_t * const bytes, const size_t numberOfBytes) {
+    const size_t index = NumberOfUnstuffedBytes(bytes, numberOfBytes);
+    if (index == numberOfBytes) {
+        return numberOfBytes;
+    }
+    return StuffInPlaceFrom(bytes, numberOfBytes, index);
+}
+
+/**
+ * @brief Applies byte stuffing in place from the first byte that requires byte
+ * stuffing. The bytes are moved from the last to the first so that no byte is
+ * overwritten before it is moved.
+ * @param bytes Bytes.
+ * @param numberOfBytes Number of bytes before byte stuffing.
+ * @param index Index of the first byte that requires byte stuffing.
+ * @return Number of bytes after byte stuffing.
+ */
+static size_t StuffInPlaceFrom(uint8_t * const bytes, const size_t numberOfBytes, const size_t index) {
+    size_t numberOfStuffedBytes = numberOfBytes;
+    for (size_t byteIndex = index; byteIndex < numberOfBytes; byteIndex++) {
+        numberOfStuffedBytes += (bytes[byteIndex] == BYTE_STUFFING_END) || (bytes[byteIndex] == BYTE_STUFFING_ESC);
+    }
+    size_t stuffedIndex = numberOfStuffedBytes;
+    for (size_t byteIndex = numberOfBytes; byteIndex > index; byteIndex--) {
+        const uint8_t byte = bytes[byteIndex - 1];
+        switch (byte) {
+            case BYTE_STUFFING_END:
+                bytes[--stuffedIndex] = BYTE_STUFFING_ESC_END;
+                bytes[--stuffedIndex] = BYTE_STUFFING_ESC;
+                break;
+            case BYTE_STUFFING_ESC:
+                bytes[--stuffedIndex] = BYTE_STUFFING_ESC_ESC;
+                bytes[--stuffedIndex] = BYTE_STUFFING_ESC;
+                break;
+            default:
+                bytes[--stuffedIndex] = byte;
+                break;
+        }
+    }
+    return numberOfStuffedBytes;
+}
+
+/**
+ * @brief Returns the number of leading bytes that do not require byte
+ * stuffing. Bytes are scanned 16 at a time using SSE2 or NEON where available,
+ * and then one machine word at a time. A 32-bit word is zero-extended when
+ * scanned as a 64-bit word, which cannot create a false match.
+ * @param bytes Bytes.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of leading bytes that do not require byte stuffing.
+ */
+static inline size_t NumberOfUnstuffedBytes(const uint8_t * const bytes, const size_t numberOfBytes) {
+    size_t index = 0;
+#if defined(BYTE_STUFFING_SSE2)
+    const __m128i end = _mm_set1_epi8((char) BYTE_STUFFING_END);
+    const __m128i esc = _mm_set1_epi8((char) BYTE_STUFFING_ESC);
+    while ((numberOfBytes - index) >= 16) {
+        const __m128i block = _mm_loadu_si128((const __m128i*) &bytes[index]);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, end), _mm_cmpeq_epi8(block, esc))) != 0) {
+            break;
+        }
+        index += 16;
+    }
+#elif defined(BYTE_STUFFING_NEON)
+    const uint8x16_t end = vdupq_n_u8(BYTE_STUFFING_END);
+    const uint8x16_t esc = vdupq_n_u8(BYTE_STUFFING_ESC);
+    while ((numberOfBytes - index) >= 16) {
+        const uint8x16_t block = vld1q_u8(&bytes[index]);
+        const uint8x16_t matches = vorrq_u8(vceqq_u8(block, end), vceqq_u8(block, esc));
+        if (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0) != 0) {
+            break;
+        }
+        index += 16;
+    }
+#endif
+    while ((numberOfBytes - index) >= sizeof (Word)) {
+        Word word;
+        memcpy(&word, &bytes[index], sizeof (word));
+        if (WordContains(word, BYTE_STUFFING_END) || WordContains(word, BYTE_STUFFING_ESC)) {
+            break;
+        }
+        index += sizeof (Word);
+    }
+    if ((sizeof (Word) > sizeof (uint32_t)) && ((numberOfBytes - index) >= sizeof (uint32_t))) {
+        uint32_t word;
+        memcpy(&word, &bytes[index], sizeof (word));
+        if ((WordContains(word, BYTE_STUFFING_END) == false) && (WordContains(word, BYTE_STUFFING_ESC) == false)) {
+            index += sizeof (uint32_t);
+        }
+    }
+    while ((index < numberOfBytes) && (bytes[index] != BYTE_STUFFING_END) && (bytes[index] != BYTE_STUFFING_ESC)) {
+        index++;
+    }
+    return index;
+}
+
+/**
+ * @brief Returns true if any byte of the word is equal to the byte.
+ * @param word Word.
+ * @param byte Byte.
+ * @return True if any byte of the word is equal to the byte.
+ */
+static inline bool WordContains(const Word word, const uint8_t byte) {
+    const Word ones = ((Word) ~(Word) 0) / 0xFF; // 0x0101...
+    const Word difference = word ^ (ones * byte);
+    return ((difference - ones) & ~difference & (ones * 0x80)) != 0;
+}
+
+/**
+ * @brief Writes a byte with byte stuffing.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param byte Byte.
+ */
+static inline void WriteByte(void* const destination, const size_t destinationSize, size_t * const destinationIndex, const uint8_t byte) {
+    switch (byte) {
+        case BYTE_STUFFING_END:
+            if ((*destinationIndex + 1) >= destinationSize) {
+                return;
+            }
+            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC;
+            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC_END;
+            break;
+        case BYTE_STUFFING_ESC:
+            if ((*destinationIndex + 1) >= destinationSize) {
+                return;
+            }
+            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC;
+            ((uint8_t*) destination)[(*destinationIndex)++] = BYTE_STUFFING_ESC_ESC;
+            break;
+        default:
+            if (*destinationIndex >= destinationSize) {
+                return;
             }
             ((uint8_t*) destination)[(*destinationIndex)++] = byte;
             break;
     }
 }
 
+/**
+ * @brief Writes bytes with COBS. The code byte of the current block is
+ * written when the block ends. Runs of bytes that are not the termination are
+ * copied in one operation.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param destinationIndex Destination index.
+ * @param codeIndex Index of the code byte of the current block.
+ * @param bytes Bytes.
+ * @param numberOfBytes Number of bytes.
+ * @return True if the bytes were written, false if the destination is too
+ * small.
+ */
+static bool CobsBytes(uint8_t * const destination, const size_t destinationSize, size_t * const destinationIndex, size_t * const codeIndex, const uint8_t* bytes, size_t numberOfBytes) {
+    while (numberOfBytes > 0) {
+
+        // Copy bytes up to the termination or the end of the block
+        const uint8_t * const end = memchr(bytes, BYTE_STUFFING_END, numberOfBytes);
+        const size_t available = 0xFF - (*destinationIndex - *codeIndex);
+        size_t run = end == NULL ? numberOfBytes : (size_t) (end - bytes);
+        run = run < available ? run : available;
+        if (run > (destinationSize - *destinationIndex)) {
+            return false;
+        }
+        memcpy(&destination[*destinationIndex], bytes, run);
+        *destinationIndex += run;
+        bytes += run;
+        numberOfBytes -= run;
+
+        // End block if full or at the termination
+        const bool full = run == available;
+        if ((full == false) && (numberOfBytes == 0)) {
+            break;
+        }
+        if (*destinationIndex >= destinationSize) {
+            return false;
+        }
+        destination[*codeIndex] = (uint8_t) (*destinationIndex - *codeIndex) ^ BYTE_STUFFING_END;
+        *codeIndex = (*destinationIndex)++;
+        if (full == false) {
+            bytes++; // skip termination
+            numberOfBytes--;
+        }
+    }
+    return true;
+}
+
 //------------------------------------------------------------------------------
 // End of file
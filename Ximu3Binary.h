@@ -10,12 +10,149 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include "Ximu3CompactTimestamp.h"
 #include "Ximu3Data.h"
+#include "Ximu3Descriptor.h"
+#include "Ximu3Intern.h"
+#include "Ximu3Size.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Payload format of sensor and AHRS messages. Values correspond to the
+ * binary payload format setting.
+ */
+typedef enum {
+    Ximu3BinaryPayloadFormatFloat32,
+    Ximu3BinaryPayloadFormatFloat16,
+    Ximu3BinaryPayloadFormatInt16,
+} Ximu3BinaryPayloadFormat;
+
+/**
+ * @brief Quaternion compression of quaternion, linear acceleration and Earth
+ * acceleration messages. Values correspond to the binary quaternion
+ * compression setting.
+ */
+typedef enum {
+    Ximu3BinaryQuaternionCompressionNone,
+    Ximu3BinaryQuaternionCompression32Bit,
+    Ximu3BinaryQuaternionCompression48Bit,
+} Ximu3BinaryQuaternionCompression;
+
+/**
+ * @brief Framing of binary data messages. Values correspond to the binary
+ * framing settings of each interface.
+ */
+typedef enum {
+    Ximu3BinaryFramingByteStuffing,
+    Ximu3BinaryFramingCobs,
+} Ximu3BinaryFraming;
+
+/**
+ * @brief Full-scale ranges of the Ximu3BinaryPayloadFormatInt16 payload format.
+ * Each value is scaled so that the range maps to +/-32767. Values outside of
+ * the range are saturated.
+ */
+#define XIMU3_BINARY_RANGE_GYROSCOPE            (2000.0f) /* degrees per second */
+#define XIMU3_BINARY_RANGE_ACCELEROMETER        (16.0f) /* g */
+#define XIMU3_BINARY_RANGE_MAGNETOMETER         (16.0f) /* a.u. */
+#define XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER (400.0f) /* g */
+#define XIMU3_BINARY_RANGE_QUATERNION           (1.0f)
+#define XIMU3_BINARY_RANGE_ROTATION_MATRIX      (1.0f)
+#define XIMU3_BINARY_RANGE_EULER_ANGLES         (180.0f) /* degrees */
+#define XIMU3_BINARY_RANGE_TEMPERATURE          (200.0f) /* degrees Celsius */
+
+/**
+ * @brief Compressed quaternion. The index of the largest component (0 = w,
+ * 1 = x, 2 = y, 3 = z) is written in the two most significant bits, followed
+ * by the other three components in order. Each component is multiplied by
+ * sqrt(2) and quantised as an offset binary integer. The sign of the
+ * quaternion is chosen so that the largest component is positive, allowing the
+ * receiver to reconstruct it. The 48-bit format has one unused least
+ * significant bit. Written as little-endian.
+ */
+#define XIMU3_BINARY_COMPRESSED_QUATERNION_32_BIT_BITS (10) /* bits per component */
+#define XIMU3_BINARY_COMPRESSED_QUATERNION_48_BIT_BITS (15) /* bits per component */
+
+/**
+ * @brief Flags of packed boolean messages.
+ */
+#define XIMU3_BINARY_FLAG_INITIALISING              (1 << 0)
+#define XIMU3_BINARY_FLAG_ANGULAR_RATE_RECOVERY     (1 << 1)
+#define XIMU3_BINARY_FLAG_ACCELERATION_RECOVERY     (1 << 2)
+#define XIMU3_BINARY_FLAG_MAGNETIC_RECOVERY         (1 << 3)
+#define XIMU3_BINARY_FLAG_EDGE                      (1 << 0)
+#define XIMU3_BINARY_FLAG_STATE                     (1 << 0)
+
+/**
+ * @brief Presence bitmask of composite messages. Payloads are written in the
+ * order of the bits. XIMU3_BINARY_COMPOSITE_16_BIT indicates a 16-bit payload
+ * format.
+ */
+#define XIMU3_BINARY_COMPOSITE_INERTIAL             (1 << 0)
+#define XIMU3_BINARY_COMPOSITE_MAGNETOMETER         (1 << 1)
+#define XIMU3_BINARY_COMPOSITE_HIGH_G_ACCELEROMETER (1 << 2)
+#define XIMU3_BINARY_COMPOSITE_TEMPERATURE          (1 << 3)
+#define XIMU3_BINARY_COMPOSITE_QUATERNION           (1 << 4)
+#define XIMU3_BINARY_COMPOSITE_ROTATION_MATRIX      (1 << 5)
+#define XIMU3_BINARY_COMPOSITE_EULER_ANGLES         (1 << 6)
+#define XIMU3_BINARY_COMPOSITE_LINEAR_ACCELERATION  (1 << 7)
+#define XIMU3_BINARY_COMPOSITE_EARTH_ACCELERATION   (1 << 8)
+#define XIMU3_BINARY_COMPOSITE_16_BIT               (1 << 15)
+
+/**
+ * @brief Maximum timestamp offset of a sample within an aggregate message.
+ * This is the maximum value of a 3-byte varint.
+ */
+#define XIMU3_BINARY_AGGREGATE_MAX_OFFSET ((UINT32_C(1) << 21) - 1)
+
+/**
+ * @brief Aggregator. Consecutive samples of the same message type are written
+ * as a single aggregate message containing one header, the timestamp of the
+ * first sample, and each sample as a timestamp offset followed by the payload.
+ * The message is passed to the write callback when either threshold is
+ * reached, or when a sample cannot be added, e.g. because the message type
+ * changes.
+ */
+typedef struct {
+    size_t maximumNumberOfSamples; // flush threshold in samples, 0 if unused
+    size_t maximumSize; // flush threshold in bytes, 0 if unused
+    Ximu3BinaryPayloadFormat payloadFormat;
+    void (*const write) (const void* const data, const size_t numberOfBytes, void* const context);
+    void* context;
+    uint8_t buffer[XIMU3_SIZE_BINARY_AGGREGATE]; // private
+    size_t index; // private
+    size_t numberOfSamples; // private
+    uint8_t sampleId; // private
+    uint64_t timestamp; // private
+} Ximu3BinaryAggregator;
+
+/**
+ * @brief Serial accessory stream. Payload bytes are appended as they are
+ * received, e.g. from a UART DMA ring, and are byte stuffed directly into the
+ * message. The message is passed to the write callback when the maximum number
+ * of bytes is reached, and the remaining bytes start a new message with the
+ * same timestamp.
+ */
+typedef struct {
+    size_t maximumNumberOfBytes; // payload bytes per message, 0 for XIMU3_SIZE_CHAR_ARRAY
+    void (*const write) (const void* const data, const size_t numberOfBytes, void* const context);
+    void* context;
+    uint8_t buffer[XIMU3_SIZE_BINARY_SERIAL_ACCESSORY]; // private
+    size_t index; // private
+    size_t numberOfBytes; // private
+    uint64_t timestamp; // private
+    bool started; // private
+} Ximu3BinarySerialAccessoryStream;
 
 //------------------------------------------------------------------------------
 // Function declarations
 
+size_t Ximu3BinaryMessage(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data);
 size_t Ximu3BinaryInertial(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data);
 size_t Ximu3BinaryMagnetometer(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data);
 size_t Ximu3BinaryHighGAccelerometer(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data);
@@ -34,6 +171,59 @@ size_t Ximu3BinaryRssi(void* const destination, const size_t destinationSize, co
 size_t Ximu3BinaryButton(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data);
 size_t Ximu3BinaryNotification(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data);
 size_t Ximu3BinaryError(void* const destination, const size_t destinationSize, const Ximu3DataError * const data);
+size_t Ximu3BinaryInertialPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryMagnetometerPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryHighGAccelerometerPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryQuaternionPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryRotationMatrixPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryEulerAnglesPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryLinearAccelerationPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryEarthAccelerationPayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryTemperaturePayloadFormat(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryQuaternionCompressed(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const Ximu3BinaryPayloadFormat payloadFormat, const Ximu3BinaryQuaternionCompression quaternionCompression);
+size_t Ximu3BinaryLinearAccelerationCompressed(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const Ximu3BinaryPayloadFormat payloadFormat, const Ximu3BinaryQuaternionCompression quaternionCompression);
+size_t Ximu3BinaryEarthAccelerationCompressed(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const Ximu3BinaryPayloadFormat payloadFormat, const Ximu3BinaryQuaternionCompression quaternionCompression);
+size_t Ximu3BinaryAhrsStatusPacked(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data);
+size_t Ximu3BinarySyncPacked(void* const destination, const size_t destinationSize, const Ximu3DataSync * const data);
+size_t Ximu3BinaryButtonPacked(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data);
+size_t Ximu3BinaryLtcPacked(void* const destination, const size_t destinationSize, const Ximu3DataLtc * const data);
+size_t Ximu3BinaryNotificationInterned(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data, Ximu3Intern * const intern);
+size_t Ximu3BinaryErrorInterned(void* const destination, const size_t destinationSize, const Ximu3DataError * const data, Ximu3Intern * const intern);
+void Ximu3BinaryAggregatorInertial(Ximu3BinaryAggregator * const aggregator, const Ximu3DataInertial * const data);
+void Ximu3BinaryAggregatorMagnetometer(Ximu3BinaryAggregator * const aggregator, const Ximu3DataMagnetometer * const data);
+void Ximu3BinaryAggregatorHighGAccelerometer(Ximu3BinaryAggregator * const aggregator, const Ximu3DataHighGAccelerometer * const data);
+void Ximu3BinaryAggregatorQuaternion(Ximu3BinaryAggregator * const aggregator, const Ximu3DataQuaternion * const data);
+void Ximu3BinaryAggregatorRotationMatrix(Ximu3BinaryAggregator * const aggregator, const Ximu3DataRotationMatrix * const data);
+void Ximu3BinaryAggregatorEulerAngles(Ximu3BinaryAggregator * const aggregator, const Ximu3DataEulerAngles * const data);
+void Ximu3BinaryAggregatorLinearAcceleration(Ximu3BinaryAggregator * const aggregator, const Ximu3DataLinearAcceleration * const data);
+void Ximu3BinaryAggregatorEarthAcceleration(Ximu3BinaryAggregator * const aggregator, const Ximu3DataEarthAcceleration * const data);
+void Ximu3BinaryAggregatorTemperature(Ximu3BinaryAggregator * const aggregator, const Ximu3DataTemperature * const data);
+void Ximu3BinaryAggregatorFlush(Ximu3BinaryAggregator * const aggregator);
+void Ximu3BinarySerialAccessoryBegin(Ximu3BinarySerialAccessoryStream * const stream, const uint64_t timestamp);
+void Ximu3BinarySerialAccessoryAppend(Ximu3BinarySerialAccessoryStream * const stream, const void* const data, const size_t numberOfBytes);
+void Ximu3BinarySerialAccessoryEnd(Ximu3BinarySerialAccessoryStream * const stream);
+size_t Ximu3BinaryComposite(void* const destination, const size_t destinationSize, const Ximu3DataComposite * const data, const Ximu3BinaryPayloadFormat payloadFormat);
+size_t Ximu3BinaryCompactTimestamp(Ximu3CompactTimestamp * const compactTimestamp, void* const message, const size_t messageSize);
+size_t Ximu3BinaryCobs(void* const destination, const size_t destinationSize, const void* const message, const size_t messageSize);
+size_t Ximu3BinaryMessageCobs(void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data);
+size_t Ximu3BinaryInertialBatch(void* const destination, const size_t destinationSize, const Ximu3DataInertial * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryMagnetometerBatch(void* const destination, const size_t destinationSize, const Ximu3DataMagnetometer * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryHighGAccelerometerBatch(void* const destination, const size_t destinationSize, const Ximu3DataHighGAccelerometer * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryQuaternionBatch(void* const destination, const size_t destinationSize, const Ximu3DataQuaternion * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryRotationMatrixBatch(void* const destination, const size_t destinationSize, const Ximu3DataRotationMatrix * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryEulerAnglesBatch(void* const destination, const size_t destinationSize, const Ximu3DataEulerAngles * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryLinearAccelerationBatch(void* const destination, const size_t destinationSize, const Ximu3DataLinearAcceleration * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryEarthAccelerationBatch(void* const destination, const size_t destinationSize, const Ximu3DataEarthAcceleration * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryAhrsStatusBatch(void* const destination, const size_t destinationSize, const Ximu3DataAhrsStatus * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinarySerialAccessoryBatch(void* const destination, const size_t destinationSize, const Ximu3DataSerialAccessory * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinarySyncBatch(void* const destination, const size_t destinationSize, const Ximu3DataSync * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryLtcBatch(void* const destination, const size_t destinationSize, const Ximu3DataLtc * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryTemperatureBatch(void* const destination, const size_t destinationSize, const Ximu3DataTemperature * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryBatteryBatch(void* const destination, const size_t destinationSize, const Ximu3DataBattery * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryRssiBatch(void* const destination, const size_t destinationSize, const Ximu3DataRssi * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryButtonBatch(void* const destination, const size_t destinationSize, const Ximu3DataButton * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryNotificationBatch(void* const destination, const size_t destinationSize, const Ximu3DataNotification * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
+size_t Ximu3BinaryErrorBatch(void* const destination, const size_t destinationSize, const Ximu3DataError * const data, const size_t numberOfMessages, size_t * const numberOfMessagesWritten);
 
 #endif
 
@@ -0,0 +1,1274 @@
+/**
+ * @file Ximu3BinaryDecoder.c
+ * @author Seb Madgwick
+ * @brief x-IMU3 binary data message decoder.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "Ximu3Ascii.h"
+#include "Ximu3Binary.h"
+#include "Ximu3BinaryDecoder.h"
+#include "Ximu3Definitions.h"
+#include "Ximu3Ltc.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+#define BYTE_STUFFING_END       XIMU3_TERMINATION
+#define BYTE_STUFFING_ESC       (0xDB)
+#define BYTE_STUFFING_ESC_END   (0xDC)
+#define BYTE_STUFFING_ESC_ESC   (0xDD)
+
+#define HEADER_SIZE             (1 + sizeof (uint64_t)) /* ID + 64-bit timestamp */
+
+/**
+ * @brief Message parser. Returns an error if the payload size is invalid.
+ */
+typedef Ximu3Result(*Parser) (const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline void Receive(Ximu3BinaryDecoder * const decoder, const uint8_t * const source, const size_t numberOfBytes);
+static void Unstuff(Ximu3BinaryDecoder * const decoder, const uint8_t* source, const size_t numberOfBytes);
+static Ximu3Result CobsDecode(Ximu3BinaryDecoder * const decoder);
+static void Unescape(Ximu3BinaryDecoder * const decoder, const uint8_t byte);
+static void Append(Ximu3BinaryDecoder * const decoder, const void* const data, const size_t numberOfBytes);
+static void ParseMessage(Ximu3BinaryDecoder * const decoder);
+static Ximu3Result ParseInertial(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseMagnetometer(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseHighGAccelerometer(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseQuaternion(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseRotationMatrix(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseEulerAngles(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseLinearAcceleration(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseEarthAcceleration(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseAhrsStatus(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseSerialAccessory(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseSync(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseLtc(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseTemperature(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseBattery(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseRssi(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseButton(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseNotification(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseError(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseAggregate(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseComposite(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ParseCustom(const Ximu3BinaryDecoder * const decoder, const Ximu3Descriptor * const descriptor, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp);
+static Ximu3Result ResolveInterned(Ximu3BinaryDecoder * const decoder, uint8_t * const payload, size_t * const payloadSize);
+static Ximu3Result ReadValues(const Ximu3BinaryDecoder * const decoder, const uint8_t * const payload, const size_t payloadSize, float * const values, const float * const ranges, const size_t numberOfValues);
+static size_t ReadCompressedQuaternion(const uint8_t * const payload, const size_t payloadSize, const size_t numberOfValues, float * const quaternion);
+static inline float HalfToFloat(const uint16_t half);
+static size_t ReadTimestampDelta(const Ximu3BinaryDecoder * const decoder, uint64_t * const delta);
+static size_t ReadVarint(const uint8_t * const source, const size_t numberOfBytes, uint32_t * const value);
+static inline uint64_t ReadTimestamp(const uint8_t * const source);
+static inline float ReadFloat(const uint8_t * const source);
+static void Error(const Ximu3BinaryDecoder * const decoder, const char* const format, ...);
+
+//------------------------------------------------------------------------------
+// Variables
+
+/**
+ * @brief Parsers indexed by ASCII ID, i.e. the binary ID minus 0x80.
+ */
+static const Parser parsers[128] = {
+    [XIMU3_ASCII_ID_INERTIAL] = ParseInertial,
+    [XIMU3_ASCII_ID_MAGNETOMETER] = ParseMagnetometer,
+    [XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER] = ParseHighGAccelerometer,
+    [XIMU3_ASCII_ID_QUATERNION] = ParseQuaternion,
+    [XIMU3_ASCII_ID_ROTATION_MATRIX] = ParseRotationMatrix,
+    [XIMU3_ASCII_ID_EULER_ANGLES] = ParseEulerAngles,
+    [XIMU3_ASCII_ID_LINEAR_ACCELERATION] = ParseLinearAcceleration,
+    [XIMU3_ASCII_ID_EARTH_ACCELERATION] = ParseEarthAcceleration,
+    [XIMU3_ASCII_ID_AHRS_STATUS] = ParseAhrsStatus,
+    [XIMU3_ASCII_ID_SERIAL_ACCESSORY] = ParseSerialAccessory,
+    [XIMU3_ASCII_ID_SYNC] = ParseSync,
+    [XIMU3_ASCII_ID_LTC] = ParseLtc,
+    [XIMU3_ASCII_ID_TEMPERATURE] = ParseTemperature,
+    [XIMU3_ASCII_ID_BATTERY] = ParseBattery,
+    [XIMU3_ASCII_ID_RSSI] = ParseRssi,
+    [XIMU3_ASCII_ID_BUTTON] = ParseButton,
+    [XIMU3_ASCII_ID_NOTIFICATION] = ParseNotification,
+    [XIMU3_ASCII_ID_ERROR] = ParseError,
+    [XIMU3_ASCII_ID_AGGREGATE] = ParseAggregate,
+    [XIMU3_ASCII_ID_COMPOSITE] = ParseComposite,
+};
+
+/**
+ * @brief Number of values of each message type of an aggregate or composite
+ * message, indexed by ASCII ID.
+ */
+static const uint8_t numberOfSampleValues[128] = {
+    [XIMU3_ASCII_ID_INERTIAL] = 6,
+    [XIMU3_ASCII_ID_MAGNETOMETER] = 3,
+    [XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER] = 3,
+    [XIMU3_ASCII_ID_QUATERNION] = 4,
+    [XIMU3_ASCII_ID_ROTATION_MATRIX] = 9,
+    [XIMU3_ASCII_ID_EULER_ANGLES] = 3,
+    [XIMU3_ASCII_ID_LINEAR_ACCELERATION] = 7,
+    [XIMU3_ASCII_ID_EARTH_ACCELERATION] = 7,
+    [XIMU3_ASCII_ID_TEMPERATURE] = 1,
+};
+
+/**
+ * @brief ASCII ID of each bit of the presence bitmask of a composite message.
+ */
+static const char compositeIds[] = {
+    XIMU3_ASCII_ID_INERTIAL,
+    XIMU3_ASCII_ID_MAGNETOMETER,
+    XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER,
+    XIMU3_ASCII_ID_TEMPERATURE,
+    XIMU3_ASCII_ID_QUATERNION,
+    XIMU3_ASCII_ID_ROTATION_MATRIX,
+    XIMU3_ASCII_ID_EULER_ANGLES,
+    XIMU3_ASCII_ID_LINEAR_ACCELERATION,
+    XIMU3_ASCII_ID_EARTH_ACCELERATION,
+};
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Processes received data. The data may be fragmented arbitrarily. A
+ * callback is called for each complete message.
+ * @param decoder Decoder.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+void Ximu3BinaryDecoderProcess(Ximu3BinaryDecoder * const decoder, const void* const data, const size_t numberOfBytes) {
+    const uint8_t* source = data;
+    const uint8_t * const end = source + numberOfBytes;
+    while (source < end) {
+
+        // Receive bytes up to next termination
+        const uint8_t * const termination = memchr(source, BYTE_STUFFING_END, (size_t) (end - source));
+        if (termination == NULL) {
+            Receive(decoder, source, (size_t) (end - source));
+            return;
+        }
+        Receive(decoder, source, (size_t) (termination - source));
+        source = termination + 1;
+
+        // Parse message
+        ParseMessage(decoder);
+        decoder->index = 0;
+        decoder->escape = false;
+        decoder->discard = false;
+    }
+}
+
+/**
+ * @brief Discards any partially received message, the previous timestamp and
+ * the interned strings. This should be called when the interface reconnects.
+ * @param decoder Decoder.
+ */
+void Ximu3BinaryDecoderReset(Ximu3BinaryDecoder * const decoder) {
+    decoder->index = 0;
+    decoder->escape = false;
+    decoder->discard = false;
+    decoder->timestampValid = false;
+    for (int index = 0; index < XIMU3_INTERN_NUMBER_OF_STRINGS; index++) {
+        decoder->interned[index][0] = '\0';
+    }
+}
+
+/**
+ * @brief Appends received bytes to the buffer. Byte stuffing is removed as the
+ * bytes are received. COBS is removed once the message is complete.
+ * @param decoder Decoder.
+ * @param source Source.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline void Receive(Ximu3BinaryDecoder * const decoder, const uint8_t * const source, const size_t numberOfBytes) {
+    if (decoder->framing == Ximu3BinaryFramingCobs) {
+        Append(decoder, source, numberOfBytes);
+        return;
+    }
+    Unstuff(decoder, source, numberOfBytes);
+}
+
+/**
+ * @brief Removes byte stuffing and appends the result to the buffer. Runs of
+ * bytes that contain no escape sequence are copied in one operation.
+ * @param decoder Decoder.
+ * @param source Source.
+ * @param numberOfBytes Number of bytes.
+ */
+static void Unstuff(Ximu3BinaryDecoder * const decoder, const uint8_t* source, const size_t numberOfBytes) {
+    const uint8_t * const end = source + numberOfBytes;
+
+    // Complete escape sequence split across calls
+    if (decoder->escape && (source < end)) {
+        decoder->escape = false;
+        Unescape(decoder, *source++);
+    }
+
+    // Copy runs between escape sequences
+    while ((source < end) && (decoder->discard == false)) {
+        const uint8_t * const escape = memchr(source, BYTE_STUFFING_ESC, (size_t) (end - source));
+        if (escape == NULL) {
+            Append(decoder, source, (size_t) (end - source));
+            return;
+        }
+        Append(decoder, source, (size_t) (escape - source));
+        source = escape + 1;
+        if (source == end) {
+            decoder->escape = true;
+            return;
+        }
+        Unescape(decoder, *source++);
+    }
+}
+
+/**
+ * @brief Appends the byte represented by an escape sequence.
+ * @param decoder Decoder.
+ * @param byte Byte following the escape byte.
+ */
+static void Unescape(Ximu3BinaryDecoder * const decoder, const uint8_t byte) {
+    switch (byte) {
+        case BYTE_STUFFING_ESC_END:
+        {
+            const uint8_t end = BYTE_STUFFING_END;
+            Append(decoder, &end, 1);
+            break;
+        }
+        case BYTE_STUFFING_ESC_ESC:
+        {
+            const uint8_t esc = BYTE_STUFFING_ESC;
+            Append(decoder, &esc, 1);
+            break;
+        }
+        default:
+            if (decoder->discard == false) {
+                Error(decoder, "Binary decode error. Invalid escape sequence 0x%02X 0x%02X.", BYTE_STUFFING_ESC, byte);
+            }
+            decoder->discard = true;
+            break;
+    }
+}
+
+/**
+ * @brief Removes COBS from the timestamp and payload of the message in the
+ * buffer, in place. Each code byte is XORed with the termination.
+ * @param decoder Decoder.
+ * @return Result.
+ */
+static Ximu3Result CobsDecode(Ximu3BinaryDecoder * const decoder) {
+    size_t sourceIndex = 1;
+    size_t destinationIndex = 1;
+    while (sourceIndex < decoder->index) {
+        const size_t code = decoder->buffer[sourceIndex++] ^ BYTE_STUFFING_END;
+        const size_t numberOfBytes = code - 1;
+        if (numberOfBytes > (decoder->index - sourceIndex)) {
+            return Ximu3ResultError;
+        }
+        memmove(&decoder->buffer[destinationIndex], &decoder->buffer[sourceIndex], numberOfBytes);
+        sourceIndex += numberOfBytes;
+        destinationIndex += numberOfBytes;
+        if ((code < 0xFF) && (sourceIndex < decoder->index)) {
+            decoder->buffer[destinationIndex++] = BYTE_STUFFING_END;
+        }
+    }
+    decoder->index = destinationIndex;
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Appends bytes to the buffer. The message is discarded until the next
+ * termination if the buffer overruns. One byte of the buffer is reserved for
+ * null-terminating string payloads.
+ * @param decoder Decoder.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+static void Append(Ximu3BinaryDecoder * const decoder, const void* const data, const size_t numberOfBytes) {
+    if (decoder->discard) {
+        return;
+    }
+    if (numberOfBytes > (sizeof (decoder->buffer) - 1 - decoder->index)) {
+        Error(decoder, "Binary decode error. Buffer overrun.");
+        decoder->discard = true;
+        return;
+    }
+    memcpy(&decoder->buffer[decoder->index], data, numberOfBytes);
+    decoder->index += numberOfBytes;
+}
+
+/**
+ * @brief Parses the message in the buffer. The timestamp of a compact message
+ * is the sum of the timestamp delta and the timestamp of the previous message.
+ * The previous timestamp is invalidated by any error so that a compact message
+ * is never decoded relative to a lost message.
+ * @param decoder Decoder.
+ */
+static void ParseMessage(Ximu3BinaryDecoder * const decoder) {
+    if (decoder->index == 0) {
+        return;
+    }
+    if (decoder->discard) {
+        decoder->timestampValid = false;
+        return;
+    }
+    if (decoder->escape) {
+        Error(decoder, "Binary decode error. Unexpected termination after escape byte.");
+        decoder->timestampValid = false;
+        return;
+    }
+    const uint8_t id = decoder->buffer[0];
+    if (id < 0x80) {
+        return; // not a binary data message, e.g. command response
+    }
+    if ((decoder->framing == Ximu3BinaryFramingCobs) && (CobsDecode(decoder) != Ximu3ResultOk)) {
+        Error(decoder, "Binary decode error. Invalid COBS code for ID 0x%02X.", id);
+        decoder->timestampValid = false;
+        return;
+    }
+    const bool compact = (id >= (0x80 + 'a')) && (id <= (0x80 + 'z'));
+    const char asciiId = (char) ((compact ? (id & ~0x20) : id) - 0x80);
+    const Parser parser = parsers[(int) asciiId];
+    const Ximu3Descriptor * const descriptor = parser == NULL ? Ximu3DescriptorFind(asciiId) : NULL;
+    if ((parser == NULL) && (descriptor == NULL)) {
+        Error(decoder, "Binary decode error. Unknown message ID 0x%02X.", id);
+        decoder->timestampValid = false;
+        return;
+    }
+    uint64_t timestamp;
+    size_t headerSize;
+    if (compact) {
+        headerSize = ReadTimestampDelta(decoder, &timestamp);
+        if (headerSize == 0) {
+            Error(decoder, "Binary decode error. Invalid timestamp delta for ID 0x%02X.", id);
+            decoder->timestampValid = false;
+            return;
+        }
+        if (decoder->timestampValid == false) {
+            Error(decoder, "Binary decode error. No previous timestamp for ID 0x%02X.", id);
+            return;
+        }
+        timestamp += decoder->timestamp;
+    } else {
+        if (decoder->index < HEADER_SIZE) {
+            Error(decoder, "Binary decode error. Invalid message length for ID 0x%02X.", id);
+            decoder->timestampValid = false;
+            return;
+        }
+        headerSize = HEADER_SIZE;
+        timestamp = ReadTimestamp(&decoder->buffer[1]);
+    }
+    decoder->timestamp = timestamp;
+    decoder->timestampValid = true;
+    uint8_t * const payload = &decoder->buffer[headerSize];
+    size_t payloadSize = decoder->index - headerSize;
+    if (((asciiId == XIMU3_ASCII_ID_NOTIFICATION) || (asciiId == XIMU3_ASCII_ID_ERROR)) && (payloadSize > 0) && (payload[0] == '\0')) {
+        if (ResolveInterned(decoder, payload, &payloadSize) != Ximu3ResultOk) {
+            Error(decoder, "Binary decode error. Invalid interned string for ID 0x%02X.", id);
+            return;
+        }
+    }
+    if ((parser != NULL ? parser(decoder, payload, payloadSize, timestamp) : ParseCustom(decoder, descriptor, payload, payloadSize, timestamp)) != Ximu3ResultOk) {
+        Error(decoder, "Binary decode error. Invalid message length for ID 0x%02X.", id);
+        decoder->timestampValid = false;
+    }
+}
+
+/**
+ * @brief Replaces an interned string payload with the string. A definition
+ * adds the string to the table.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @return Result.
+ */
+static Ximu3Result ResolveInterned(Ximu3BinaryDecoder * const decoder, uint8_t * const payload, size_t * const payloadSize) {
+    if (*payloadSize < 2) {
+        return Ximu3ResultError;
+    }
+    const size_t index = payload[1] & ~XIMU3_INTERN_FLAG_DEFINITION;
+    if (index >= XIMU3_INTERN_NUMBER_OF_STRINGS) {
+        return Ximu3ResultError;
+    }
+    char * const string = decoder->interned[index];
+    if ((payload[1] & XIMU3_INTERN_FLAG_DEFINITION) != 0) {
+        const size_t length = *payloadSize - 2;
+        if ((length == 0) || (length >= XIMU3_INTERN_STRING_SIZE) || (memchr(&payload[2], '\0', length) != NULL)) {
+            return Ximu3ResultError;
+        }
+        memcpy(string, &payload[2], length);
+        string[length] = '\0';
+    } else if (string[0] == '\0') {
+        return Ximu3ResultError;
+    }
+    *payloadSize = strlen(string);
+    memcpy(payload, string, *payloadSize);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses an inertial message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseInertial(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_GYROSCOPE,
+        XIMU3_BINARY_RANGE_GYROSCOPE,
+        XIMU3_BINARY_RANGE_GYROSCOPE,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+    };
+    float values[6];
+    if (ReadValues(decoder, payload, payloadSize, values, ranges, 6) != Ximu3ResultOk) {
+        return Ximu3ResultError;
+    }
+    if (decoder->inertial == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataInertial data = {
+        .timestamp = timestamp,
+        .gyroscopeX = values[0],
+        .gyroscopeY = values[1],
+        .gyroscopeZ = values[2],
+        .accelerometerX = values[3],
+        .accelerometerY = values[4],
+        .accelerometerZ = values[5],
+    };
+    decoder->inertial(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a magnetometer message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseMagnetometer(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_MAGNETOMETER,
+        XIMU3_BINARY_RANGE_MAGNETOMETER,
+        XIMU3_BINARY_RANGE_MAGNETOMETER,
+    };
+    float values[3];
+    if (ReadValues(decoder, payload, payloadSize, values, ranges, 3) != Ximu3ResultOk) {
+        return Ximu3ResultError;
+    }
+    if (decoder->magnetometer == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataMagnetometer data = {
+        .timestamp = timestamp,
+        .x = values[0],
+        .y = values[1],
+        .z = values[2],
+    };
+    decoder->magnetometer(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a high-g accelerometer message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseHighGAccelerometer(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_HIGH_G_ACCELEROMETER,
+    };
+    float values[3];
+    if (ReadValues(decoder, payload, payloadSize, values, ranges, 3) != Ximu3ResultOk) {
+        return Ximu3ResultError;
+    }
+    if (decoder->highGAccelerometer == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataHighGAccelerometer data = {
+        .timestamp = timestamp,
+        .x = values[0],
+        .y = values[1],
+        .z = values[2],
+    };
+    decoder->highGAccelerometer(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a quaternion message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseQuaternion(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+    };
+    float values[4];
+    if ((ReadCompressedQuaternion(payload, payloadSize, 0, values) == 0) && (ReadValues(decoder, payload, payloadSize, values, ranges, 4) != Ximu3ResultOk)) {
+        return Ximu3ResultError;
+    }
+    if (decoder->quaternion == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataQuaternion data = {
+        .timestamp = timestamp,
+        .w = values[0],
+        .x = values[1],
+        .y = values[2],
+        .z = values[3],
+    };
+    decoder->quaternion(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a rotation matrix message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseRotationMatrix(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+        XIMU3_BINARY_RANGE_ROTATION_MATRIX,
+    };
+    float values[9];
+    if (ReadValues(decoder, payload, payloadSize, values, ranges, 9) != Ximu3ResultOk) {
+        return Ximu3ResultError;
+    }
+    if (decoder->rotationMatrix == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataRotationMatrix data = {
+        .timestamp = timestamp,
+        .xx = values[0],
+        .xy = values[1],
+        .xz = values[2],
+        .yx = values[3],
+        .yy = values[4],
+        .yz = values[5],
+        .zx = values[6],
+        .zy = values[7],
+        .zz = values[8],
+    };
+    decoder->rotationMatrix(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses an Euler angles message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseEulerAngles(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_EULER_ANGLES,
+        XIMU3_BINARY_RANGE_EULER_ANGLES,
+        XIMU3_BINARY_RANGE_EULER_ANGLES,
+    };
+    float values[3];
+    if (ReadValues(decoder, payload, payloadSize, values, ranges, 3) != Ximu3ResultOk) {
+        return Ximu3ResultError;
+    }
+    if (decoder->eulerAngles == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataEulerAngles data = {
+        .timestamp = timestamp,
+        .roll = values[0],
+        .pitch = values[1],
+        .yaw = values[2],
+    };
+    decoder->eulerAngles(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a linear acceleration message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseLinearAcceleration(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+    };
+    float values[7];
+    const size_t quaternionSize = ReadCompressedQuaternion(payload, payloadSize, 3, values);
+    const size_t index = quaternionSize == 0 ? 0 : 4;
+    if (ReadValues(decoder, &payload[quaternionSize], payloadSize - quaternionSize, &values[index], &ranges[index], 7 - index) != Ximu3ResultOk) {
+        return Ximu3ResultError;
+    }
+    if (decoder->linearAcceleration == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataLinearAcceleration data = {
+        .timestamp = timestamp,
+        .quaternionW = values[0],
+        .quaternionX = values[1],
+        .quaternionY = values[2],
+        .quaternionZ = values[3],
+        .linearAccelerationX = values[4],
+        .linearAccelerationY = values[5],
+        .linearAccelerationZ = values[6],
+    };
+    decoder->linearAcceleration(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses an Earth acceleration message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseEarthAcceleration(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_QUATERNION,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+        XIMU3_BINARY_RANGE_ACCELEROMETER,
+    };
+    float values[7];
+    const size_t quaternionSize = ReadCompressedQuaternion(payload, payloadSize, 3, values);
+    const size_t index = quaternionSize == 0 ? 0 : 4;
+    if (ReadValues(decoder, &payload[quaternionSize], payloadSize - quaternionSize, &values[index], &ranges[index], 7 - index) != Ximu3ResultOk) {
+        return Ximu3ResultError;
+    }
+    if (decoder->earthAcceleration == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataEarthAcceleration data = {
+        .timestamp = timestamp,
+        .quaternionW = values[0],
+        .quaternionX = values[1],
+        .quaternionY = values[2],
+        .quaternionZ = values[3],
+        .earthAccelerationX = values[4],
+        .earthAccelerationY = values[5],
+        .earthAccelerationZ = values[6],
+    };
+    decoder->earthAcceleration(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses an AHRS status message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseAhrsStatus(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if ((payloadSize != (4 * sizeof (float))) && (payloadSize != sizeof (uint8_t))) {
+        return Ximu3ResultError;
+    }
+    if (decoder->ahrsStatus == NULL) {
+        return Ximu3ResultOk;
+    }
+    Ximu3DataAhrsStatus data = {
+        .timestamp = timestamp,
+    };
+    if (payloadSize == sizeof (uint8_t)) {
+        data.initialising = (payload[0] & XIMU3_BINARY_FLAG_INITIALISING) != 0;
+        data.angularRateRecovery = (payload[0] & XIMU3_BINARY_FLAG_ANGULAR_RATE_RECOVERY) != 0;
+        data.accelerationRecovery = (payload[0] & XIMU3_BINARY_FLAG_ACCELERATION_RECOVERY) != 0;
+        data.magneticRecovery = (payload[0] & XIMU3_BINARY_FLAG_MAGNETIC_RECOVERY) != 0;
+    } else {
+        data.initialising = ReadFloat(&payload[0]) != 0.0f;
+        data.angularRateRecovery = ReadFloat(&payload[4]) != 0.0f;
+        data.accelerationRecovery = ReadFloat(&payload[8]) != 0.0f;
+        data.magneticRecovery = ReadFloat(&payload[12]) != 0.0f;
+    }
+    decoder->ahrsStatus(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a serial accessory message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseSerialAccessory(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if (decoder->serialAccessory == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataSerialAccessory data = {
+        .timestamp = timestamp,
+        .data = payload,
+        .numberOfBytes = payloadSize,
+    };
+    decoder->serialAccessory(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a sync message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseSync(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if ((payloadSize != sizeof (float)) && (payloadSize != sizeof (uint8_t))) {
+        return Ximu3ResultError;
+    }
+    if (decoder->sync == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataSync data = {
+        .timestamp = timestamp,
+        .edge = payloadSize == sizeof (uint8_t) ? (payload[0] & XIMU3_BINARY_FLAG_EDGE) != 0 : ReadFloat(&payload[0]) != 0.0f,
+    };
+    decoder->sync(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses an LTC message. The timecode is either a string or packed into
+ * 4 bytes.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseLtc(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    char timecode[XIMU3_LTC_TIMECODE_SIZE];
+    Ximu3DataLtc data = {
+        .timestamp = timestamp,
+        .timecode = timecode,
+    };
+    if (payloadSize == sizeof (uint32_t)) {
+        data.packedTimecode = (uint32_t) payload[0] | ((uint32_t) payload[1] << 8) | ((uint32_t) payload[2] << 16) | ((uint32_t) payload[3] << 24);
+        if (Ximu3LtcUnpack(data.packedTimecode, timecode) == false) {
+            return Ximu3ResultError;
+        }
+    } else {
+        payload[payloadSize] = '\0';
+        data.timecode = (const char*) payload;
+        Ximu3LtcPack(data.timecode, &data.packedTimecode); // packed timecode is 0 if the timecode is not valid
+    }
+    if (decoder->ltc == NULL) {
+        return Ximu3ResultOk;
+    }
+    decoder->ltc(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a temperature message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseTemperature(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    static const float ranges[] = {
+        XIMU3_BINARY_RANGE_TEMPERATURE,
+    };
+    float values[1];
+    if (ReadValues(decoder, payload, payloadSize, values, ranges, 1) != Ximu3ResultOk) {
+        return Ximu3ResultError;
+    }
+    if (decoder->temperature == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataTemperature data = {
+        .timestamp = timestamp,
+        .temperature = values[0],
+    };
+    decoder->temperature(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a battery message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseBattery(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if (payloadSize != (3 * sizeof (float))) {
+        return Ximu3ResultError;
+    }
+    if (decoder->battery == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataBattery data = {
+        .timestamp = timestamp,
+        .percentage = ReadFloat(&payload[0]),
+        .voltage = ReadFloat(&payload[4]),
+        .chargingStatus = ReadFloat(&payload[8]),
+    };
+    decoder->battery(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses an RSSI message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseRssi(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if (payloadSize != (2 * sizeof (float))) {
+        return Ximu3ResultError;
+    }
+    if (decoder->rssi == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataRssi data = {
+        .timestamp = timestamp,
+        .percentage = ReadFloat(&payload[0]),
+        .power = ReadFloat(&payload[4]),
+    };
+    decoder->rssi(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a button message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseButton(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if ((payloadSize != sizeof (float)) && (payloadSize != sizeof (uint8_t))) {
+        return Ximu3ResultError;
+    }
+    if (decoder->button == NULL) {
+        return Ximu3ResultOk;
+    }
+    const Ximu3DataButton data = {
+        .timestamp = timestamp,
+        .state = payloadSize == sizeof (uint8_t) ? (payload[0] & XIMU3_BINARY_FLAG_STATE) != 0 : ReadFloat(&payload[0]) != 0.0f,
+    };
+    decoder->button(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a notification message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseNotification(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if (decoder->notification == NULL) {
+        return Ximu3ResultOk;
+    }
+    payload[payloadSize] = '\0';
+    const Ximu3DataNotification data = {
+        .timestamp = timestamp,
+        .notification = (const char*) payload,
+    };
+    decoder->notification(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses an error message.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseError(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if (decoder->error == NULL) {
+        return Ximu3ResultOk;
+    }
+    payload[payloadSize] = '\0';
+    const Ximu3DataError data = {
+        .timestamp = timestamp,
+        .error = (const char*) payload,
+    };
+    decoder->error(&data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses an aggregate message. The message is validated before any
+ * samples are passed to the parser of the sample type so that a corrupt
+ * message results in no callbacks.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseAggregate(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if (payloadSize < 2) {
+        return Ximu3ResultError;
+    }
+    const uint8_t asciiId = payload[0] & 0x7F;
+    const size_t sampleSize = numberOfSampleValues[asciiId] * ((payload[0] & 0x80) != 0 ? sizeof (uint16_t) : sizeof (float));
+    if (sampleSize == 0) {
+        return Ximu3ResultError;
+    }
+    for (int pass = 0; pass < 2; pass++) {
+        size_t index = 1;
+        while (index < payloadSize) {
+            uint32_t offset;
+            const size_t varintSize = ReadVarint(&payload[index], payloadSize - index, &offset);
+            if ((varintSize == 0) || (sampleSize > (payloadSize - index - varintSize))) {
+                return Ximu3ResultError;
+            }
+            index += varintSize;
+            if (pass == 1) {
+                if (parsers[asciiId](decoder, &payload[index], sampleSize, timestamp + offset) != Ximu3ResultOk) {
+                    return Ximu3ResultError;
+                }
+            }
+            index += sampleSize;
+        }
+    }
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a composite message. The message is validated before any
+ * payloads are passed to the parser of each included type.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseComposite(const Ximu3BinaryDecoder * const decoder, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if (payloadSize < sizeof (uint16_t)) {
+        return Ximu3ResultError;
+    }
+    const uint16_t mask = (uint16_t) (payload[0] | (payload[1] << 8));
+    const size_t valueSize = (mask & XIMU3_BINARY_COMPOSITE_16_BIT) != 0 ? sizeof (uint16_t) : sizeof (float);
+    if ((mask & ~XIMU3_BINARY_COMPOSITE_16_BIT) >= (1 << sizeof (compositeIds))) {
+        return Ximu3ResultError;
+    }
+    size_t expectedSize = sizeof (uint16_t);
+    for (size_t bit = 0; bit < sizeof (compositeIds); bit++) {
+        if ((mask & (1 << bit)) != 0) {
+            expectedSize += numberOfSampleValues[(int) compositeIds[bit]] * valueSize;
+        }
+    }
+    if (payloadSize != expectedSize) {
+        return Ximu3ResultError;
+    }
+    size_t index = sizeof (uint16_t);
+    for (size_t bit = 0; bit < sizeof (compositeIds); bit++) {
+        if ((mask & (1 << bit)) == 0) {
+            continue;
+        }
+        const size_t size = numberOfSampleValues[(int) compositeIds[bit]] * valueSize;
+        if (parsers[(int) compositeIds[bit]](decoder, &payload[index], size, timestamp) != Ximu3ResultOk) {
+            return Ximu3ResultError;
+        }
+        index += size;
+    }
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Parses a custom message described by a registered descriptor.
+ * @param decoder Decoder.
+ * @param descriptor Descriptor.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param timestamp Timestamp.
+ * @return Result.
+ */
+static Ximu3Result ParseCustom(const Ximu3BinaryDecoder * const decoder, const Ximu3Descriptor * const descriptor, uint8_t * const payload, const size_t payloadSize, const uint64_t timestamp) {
+    if (decoder->custom == NULL) {
+        return Ximu3ResultOk;
+    }
+    union {
+        uint64_t timestamp;
+        void* pointer;
+        uint8_t members[XIMU3_DESCRIPTOR_MAX_SIZE];
+    } data;
+    memset(&data, 0, sizeof (data));
+    data.timestamp = timestamp;
+    size_t index = 0;
+    for (size_t fieldIndex = 0; fieldIndex < descriptor->numberOfFields; fieldIndex++) {
+        const Ximu3DescriptorField * const field = &descriptor->fields[fieldIndex];
+        uint8_t * const member = &data.members[field->offset];
+        const uint8_t* bytes = &payload[index];
+        const size_t numberOfBytes = payloadSize - index;
+        switch (field->type) {
+            case Ximu3DescriptorFieldTypeFloat:
+            case Ximu3DescriptorFieldTypeBool:
+                if (numberOfBytes < sizeof (float)) {
+                    return Ximu3ResultError;
+                }
+                if (field->type == Ximu3DescriptorFieldTypeBool) {
+                    const bool value = ReadFloat(bytes) != 0.0f;
+                    memcpy(member, &value, sizeof (value));
+                } else {
+                    const float value = ReadFloat(bytes);
+                    memcpy(member, &value, sizeof (value));
+                }
+                index += sizeof (float);
+                break;
+            case Ximu3DescriptorFieldTypeString:
+                payload[payloadSize] = '\0';
+                memcpy(member, &bytes, sizeof (bytes));
+                index = payloadSize;
+                break;
+            case Ximu3DescriptorFieldTypeBytes:
+                memcpy(member, &bytes, sizeof (bytes));
+                memcpy(&data.members[field->numberOfBytesOffset], &numberOfBytes, sizeof (numberOfBytes));
+                index = payloadSize;
+                break;
+        }
+    }
+    if (index != payloadSize) {
+        return Ximu3ResultError;
+    }
+    decoder->custom(descriptor, &data, decoder->context);
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Reads the values of a sensor or AHRS message. A payload of 32-bit
+ * floats is always valid. A payload of 16-bit values is read using the payload
+ * format of the decoder.
+ * @param decoder Decoder.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param values Values.
+ * @param ranges Ranges of the Ximu3BinaryPayloadFormatInt16 payload format.
+ * @param numberOfValues Number of values.
+ * @return Result.
+ */
+static Ximu3Result ReadValues(const Ximu3BinaryDecoder * const decoder, const uint8_t * const payload, const size_t payloadSize, float * const values, const float * const ranges, const size_t numberOfValues) {
+    if (payloadSize == (numberOfValues * sizeof (float))) {
+        for (size_t index = 0; index < numberOfValues; index++) {
+            values[index] = ReadFloat(&payload[index * sizeof (float)]);
+        }
+        return Ximu3ResultOk;
+    }
+    if (payloadSize != (numberOfValues * sizeof (uint16_t))) {
+        return Ximu3ResultError;
+    }
+    for (size_t index = 0; index < numberOfValues; index++) {
+        const uint16_t value = (uint16_t) (payload[2 * index] | (payload[(2 * index) + 1] << 8));
+        switch (decoder->payloadFormat) {
+            case Ximu3BinaryPayloadFormatFloat16:
+                values[index] = HalfToFloat(value);
+                break;
+            case Ximu3BinaryPayloadFormatInt16:
+                values[index] = (float) ((int32_t) value - ((value & 0x8000) != 0 ? 0x10000 : 0)) * (ranges[index] / 32767.0f);
+                break;
+            default:
+                return Ximu3ResultError;
+        }
+    }
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Reads a compressed quaternion if the payload size is that of a
+ * compressed quaternion followed by the number of values as either 32-bit or
+ * 16-bit values.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ * @param numberOfValues Number of values following the compressed quaternion.
+ * @param quaternion Quaternion as w, x, y, z.
+ * @return Compressed quaternion size, or 0 if the quaternion is not compressed.
+ */
+static size_t ReadCompressedQuaternion(const uint8_t * const payload, const size_t payloadSize, const size_t numberOfValues, float * const quaternion) {
+    size_t numberOfBytes;
+    unsigned int bits;
+    if ((payloadSize == (4 + (numberOfValues * sizeof (float)))) || (payloadSize == (4 + (numberOfValues * sizeof (uint16_t))))) {
+        numberOfBytes = 4;
+        bits = XIMU3_BINARY_COMPRESSED_QUATERNION_32_BIT_BITS;
+    } else if ((payloadSize == (6 + (numberOfValues * sizeof (float)))) || (payloadSize == (6 + (numberOfValues * sizeof (uint16_t))))) {
+        numberOfBytes = 6;
+        bits = XIMU3_BINARY_COMPRESSED_QUATERNION_48_BIT_BITS;
+    } else {
+        return 0;
+    }
+    uint64_t packed = 0;
+    for (size_t index = 0; index < numberOfBytes; index++) {
+        packed |= (uint64_t) payload[index] << (8 * index);
+    }
+    packed >>= (8 * numberOfBytes) - (3 * bits) - 2; // discard unused bits
+    const unsigned int largest = (unsigned int) (packed >> (3 * bits)) & 0x3;
+    const int32_t maximum = (1 << (bits - 1)) - 1;
+    float sumOfSquares = 0.0f;
+    for (int index = 3; index >= 0; index--) { // last component is in the least significant bits
+        if ((unsigned int) index == largest) {
+            continue;
+        }
+        const int32_t quantised = (int32_t) (packed & ((UINT64_C(1) << bits) - 1)) - maximum;
+        packed >>= bits;
+        quaternion[index] = (float) quantised * (0.70710678f / (float) maximum);
+        sumOfSquares += quaternion[index] * quaternion[index];
+    }
+    quaternion[largest] = sumOfSquares < 1.0f ? sqrtf(1.0f - sumOfSquares) : 0.0f;
+    return numberOfBytes;
+}
+
+/**
+ * @brief Converts an IEEE 754 half float to a float.
+ * @param half Half float.
+ * @return Value.
+ */
+static inline float HalfToFloat(const uint16_t half) {
+    const uint32_t sign = (uint32_t) (half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+    uint32_t value_;
+    if (exponent == 0x1F) {
+        value_ = sign | 0x7F800000 | (mantissa << 13); // infinity or NaN
+    } else if (exponent != 0) {
+        value_ = sign | ((exponent + 112) << 23) | (mantissa << 13); // rebias exponent from 15 to 127
+    } else if (mantissa == 0) {
+        value_ = sign;
+    } else {
+        uint32_t exponent_ = 113; // normalise subnormal
+        while ((mantissa & 0x400) == 0) {
+            mantissa <<= 1;
+            exponent_--;
+        }
+        value_ = sign | (exponent_ << 23) | ((mantissa & 0x3FF) << 13);
+    }
+    float value;
+    memcpy(&value, &value_, sizeof (value));
+    return value;
+}
+
+/**
+ * @brief Reads the varint timestamp delta of a compact message.
+ * @param decoder Decoder.
+ * @param delta Delta.
+ * @return Header size. 0 if the delta is invalid.
+ */
+static size_t ReadTimestampDelta(const Ximu3BinaryDecoder * const decoder, uint64_t * const delta) {
+    uint32_t value;
+    const size_t varintSize = ReadVarint(&decoder->buffer[1], decoder->index - 1, &value);
+    *delta = value;
+    return varintSize == 0 ? 0 : 1 + varintSize;
+}
+
+/**
+ * @brief Reads an unsigned LEB128 varint of up to 3 bytes.
+ * @param source Source.
+ * @param numberOfBytes Number of bytes available.
+ * @param value Value.
+ * @return Varint size. 0 if the varint is invalid.
+ */
+static size_t ReadVarint(const uint8_t * const source, const size_t numberOfBytes, uint32_t * const value) {
+    *value = 0;
+    for (size_t index = 0; (index < 3) && (index < numberOfBytes); index++) {
+        *value |= (uint32_t) (source[index] & 0x7F) << (7 * index);
+        if ((source[index] & 0x80) == 0) {
+            return index + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Reads a little-endian 64-bit timestamp.
+ * @param source Source.
+ * @return Timestamp.
+ */
+static inline uint64_t ReadTimestamp(const uint8_t * const source) {
+    return ((uint64_t) source[0] << 0) | ((uint64_t) source[1] << 8) | ((uint64_t) source[2] << 16) | ((uint64_t) source[3] << 24) |
+            ((uint64_t) source[4] << 32) | ((uint64_t) source[5] << 40) | ((uint64_t) source[6] << 48) | ((uint64_t) source[7] << 56);
+}
+
+/**
+ * @brief Reads a little-endian 32-bit float.
+ * @param source Source.
+ * @return Value.
+ */
+static inline float ReadFloat(const uint8_t * const source) {
+    const uint32_t value_ = ((uint32_t) source[0] << 0) | ((uint32_t) source[1] << 8) | ((uint32_t) source[2] << 16) | ((uint32_t) source[3] << 24);
+    float value;
+    memcpy(&value, &value_, sizeof (value));
+    return value;
+}
+
+/**
+ * @brief Error handler.
+ * @param decoder Decoder.
+ * @param format Format.
+ * @param ... Arguments.
+ */
+static void Error(const Ximu3BinaryDecoder * const decoder, const char* const format, ...) {
+    if (decoder->decodeError == NULL) {
+        return;
+    }
+    char string[256];
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(string, sizeof (string), format, arguments);
+    va_end(arguments);
+    decoder->decodeError(string, decoder->context);
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,48 @@
+/**
+ * @file Ximu3CompactTimestamp.c
+ * @author Seb Madgwick
+ * @brief Compact timestamp state. A compact message has a lowercase ID and the
+ * timestamp is sent as the delta from the timestamp of the previous message.
+ * An absolute timestamp is sent periodically, and whenever the delta is
+ * negative or too large.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Ximu3CompactTimestamp.h"
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Updates the state with the timestamp of the next message.
+ * @param compactTimestamp Compact timestamp.
+ * @param timestamp Timestamp.
+ * @param delta Delta from the timestamp of the previous message. Only valid
+ * if the function returns true.
+ * @return True if the message should be sent with a compact timestamp.
+ */
+bool Ximu3CompactTimestampUpdate(Ximu3CompactTimestamp * const compactTimestamp, const uint64_t timestamp, uint32_t * const delta) {
+    const bool absolute = (compactTimestamp->count == 0) || (timestamp < compactTimestamp->previous) || ((timestamp - compactTimestamp->previous) > XIMU3_COMPACT_TIMESTAMP_MAX_DELTA);
+    *delta = (uint32_t) (timestamp - compactTimestamp->previous);
+    compactTimestamp->previous = timestamp;
+    if (absolute) {
+        compactTimestamp->count = compactTimestamp->absolutePeriod > 0 ? compactTimestamp->absolutePeriod - 1 : 0;
+        return false;
+    }
+    compactTimestamp->count--;
+    return true;
+}
+
+/**
+ * @brief Resets the state so that the next message is sent with an absolute
+ * timestamp. This should be called when the interface reconnects.
+ * @param compactTimestamp Compact timestamp.
+ */
+void Ximu3CompactTimestampReset(Ximu3CompactTimestamp * const compactTimestamp) {
+    compactTimestamp->count = 0;
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,46 @@
+/**
+ * @file Ximu3CompactTimestamp.h
+ * @author Seb Madgwick
+ * @brief Compact timestamp state. A compact message has a lowercase ID and the
+ * timestamp is sent as the delta from the timestamp of the previous message.
+ * An absolute timestamp is sent periodically, and whenever the delta is
+ * negative or too large.
+ */
+
+#ifndef XIMU3_COMPACT_TIMESTAMP_H
+#define XIMU3_COMPACT_TIMESTAMP_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum delta of a compact timestamp. This is the maximum value of a
+ * 3-byte varint.
+ */
+#define XIMU3_COMPACT_TIMESTAMP_MAX_DELTA ((UINT32_C(1) << 21) - 1)
+
+/**
+ * @brief Compact timestamp. There should be one instance per interface.
+ */
+typedef struct {
+    uint32_t absolutePeriod; // maximum number of messages per absolute timestamp, 0 for absolute timestamps only
+    uint64_t previous; // private
+    uint32_t count; // private
+} Ximu3CompactTimestamp;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+bool Ximu3CompactTimestampUpdate(Ximu3CompactTimestamp * const compactTimestamp, const uint64_t timestamp, uint32_t * const delta);
+void Ximu3CompactTimestampReset(Ximu3CompactTimestamp * const compactTimestamp);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,869 @@
+/**
+ * @file Ximu3Compression.c
+ * @author Seb Madgwick
+ * @brief Streaming compression of binary data messages. Each binary data
+ * message is sent as a compressed message with the binary only ID
+ * XIMU3_ASCII_ID_COMPRESSED. The timestamp is sent as the delta from the
+ * previous timestamp and the payload as the delta from the previous payload of
+ * the same message type, as zigzag varints. The result is then LZ77 coded
+ * against a window of the preceding messages. The decompressor must receive
+ * every compressed message in order. The state is reset periodically so that
+ * the decompressor recovers from a lost message.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "Ximu3Ascii.h"
+#include "Ximu3Compression.h"
+#include "Ximu3Definitions.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+#define BYTE_STUFFING_END       XIMU3_TERMINATION
+#define BYTE_STUFFING_ESC       (0xDB)
+#define BYTE_STUFFING_ESC_END   (0xDC)
+#define BYTE_STUFFING_ESC_ESC   (0xDD)
+
+#define COMPRESSED_ID           (0x80 + XIMU3_ASCII_ID_COMPRESSED)
+#define HEADER_SIZE             (1 + sizeof (uint64_t)) /* ID + 64-bit timestamp */
+#define WINDOW_MASK             (XIMU3_COMPRESSION_WINDOW_SIZE - 1)
+
+/**
+ * @brief LZ77 control byte. A match is 1LLLLLDD DDDDDDDD, where L is the length
+ * minus MINIMUM_MATCH_LENGTH and D is the distance minus 1. A literal run is
+ * 0NNNNNNN followed by N + 1 bytes.
+ */
+#define MATCH                   (0x80)
+#define MINIMUM_MATCH_LENGTH    (3)
+#define MAXIMUM_MATCH_LENGTH    (MINIMUM_MATCH_LENGTH + 0x1F)
+#define MAXIMUM_LITERAL_LENGTH  (0x80)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static size_t Unstuff(const uint8_t * const source, const size_t numberOfBytes, uint8_t * const destination, const size_t destinationSize);
+static size_t CompactHeaderSize(const uint8_t * const message, const size_t messageSize);
+static size_t DeltaEncode(Ximu3Compressor * const compressor, const size_t messageSize, uint8_t * const flags);
+static void Lz77Encode(Ximu3Compressor * const compressor, const size_t numberOfTokens, uint8_t * const destination, size_t * const destinationIndex);
+static inline size_t MatchLength(const Ximu3CompressionState * const state, const uint8_t * const tokens, const size_t index, const size_t numberOfTokens, const uint32_t distance);
+static void WriteLiterals(uint8_t * const destination, size_t * const destinationIndex, const uint8_t * const literals, const size_t numberOfLiterals);
+static inline void WriteByte(uint8_t * const destination, size_t * const destinationIndex, const uint8_t byte);
+static inline uint32_t Hash(const uint8_t * const bytes);
+static void Receive(Ximu3Decompressor * const decompressor, const uint8_t * const source, const size_t numberOfBytes);
+static void Decompress(Ximu3Decompressor * const decompressor);
+static size_t Lz77Decode(Ximu3Decompressor * const decompressor, const uint8_t * const source, const size_t numberOfBytes);
+static size_t DeltaDecode(Ximu3Decompressor * const decompressor, const size_t numberOfTokens, const uint8_t flags);
+static void WriteMessage(const Ximu3Decompressor * const decompressor, const size_t messageSize);
+static void StateReset(Ximu3CompressionState * const state);
+static inline void WindowAppend(Ximu3CompressionState * const state, const uint8_t byte);
+static Ximu3CompressionChannel* FindChannel(Ximu3CompressionState * const state, const uint8_t id);
+static void UpdateChannel(Ximu3CompressionState * const state, Ximu3CompressionChannel* channel, const uint8_t id, const uint8_t * const payload, const size_t payloadSize);
+static inline uint8_t ChannelId(const uint8_t id);
+static inline bool IsCompact(const uint8_t id);
+static inline uint64_t Zigzag(const uint64_t value, const unsigned int numberOfBits);
+static inline uint64_t Unzigzag(const uint64_t value, const unsigned int numberOfBits);
+static inline uint64_t ReadWord(const uint8_t * const source, const size_t wordSize);
+static inline void WriteWord(uint8_t * const destination, const size_t wordSize, const uint64_t word);
+static size_t WriteVarint(uint8_t * const destination, uint64_t value);
+static size_t ReadVarint(const uint8_t * const source, const size_t numberOfBytes, uint64_t * const value);
+static void Error(const Ximu3Decompressor * const decompressor, const char* const format, ...);
+
+//------------------------------------------------------------------------------
+// Functions - Compressor
+
+/**
+ * @brief Compresses a binary data message. The compressed message is always
+ * written once the message is accepted, even if it is larger than the original
+ * message, so that the state of the decompressor remains in step. For example:
+ *
+ * uint8_t message[XIMU3_SIZE_BINARY_INERTIAL];
+ * uint8_t compressed[XIMU3_SIZE_COMPRESSED(XIMU3_SIZE_BINARY_INERTIAL)];
+ * const size_t compressedSize = Ximu3CompressorMessage(&compressor, compressed, sizeof (compressed), message, Ximu3BinaryInertial(message, sizeof (message), &data));
+ *
+ * @param compressor Compressor.
+ * @param destination Destination.
+ * @param destinationSize Destination size. Must be at least
+ * XIMU3_SIZE_COMPRESSED(messageSize).
+ * @param message Binary data message including the termination.
+ * @param messageSize Message size.
+ * @return Compressed message size. 0 if the message is not a valid binary data
+ * message or the destination is too small, in which case the state is
+ * unchanged.
+ */
+size_t Ximu3CompressorMessage(Ximu3Compressor * const compressor, void* const destination, const size_t destinationSize, const void* const message, const size_t messageSize) {
+
+    // Remove byte stuffing
+    if (destinationSize < XIMU3_SIZE_COMPRESSED(messageSize)) {
+        return 0;
+    }
+    const size_t unstuffedSize = Unstuff(message, messageSize, compressor->message, sizeof (compressor->message));
+    if (unstuffedSize == 0) {
+        return 0;
+    }
+    const uint8_t id = compressor->message[0];
+    if ((id < 0x80) || (id == COMPRESSED_ID)) {
+        return 0;
+    }
+    if (IsCompact(id) ? (CompactHeaderSize(compressor->message, unstuffedSize) == 0) : (unstuffedSize < HEADER_SIZE)) {
+        return 0;
+    }
+
+    // Reset state
+    uint8_t flags = 0;
+    if ((compressor->stateValid == false) || ((compressor->resetPeriod > 0) && (compressor->count == 0))) {
+        StateReset(&compressor->state);
+        compressor->stateValid = true;
+        compressor->count = compressor->resetPeriod;
+        flags |= XIMU3_COMPRESSION_FLAG_RESET;
+    }
+    if (compressor->count > 0) {
+        compressor->count--;
+    }
+
+    // Compress
+    flags |= (uint8_t) ((compressor->state.sequence++ & XIMU3_COMPRESSION_SEQUENCE_MASK) << XIMU3_COMPRESSION_SEQUENCE_SHIFT);
+    const size_t numberOfTokens = DeltaEncode(compressor, unstuffedSize, &flags);
+    uint8_t * const bytes = destination;
+    size_t destinationIndex = 0;
+    bytes[destinationIndex++] = COMPRESSED_ID;
+    WriteByte(bytes, &destinationIndex, flags);
+    Lz77Encode(compressor, numberOfTokens, bytes, &destinationIndex);
+    bytes[destinationIndex++] = BYTE_STUFFING_END;
+    return destinationIndex;
+}
+
+/**
+ * @brief Resets the state so that the next message is compressed without
+ * reference to previous messages. This should be called when the interface
+ * reconnects.
+ * @param compressor Compressor.
+ */
+void Ximu3CompressorReset(Ximu3Compressor * const compressor) {
+    compressor->stateValid = false;
+}
+
+/**
+ * @brief Removes byte stuffing from a message. The message must end with the
+ * termination.
+ * @param source Source.
+ * @param numberOfBytes Number of bytes.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @return Number of bytes excluding the termination. 0 if the message is
+ * invalid or the destination is too small.
+ */
+static size_t Unstuff(const uint8_t * const source, const size_t numberOfBytes, uint8_t * const destination, const size_t destinationSize) {
+    if ((numberOfBytes < 2) || (source[numberOfBytes - 1] != BYTE_STUFFING_END)) {
+        return 0;
+    }
+    size_t destinationIndex = 0;
+    for (size_t index = 0; index < (numberOfBytes - 1); index++) {
+        uint8_t byte = source[index];
+        if (byte == BYTE_STUFFING_END) {
+            return 0;
+        }
+        if (byte == BYTE_STUFFING_ESC) {
+            if (++index >= (numberOfBytes - 1)) {
+                return 0;
+            }
+            switch (source[index]) {
+                case BYTE_STUFFING_ESC_END:
+                    byte = BYTE_STUFFING_END;
+                    break;
+                case BYTE_STUFFING_ESC_ESC:
+                    byte = BYTE_STUFFING_ESC;
+                    break;
+                default:
+                    return 0;
+            }
+        }
+        if (destinationIndex >= destinationSize) {
+            return 0;
+        }
+        destination[destinationIndex++] = byte;
+    }
+    return destinationIndex;
+}
+
+/**
+ * @brief Returns the header size of a compact message, i.e. the ID and the
+ * timestamp delta varint of up to 3 bytes.
+ * @param message Message.
+ * @param messageSize Message size.
+ * @return Header size. 0 if the timestamp delta is invalid.
+ */
+static size_t CompactHeaderSize(const uint8_t * const message, const size_t messageSize) {
+    for (size_t index = 1; (index < messageSize) && (index <= 3); index++) {
+        if ((message[index] & 0x80) == 0) {
+            return index + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Converts the message to tokens. The timestamp is written as the
+ * zigzag varint delta from the previous timestamp. The payload is written as
+ * the zigzag varint deltas of each word from the previous payload of the same
+ * message type, or unchanged if there is no previous payload of the same size
+ * or if the deltas would be larger than the payload.
+ * @param compressor Compressor.
+ * @param messageSize Message size.
+ * @param flags Flags.
+ * @return Number of tokens.
+ */
+static size_t DeltaEncode(Ximu3Compressor * const compressor, const size_t messageSize, uint8_t * const flags) {
+    Ximu3CompressionState * const state = &compressor->state;
+    const uint8_t * const message = compressor->message;
+    uint8_t * const tokens = compressor->tokens;
+
+    // Header
+    const uint8_t id = message[0];
+    size_t headerSize;
+    size_t numberOfTokens;
+    if (IsCompact(id)) {
+        headerSize = CompactHeaderSize(message, messageSize);
+        memcpy(tokens, message, headerSize);
+        numberOfTokens = headerSize;
+    } else {
+        headerSize = HEADER_SIZE;
+        const uint64_t timestamp = ReadWord(&message[1], sizeof (uint64_t));
+        tokens[0] = id;
+        numberOfTokens = 1 + WriteVarint(&tokens[1], Zigzag(timestamp - state->timestamp, 64));
+        state->timestamp = timestamp;
+    }
+    const uint8_t * const payload = &message[headerSize];
+    const size_t payloadSize = messageSize - headerSize;
+
+    // Payload
+    Ximu3CompressionChannel * const channel = FindChannel(state, ChannelId(id));
+    size_t wordSize = compressor->payloadFormat == Ximu3BinaryPayloadFormatFloat32 ? sizeof (uint32_t) : sizeof (uint16_t);
+    if ((payloadSize % wordSize) != 0) {
+        wordSize = sizeof (uint16_t);
+    }
+    bool delta = (channel != NULL) && (channel->payloadSize == payloadSize) && (payloadSize > 0) && ((payloadSize % wordSize) == 0);
+    size_t deltaSize = 0;
+    for (size_t index = 0; delta && (index < payloadSize); index += wordSize) {
+        uint8_t varint[10];
+        const size_t varintSize = WriteVarint(varint, Zigzag(ReadWord(&payload[index], wordSize) - ReadWord(&channel->payload[index], wordSize), (unsigned int) (8 * wordSize)));
+        if ((deltaSize + varintSize) > payloadSize) {
+            delta = false;
+            break;
+        }
+        memcpy(&tokens[numberOfTokens + deltaSize], varint, varintSize);
+        deltaSize += varintSize;
+    }
+    if (delta) {
+        *flags |= wordSize == sizeof (uint32_t) ? XIMU3_COMPRESSION_FLAG_DELTA_32_BIT : XIMU3_COMPRESSION_FLAG_DELTA_16_BIT;
+        numberOfTokens += deltaSize;
+    } else {
+        memcpy(&tokens[numberOfTokens], payload, payloadSize);
+        numberOfTokens += payloadSize;
+    }
+    UpdateChannel(state, channel, ChannelId(id), payload, payloadSize);
+    return numberOfTokens;
+}
+
+/**
+ * @brief Writes the tokens with LZ77 coding and byte stuffing. Each token is
+ * appended to the window. The destination size must be sufficient for the
+ * worst case.
+ * @param compressor Compressor.
+ * @param numberOfTokens Number of tokens.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ */
+static void Lz77Encode(Ximu3Compressor * const compressor, const size_t numberOfTokens, uint8_t * const destination, size_t * const destinationIndex) {
+    Ximu3CompressionState * const state = &compressor->state;
+    const uint8_t * const tokens = compressor->tokens;
+    size_t literalIndex = 0;
+    size_t index = 0;
+    while (index < numberOfTokens) {
+
+        // Find match
+        size_t length = 0;
+        uint32_t distance = 0;
+        if ((numberOfTokens - index) >= MINIMUM_MATCH_LENGTH) {
+            uint16_t * const entry = &compressor->hash[Hash(&tokens[index])];
+            distance = (uint16_t) (state->position - *entry);
+            *entry = (uint16_t) state->position;
+            if ((distance > 0) && (distance <= XIMU3_COMPRESSION_WINDOW_SIZE) && (distance <= state->position)) {
+                length = MatchLength(state, tokens, index, numberOfTokens, distance);
+            }
+        }
+
+        // Literal
+        if (length < MINIMUM_MATCH_LENGTH) {
+            WindowAppend(state, tokens[index++]);
+            if ((index - literalIndex) == MAXIMUM_LITERAL_LENGTH) {
+                WriteLiterals(destination, destinationIndex, &tokens[literalIndex], index - literalIndex);
+                literalIndex = index;
+            }
+            continue;
+        }
+
+        // Match
+        WriteLiterals(destination, destinationIndex, &tokens[literalIndex], index - literalIndex);
+        WriteByte(destination, destinationIndex, (uint8_t) (MATCH | ((length - MINIMUM_MATCH_LENGTH) << 2) | ((distance - 1) >> 8)));
+        WriteByte(destination, destinationIndex, (uint8_t) ((distance - 1) & 0xFF));
+        WindowAppend(state, tokens[index++]);
+        for (size_t count = 1; count < length; count++) {
+            if ((numberOfTokens - index) >= MINIMUM_MATCH_LENGTH) {
+                compressor->hash[Hash(&tokens[index])] = (uint16_t) state->position;
+            }
+            WindowAppend(state, tokens[index++]);
+        }
+        literalIndex = index;
+    }
+    WriteLiterals(destination, destinationIndex, &tokens[literalIndex], index - literalIndex);
+}
+
+/**
+ * @brief Returns the length of the match at the specified distance. The match
+ * may overlap the tokens that follow the window.
+ * @param state State.
+ * @param tokens Tokens.
+ * @param index Index of the first token of the match.
+ * @param numberOfTokens Number of tokens.
+ * @param distance Distance.
+ * @return Match length.
+ */
+static inline size_t MatchLength(const Ximu3CompressionState * const state, const uint8_t * const tokens, const size_t index, const size_t numberOfTokens, const uint32_t distance) {
+    const size_t maximumLength = (numberOfTokens - index) < MAXIMUM_MATCH_LENGTH ? (numberOfTokens - index) : MAXIMUM_MATCH_LENGTH;
+    size_t length = 0;
+    while (length < maximumLength) {
+        const uint8_t byte = length < distance ? state->window[(state->position - distance + length) & WINDOW_MASK] : tokens[index + length - distance];
+        if (byte != tokens[index + length]) {
+            break;
+        }
+        length++;
+    }
+    return length;
+}
+
+/**
+ * @brief Writes a literal run.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param literals Literals.
+ * @param numberOfLiterals Number of literals.
+ */
+static void WriteLiterals(uint8_t * const destination, size_t * const destinationIndex, const uint8_t * const literals, const size_t numberOfLiterals) {
+    if (numberOfLiterals == 0) {
+        return;
+    }
+    WriteByte(destination, destinationIndex, (uint8_t) (numberOfLiterals - 1));
+    for (size_t index = 0; index < numberOfLiterals; index++) {
+        WriteByte(destination, destinationIndex, literals[index]);
+    }
+}
+
+/**
+ * @brief Writes a byte with byte stuffing.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param byte Byte.
+ */
+static inline void WriteByte(uint8_t * const destination, size_t * const destinationIndex, const uint8_t byte) {
+    switch (byte) {
+        case BYTE_STUFFING_END:
+            destination[(*destinationIndex)++] = BYTE_STUFFING_ESC;
+            destination[(*destinationIndex)++] = BYTE_STUFFING_ESC_END;
+            break;
+        case BYTE_STUFFING_ESC:
+            destination[(*destinationIndex)++] = BYTE_STUFFING_ESC;
+            destination[(*destinationIndex)++] = BYTE_STUFFING_ESC_ESC;
+            break;
+        default:
+            destination[(*destinationIndex)++] = byte;
+            break;
+    }
+}
+
+/**
+ * @brief Returns the hash table index of three bytes.
+ * @param bytes Bytes.
+ * @return Hash table index.
+ */
+static inline uint32_t Hash(const uint8_t * const bytes) {
+    const uint32_t value = ((uint32_t) bytes[0] << 16) | ((uint32_t) bytes[1] << 8) | (uint32_t) bytes[2];
+    return ((value * UINT32_C(2654435761)) >> 16) & (XIMU3_COMPRESSION_HASH_SIZE - 1);
+}
+
+//------------------------------------------------------------------------------
+// Functions - Decompressor
+
+/**
+ * @brief Processes received data.
+ * @param decompressor Decompressor.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+void Ximu3DecompressorProcess(Ximu3Decompressor * const decompressor, const void* const data, const size_t numberOfBytes) {
+    const uint8_t* source = data;
+    const uint8_t * const end = source + numberOfBytes;
+    while (source < end) {
+
+        // Identify message from first byte
+        if (decompressor->partial == false) {
+            decompressor->partial = true;
+            decompressor->compressed = *source == COMPRESSED_ID;
+            decompressor->index = 0;
+            decompressor->escape = false;
+            decompressor->discard = false;
+            if (decompressor->compressed) {
+                source++;
+            }
+        }
+
+        // Receive bytes up to next termination
+        const uint8_t * const termination = memchr(source, BYTE_STUFFING_END, (size_t) (end - source));
+        const uint8_t * const next = termination == NULL ? end : termination + 1;
+        if (decompressor->compressed) {
+            Receive(decompressor, source, (size_t) ((termination == NULL ? end : termination) - source));
+            if (termination != NULL) {
+                Decompress(decompressor);
+            }
+        } else if (next > source) {
+            decompressor->write(source, (size_t) (next - source), decompressor->context);
+        }
+        if (termination != NULL) {
+            decompressor->partial = false;
+        }
+        source = next;
+    }
+}
+
+/**
+ * @brief Discards any partially received message and the state. Messages are
+ * discarded until a message is received that was compressed after a reset.
+ * This should be called when the interface reconnects.
+ * @param decompressor Decompressor.
+ */
+void Ximu3DecompressorReset(Ximu3Decompressor * const decompressor) {
+    decompressor->partial = false;
+    decompressor->stateValid = false;
+}
+
+/**
+ * @brief Removes byte stuffing and appends the result to the buffer.
+ * @param decompressor Decompressor.
+ * @param source Source.
+ * @param numberOfBytes Number of bytes.
+ */
+static void Receive(Ximu3Decompressor * const decompressor, const uint8_t * const source, const size_t numberOfBytes) {
+    for (size_t index = 0; (index < numberOfBytes) && (decompressor->discard == false); index++) {
+        uint8_t byte = source[index];
+        if (decompressor->escape) {
+            decompressor->escape = false;
+            switch (byte) {
+                case BYTE_STUFFING_ESC_END:
+                    byte = BYTE_STUFFING_END;
+                    break;
+                case BYTE_STUFFING_ESC_ESC:
+                    byte = BYTE_STUFFING_ESC;
+                    break;
+                default:
+                    Error(decompressor, "Decompress error. Invalid escape sequence 0x%02X 0x%02X.", BYTE_STUFFING_ESC, byte);
+                    decompressor->discard = true;
+                    return;
+            }
+        } else if (byte == BYTE_STUFFING_ESC) {
+            decompressor->escape = true;
+            continue;
+        }
+        if (decompressor->index >= sizeof (decompressor->buffer)) {
+            Error(decompressor, "Decompress error. Buffer overrun.");
+            decompressor->discard = true;
+            return;
+        }
+        decompressor->buffer[decompressor->index++] = byte;
+    }
+}
+
+/**
+ * @brief Decompresses the message in the buffer and writes the original
+ * message. The state is invalidated by any error so that no message is
+ * decompressed relative to a lost message.
+ * @param decompressor Decompressor.
+ */
+static void Decompress(Ximu3Decompressor * const decompressor) {
+    if (decompressor->discard) {
+        decompressor->stateValid = false;
+        return;
+    }
+    if (decompressor->escape || (decompressor->index == 0)) {
+        Error(decompressor, "Decompress error. Invalid message.");
+        decompressor->stateValid = false;
+        return;
+    }
+    const uint8_t flags = decompressor->buffer[0];
+    if ((flags & XIMU3_COMPRESSION_FLAG_RESET) != 0) {
+        StateReset(&decompressor->state);
+        decompressor->stateValid = true;
+    }
+    if (decompressor->stateValid == false) {
+        Error(decompressor, "Decompress error. No reset since previous error.");
+        return;
+    }
+    const uint8_t sequence = decompressor->state.sequence++ & XIMU3_COMPRESSION_SEQUENCE_MASK;
+    if ((flags >> XIMU3_COMPRESSION_SEQUENCE_SHIFT) != sequence) {
+        Error(decompressor, "Decompress error. Expected sequence number %u but received %u.", sequence, flags >> XIMU3_COMPRESSION_SEQUENCE_SHIFT);
+        decompressor->stateValid = false;
+        return;
+    }
+    const size_t numberOfTokens = Lz77Decode(decompressor, &decompressor->buffer[1], decompressor->index - 1);
+    if (numberOfTokens == 0) {
+        Error(decompressor, "Decompress error. Invalid LZ77 coding.");
+        decompressor->stateValid = false;
+        return;
+    }
+    const size_t messageSize = DeltaDecode(decompressor, numberOfTokens, flags);
+    if (messageSize == 0) {
+        Error(decompressor, "Decompress error. Invalid delta coding.");
+        decompressor->stateValid = false;
+        return;
+    }
+    WriteMessage(decompressor, messageSize);
+}
+
+/**
+ * @brief Decodes LZ77 coding to tokens. Each token is appended to the window.
+ * @param decompressor Decompressor.
+ * @param source Source.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of tokens. 0 if the coding is invalid.
+ */
+static size_t Lz77Decode(Ximu3Decompressor * const decompressor, const uint8_t * const source, const size_t numberOfBytes) {
+    Ximu3CompressionState * const state = &decompressor->state;
+    uint8_t * const tokens = decompressor->tokens;
+    size_t numberOfTokens = 0;
+    size_t index = 0;
+    while (index < numberOfBytes) {
+        const uint8_t control = source[index++];
+
+        // Match
+        if ((control & MATCH) != 0) {
+            if (index >= numberOfBytes) {
+                return 0;
+            }
+            const uint32_t distance = ((uint32_t) (control & 0x03) << 8) + source[index++] + 1;
+            const size_t length = (size_t) ((control >> 2) & 0x1F) + MINIMUM_MATCH_LENGTH;
+            if ((distance > state->position) || (length > (sizeof (decompressor->tokens) - numberOfTokens))) {
+                return 0;
+            }
+            for (size_t count = 0; count < length; count++) {
+                const uint8_t byte = state->window[(state->position - distance) & WINDOW_MASK];
+                tokens[numberOfTokens++] = byte;
+                WindowAppend(state, byte);
+            }
+            continue;
+        }
+
+        // Literal run
+        const size_t length = (size_t) control + 1;
+        if ((length > (numberOfBytes - index)) || (length > (sizeof (decompressor->tokens) - numberOfTokens))) {
+            return 0;
+        }
+        for (size_t count = 0; count < length; count++) {
+            const uint8_t byte = source[index++];
+            tokens[numberOfTokens++] = byte;
+            WindowAppend(state, byte);
+        }
+    }
+    return numberOfTokens;
+}
+
+/**
+ * @brief Converts tokens to the original message without byte stuffing or
+ * termination.
+ * @param decompressor Decompressor.
+ * @param numberOfTokens Number of tokens.
+ * @param flags Flags.
+ * @return Message size. 0 if the tokens are invalid.
+ */
+static size_t DeltaDecode(Ximu3Decompressor * const decompressor, const size_t numberOfTokens, const uint8_t flags) {
+    Ximu3CompressionState * const state = &decompressor->state;
+    const uint8_t * const tokens = decompressor->tokens;
+    uint8_t * const message = decompressor->message;
+
+    // Header
+    const uint8_t id = tokens[0];
+    if ((id < 0x80) || (id == COMPRESSED_ID)) {
+        return 0;
+    }
+    size_t tokenIndex;
+    size_t headerSize;
+    if (IsCompact(id)) {
+        headerSize = CompactHeaderSize(tokens, numberOfTokens);
+        if (headerSize == 0) {
+            return 0;
+        }
+        memcpy(message, tokens, headerSize);
+        tokenIndex = headerSize;
+    } else {
+        uint64_t delta;
+        const size_t varintSize = ReadVarint(&tokens[1], numberOfTokens - 1, &delta);
+        if (varintSize == 0) {
+            return 0;
+        }
+        state->timestamp += Unzigzag(delta, 64);
+        message[0] = id;
+        WriteWord(&message[1], sizeof (uint64_t), state->timestamp);
+        tokenIndex = 1 + varintSize;
+        headerSize = HEADER_SIZE;
+    }
+    uint8_t * const payload = &message[headerSize];
+    size_t payloadSize = 0;
+
+    // Payload
+    Ximu3CompressionChannel * const channel = FindChannel(state, ChannelId(id));
+    if ((flags & (XIMU3_COMPRESSION_FLAG_DELTA_16_BIT | XIMU3_COMPRESSION_FLAG_DELTA_32_BIT)) != 0) {
+        const size_t wordSize = (flags & XIMU3_COMPRESSION_FLAG_DELTA_32_BIT) != 0 ? sizeof (uint32_t) : sizeof (uint16_t);
+        if (channel == NULL) {
+            return 0;
+        }
+        while (tokenIndex < numberOfTokens) {
+            uint64_t delta;
+            const size_t varintSize = ReadVarint(&tokens[tokenIndex], numberOfTokens - tokenIndex, &delta);
+            if ((varintSize == 0) || ((delta >> (8 * wordSize)) != 0) || ((payloadSize + wordSize) > channel->payloadSize)) {
+                return 0;
+            }
+            WriteWord(&payload[payloadSize], wordSize, ReadWord(&channel->payload[payloadSize], wordSize) + Unzigzag(delta, (unsigned int) (8 * wordSize)));
+            tokenIndex += varintSize;
+            payloadSize += wordSize;
+        }
+        if (payloadSize != channel->payloadSize) {
+            return 0;
+        }
+    } else {
+        payloadSize = numberOfTokens - tokenIndex;
+        if (payloadSize > (sizeof (decompressor->message) - headerSize)) {
+            return 0;
+        }
+        memcpy(payload, &tokens[tokenIndex], payloadSize);
+    }
+    UpdateChannel(state, channel, ChannelId(id), payload, payloadSize);
+    return headerSize + payloadSize;
+}
+
+/**
+ * @brief Writes the message with byte stuffing and the termination. Runs of
+ * bytes that do not require byte stuffing are written in one operation.
+ * @param decompressor Decompressor.
+ * @param messageSize Message size.
+ */
+static void WriteMessage(const Ximu3Decompressor * const decompressor, const size_t messageSize) {
+    static const uint8_t escapedEnd[] = {BYTE_STUFFING_ESC, BYTE_STUFFING_ESC_END};
+    static const uint8_t escapedEsc[] = {BYTE_STUFFING_ESC, BYTE_STUFFING_ESC_ESC};
+    static const uint8_t termination = BYTE_STUFFING_END;
+    const uint8_t * const message = decompressor->message;
+    size_t runIndex = 0;
+    for (size_t index = 1; index < messageSize; index++) {
+        if ((message[index] != BYTE_STUFFING_END) && (message[index] != BYTE_STUFFING_ESC)) {
+            continue;
+        }
+        decompressor->write(&message[runIndex], index - runIndex, decompressor->context);
+        decompressor->write(message[index] == BYTE_STUFFING_END ? escapedEnd : escapedEsc, 2, decompressor->context);
+        runIndex = index + 1;
+    }
+    if (messageSize > runIndex) {
+        decompressor->write(&message[runIndex], messageSize - runIndex, decompressor->context);
+    }
+    decompressor->write(&termination, 1, decompressor->context);
+}
+
+//------------------------------------------------------------------------------
+// Functions - State
+
+/**
+ * @brief Resets the state.
+ * @param state State.
+ */
+static void StateReset(Ximu3CompressionState * const state) {
+    state->position = 0;
+    for (size_t index = 0; index < XIMU3_COMPRESSION_NUMBER_OF_CHANNELS; index++) {
+        state->channels[index].id = 0;
+    }
+    state->channelIndex = 0;
+    state->timestamp = 0;
+    state->sequence = 0;
+}
+
+/**
+ * @brief Appends a byte to the window.
+ * @param state State.
+ * @param byte Byte.
+ */
+static inline void WindowAppend(Ximu3CompressionState * const state, const uint8_t byte) {
+    state->window[state->position++ & WINDOW_MASK] = byte;
+}
+
+/**
+ * @brief Finds the channel of a message type.
+ * @param state State.
+ * @param id Channel ID.
+ * @return Channel. NULL if not found.
+ */
+static Ximu3CompressionChannel* FindChannel(Ximu3CompressionState * const state, const uint8_t id) {
+    for (size_t index = 0; index < XIMU3_COMPRESSION_NUMBER_OF_CHANNELS; index++) {
+        if (state->channels[index].id == id) {
+            return &state->channels[index];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Stores the payload as the previous payload of the message type. A
+ * new channel replaces the least recently created channel. Payloads larger
+ * than a channel are not stored.
+ * @param state State.
+ * @param channel Channel. NULL if the message type has no channel.
+ * @param id Channel ID.
+ * @param payload Payload.
+ * @param payloadSize Payload size.
+ */
+static void UpdateChannel(Ximu3CompressionState * const state, Ximu3CompressionChannel* channel, const uint8_t id, const uint8_t * const payload, const size_t payloadSize) {
+    if (payloadSize > XIMU3_COMPRESSION_CHANNEL_SIZE) {
+        return;
+    }
+    if (channel == NULL) {
+        channel = &state->channels[state->channelIndex];
+        state->channelIndex = (state->channelIndex + 1) % XIMU3_COMPRESSION_NUMBER_OF_CHANNELS;
+        channel->id = id;
+    }
+    memcpy(channel->payload, payload, payloadSize);
+    channel->payloadSize = payloadSize;
+}
+
+/**
+ * @brief Returns the channel ID of a binary ID. Compact messages share the
+ * channel of the message type.
+ * @param id Binary ID.
+ * @return Channel ID.
+ */
+static inline uint8_t ChannelId(const uint8_t id) {
+    return IsCompact(id) ? (uint8_t) (id & ~0x20) : id;
+}
+
+/**
+ * @brief Returns true if the binary ID is that of a compact message.
+ * @param id Binary ID.
+ * @return True if the binary ID is that of a compact message.
+ */
+static inline bool IsCompact(const uint8_t id) {
+    return (id >= (0x80 + 'a')) && (id <= (0x80 + 'z'));
+}
+
+//------------------------------------------------------------------------------
+// Functions - Coding
+
+/**
+ * @brief Zigzag codes a two's complement value so that values of small
+ * magnitude are small.
+ * @param value Value.
+ * @param numberOfBits Number of bits.
+ * @return Zigzag coded value.
+ */
+static inline uint64_t Zigzag(const uint64_t value, const unsigned int numberOfBits) {
+    const uint64_t mask = numberOfBits < 64 ? ((UINT64_C(1) << numberOfBits) - 1) : UINT64_MAX;
+    const uint64_t sign = (value >> (numberOfBits - 1)) & 1;
+    return ((value << 1) ^ (0 - sign)) & mask;
+}
+
+/**
+ * @brief Reverses Zigzag.
+ * @param value Zigzag coded value.
+ * @param numberOfBits Number of bits.
+ * @return Two's complement value.
+ */
+static inline uint64_t Unzigzag(const uint64_t value, const unsigned int numberOfBits) {
+    const uint64_t mask = numberOfBits < 64 ? ((UINT64_C(1) << numberOfBits) - 1) : UINT64_MAX;
+    return ((value >> 1) ^ (0 - (value & 1))) & mask;
+}
+
+/**
+ * @brief Reads a little-endian word.
+ * @param source Source.
+ * @param wordSize Word size.
+ * @return Word.
+ */
+static inline uint64_t ReadWord(const uint8_t * const source, const size_t wordSize) {
+    uint64_t word = 0;
+    for (size_t index = 0; index < wordSize; index++) {
+        word |= (uint64_t) source[index] << (8 * index);
+    }
+    return word;
+}
+
+/**
+ * @brief Writes a little-endian word.
+ * @param destination Destination.
+ * @param wordSize Word size.
+ * @param word Word.
+ */
+static inline void WriteWord(uint8_t * const destination, const size_t wordSize, const uint64_t word) {
+    for (size_t index = 0; index < wordSize; index++) {
+        destination[index] = (uint8_t) (word >> (8 * index));
+    }
+}
+
+/**
+ * @brief Writes an unsigned LEB128 varint.
+ * @param destination Destination.
+ * @param value Value.
+ * @return Number of bytes.
+ */
+static size_t WriteVarint(uint8_t * const destination, uint64_t value) {
+    size_t index = 0;
+    do {
+        destination[index++] = (uint8_t) ((value & 0x7F) | (value > 0x7F ? 0x80 : 0x00));
+        value >>= 7;
+    } while (value > 0);
+    return index;
+}
+
+/**
+ * @brief Reads an unsigned LEB128 varint of up to 64 bits.
+ * @param source Source.
+ * @param numberOfBytes Number of bytes available.
+ * @param value Value.
+ * @return Number of bytes read. 0 if the varint is invalid.
+ */
+static size_t ReadVarint(const uint8_t * const source, const size_t numberOfBytes, uint64_t * const value) {
+    *value = 0;
+    for (size_t index = 0; (index < numberOfBytes) && (index < 10); index++) {
+        *value |= (uint64_t) (source[index] & 0x7F) << (7 * index);
+        if ((source[index] & 0x80) == 0) {
+            return index + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Passes an error message to the error callback.
+ * @param decompressor Decompressor.
+ * @param format Format.
+ * @param ... Arguments.
+ */
+static void Error(const Ximu3Decompressor * const decompressor, const char* const format, ...) {
+    if (decompressor->decompressError == NULL) {
+        return;
+    }
+    char string[256];
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(string, sizeof (string), format, arguments);
+    va_end(arguments);
+    decompressor->decompressError(string, decompressor->context);
+}
+
+//------------------------------------------------------------------------------
+// End of file
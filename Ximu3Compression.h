@@ -0,0 +1,132 @@
+/**
+ * @file Ximu3Compression.h
+ * @author Seb Madgwick
+ * @brief Streaming compression of binary data messages. Each binary data
+ * message is sent as a compressed message with the binary only ID
+ * XIMU3_ASCII_ID_COMPRESSED. The timestamp is sent as the delta from the
+ * previous timestamp and the payload as the delta from the previous payload of
+ * the same message type, as zigzag varints. The result is then LZ77 coded
+ * against a window of the preceding messages. The decompressor must receive
+ * every compressed message in order. The state is reset periodically so that
+ * the decompressor recovers from a lost message.
+ */
+
+#ifndef XIMU3_COMPRESSION_H
+#define XIMU3_COMPRESSION_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "Ximu3Binary.h"
+#include "Ximu3Size.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Window size of the LZ77 coding. Must be a power of two no greater
+ * than 1024.
+ */
+#define XIMU3_COMPRESSION_WINDOW_SIZE (1024)
+
+/**
+ * @brief Number of entries of the LZ77 hash table. Must be a power of two.
+ */
+#define XIMU3_COMPRESSION_HASH_SIZE (512)
+
+/**
+ * @brief Number of message types for which the previous payload is stored.
+ */
+#define XIMU3_COMPRESSION_NUMBER_OF_CHANNELS (8)
+
+/**
+ * @brief Maximum payload size that is sent as the delta from the previous
+ * payload. Larger payloads are sent unchanged.
+ */
+#define XIMU3_COMPRESSION_CHANNEL_SIZE (64)
+
+/**
+ * @brief Flags of compressed messages. XIMU3_COMPRESSION_FLAG_RESET indicates
+ * that the state was reset before the message was compressed. The delta flags
+ * indicate the word size of the payload delta. The payload is sent unchanged if
+ * neither delta flag is set. The remaining bits are a sequence number that
+ * allows the decompressor to detect a lost message.
+ */
+#define XIMU3_COMPRESSION_FLAG_RESET            (1 << 0)
+#define XIMU3_COMPRESSION_FLAG_DELTA_16_BIT     (1 << 1)
+#define XIMU3_COMPRESSION_FLAG_DELTA_32_BIT     (1 << 2)
+#define XIMU3_COMPRESSION_SEQUENCE_SHIFT        (3)
+#define XIMU3_COMPRESSION_SEQUENCE_MASK         (0x1F)
+
+/**
+ * @brief Previous payload of a message type.
+ */
+typedef struct {
+    uint8_t id; // uppercase binary ID, 0 if unused
+    size_t payloadSize;
+    uint8_t payload[XIMU3_COMPRESSION_CHANNEL_SIZE];
+} Ximu3CompressionChannel;
+
+/**
+ * @brief State common to the compressor and decompressor.
+ */
+typedef struct {
+    uint8_t window[XIMU3_COMPRESSION_WINDOW_SIZE];
+    uint32_t position;
+    Ximu3CompressionChannel channels[XIMU3_COMPRESSION_NUMBER_OF_CHANNELS];
+    size_t channelIndex;
+    uint64_t timestamp;
+    uint8_t sequence;
+} Ximu3CompressionState;
+
+/**
+ * @brief Compressor. There should be one instance per interface.
+ */
+typedef struct {
+    uint32_t resetPeriod; // maximum number of messages per reset, 0 to reset only after Ximu3CompressorReset
+    Ximu3BinaryPayloadFormat payloadFormat; // should match the binary payload format setting
+    Ximu3CompressionState state; // private
+    uint16_t hash[XIMU3_COMPRESSION_HASH_SIZE]; // private
+    uint32_t count; // private
+    bool stateValid; // private
+    uint8_t message[XIMU3_SIZE_BINARY_DECODER]; // private
+    uint8_t tokens[XIMU3_SIZE_COMPRESSION_TOKENS]; // private
+} Ximu3Compressor;
+
+/**
+ * @brief Decompressor. Compressed messages are written as the original binary
+ * data messages. All other bytes, e.g. uncompressed messages and command
+ * responses, are written unchanged. The output may be passed directly to
+ * Ximu3BinaryDecoderProcess.
+ */
+typedef struct {
+    void (*const write) (const void* const data, const size_t numberOfBytes, void* const context);
+    void (*const decompressError) (const char* const error, void* const context); // NULL if unused
+    void* context;
+    Ximu3CompressionState state; // private
+    bool stateValid; // private
+    uint8_t buffer[XIMU3_SIZE_COMPRESSION_FRAME]; // private
+    size_t index; // private
+    bool partial; // private
+    bool compressed; // private
+    bool escape; // private
+    bool discard; // private
+    uint8_t tokens[XIMU3_SIZE_COMPRESSION_TOKENS]; // private
+    uint8_t message[XIMU3_SIZE_BINARY_DECODER]; // private
+} Ximu3Decompressor;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+size_t Ximu3CompressorMessage(Ximu3Compressor * const compressor, void* const destination, const size_t destinationSize, const void* const message, const size_t messageSize);
+void Ximu3CompressorReset(Ximu3Compressor * const compressor);
+void Ximu3DecompressorProcess(Ximu3Decompressor * const decompressor, const void* const data, const size_t numberOfBytes);
+void Ximu3DecompressorReset(Ximu3Decompressor * const decompressor);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
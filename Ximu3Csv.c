@@ -0,0 +1,305 @@
+/**
+ * @file Ximu3Csv.c
+ * @author Seb Madgwick
+ * @brief CSV file writer for data messages.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "Ximu3Ascii.h"
+#include "Ximu3Csv.h"
+#include "Ximu3Data.h"
+#include "Ximu3Ltc.h"
+#include "Ximu3Size.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+#define TIMESTAMP_HEADING "Timestamp (us)"
+
+#define MAX_ROW_OVERHEAD (sizeof ("18446744073709551615\n") - 1) /* timestamp and termination */
+
+/**
+ * @brief Number of floats gathered before they are written.
+ */
+#define FLOATS_BLOCK (16)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline size_t NumberOfColumns(const Ximu3Csv * const csv);
+static inline const Ximu3DescriptorField* Column(const Ximu3Csv * const csv, const size_t column);
+static void Append(Ximu3Csv * const csv, const char* const data, const size_t numberOfBytes);
+static inline void WriteQuoted(char* const destination, size_t * const destinationIndex, const char* const string, const size_t length);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static const char* const inertialHeadings[] = {"Gyroscope X (deg/s)", "Gyroscope Y (deg/s)", "Gyroscope Z (deg/s)", "Accelerometer X (g)", "Accelerometer Y (g)", "Accelerometer Z (g)"};
+static const char* const magnetometerHeadings[] = {"X (a.u.)", "Y (a.u.)", "Z (a.u.)"};
+static const char* const highGAccelerometerHeadings[] = {"X (g)", "Y (g)", "Z (g)"};
+static const char* const quaternionHeadings[] = {"W", "X", "Y", "Z"};
+static const char* const rotationMatrixHeadings[] = {"XX", "XY", "XZ", "YX", "YY", "YZ", "ZX", "ZY", "ZZ"};
+static const char* const eulerAnglesHeadings[] = {"Roll (deg)", "Pitch (deg)", "Yaw (deg)"};
+static const char* const linearAccelerationHeadings[] = {"Quaternion W", "Quaternion X", "Quaternion Y", "Quaternion Z", "X (g)", "Y (g)", "Z (g)"};
+static const char* const earthAccelerationHeadings[] = {"Quaternion W", "Quaternion X", "Quaternion Y", "Quaternion Z", "X (g)", "Y (g)", "Z (g)"};
+static const char* const ahrsStatusHeadings[] = {"Initialising", "Angular Rate Recovery", "Acceleration Recovery", "Magnetic Recovery"};
+static const char* const serialAccessoryHeadings[] = {"Data"};
+static const char* const syncHeadings[] = {"Edge"};
+static const char* const ltcHeadings[] = {"Timecode"};
+static const char* const temperatureHeadings[] = {"Temperature (degC)"};
+static const char* const batteryHeadings[] = {"Percentage (%)", "Voltage (V)", "Charging Status"};
+static const char* const rssiHeadings[] = {"Percentage (%)", "Power (dBm)"};
+static const char* const buttonHeadings[] = {"State"};
+static const char* const notificationHeadings[] = {"Notification"};
+static const char* const errorHeadings[] = {"Error"};
+
+/**
+ * @brief Default headings indexed by ASCII ID. NULL for custom data messages.
+ */
+static const char* const* const defaultHeadings[128] = {
+    [XIMU3_ASCII_ID_INERTIAL] = inertialHeadings,
+    [XIMU3_ASCII_ID_MAGNETOMETER] = magnetometerHeadings,
+    [XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER] = highGAccelerometerHeadings,
+    [XIMU3_ASCII_ID_QUATERNION] = quaternionHeadings,
+    [XIMU3_ASCII_ID_ROTATION_MATRIX] = rotationMatrixHeadings,
+    [XIMU3_ASCII_ID_EULER_ANGLES] = eulerAnglesHeadings,
+    [XIMU3_ASCII_ID_LINEAR_ACCELERATION] = linearAccelerationHeadings,
+    [XIMU3_ASCII_ID_EARTH_ACCELERATION] = earthAccelerationHeadings,
+    [XIMU3_ASCII_ID_AHRS_STATUS] = ahrsStatusHeadings,
+    [XIMU3_ASCII_ID_SERIAL_ACCESSORY] = serialAccessoryHeadings,
+    [XIMU3_ASCII_ID_SYNC] = syncHeadings,
+    [XIMU3_ASCII_ID_LTC] = ltcHeadings,
+    [XIMU3_ASCII_ID_TEMPERATURE] = temperatureHeadings,
+    [XIMU3_ASCII_ID_BATTERY] = batteryHeadings,
+    [XIMU3_ASCII_ID_RSSI] = rssiHeadings,
+    [XIMU3_ASCII_ID_BUTTON] = buttonHeadings,
+    [XIMU3_ASCII_ID_NOTIFICATION] = notificationHeadings,
+    [XIMU3_ASCII_ID_ERROR] = errorHeadings,
+};
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Writes the headings row. Fields of a custom data message without
+ * headings are named by their index, e.g. "Field 0".
+ * @param csv CSV file.
+ */
+void Ximu3CsvHeadings(Ximu3Csv * const csv) {
+    const char* const* const headings = csv->headings != NULL ? csv->headings : defaultHeadings[(int) csv->descriptor->asciiId];
+    Append(csv, TIMESTAMP_HEADING, sizeof (TIMESTAMP_HEADING) - 1);
+    for (size_t column = 0; column < NumberOfColumns(csv); column++) {
+        const size_t fieldIndex = csv->columns != NULL ? csv->columns[column] : column;
+        char heading[32];
+        const char* string = heading;
+        if (headings != NULL) {
+            string = headings[fieldIndex];
+        } else {
+            snprintf(heading, sizeof (heading), "Field %u", (unsigned int) fieldIndex);
+        }
+        Append(csv, ",", 1);
+        Append(csv, string, strlen(string));
+    }
+    Append(csv, "\n", 1);
+}
+
+/**
+ * @brief Writes a row. The buffer is flushed first if the row may not fit.
+ * @param csv CSV file.
+ * @param data Data structure described by the descriptor.
+ * @return Result. Error if a column is not a descriptor field, the packed
+ * timecode of an LTC message is invalid, or the row is larger than the buffer.
+ */
+Ximu3Result Ximu3CsvRow(Ximu3Csv * const csv, const void* const data) {
+    const uint8_t* members = data;
+    const size_t numberOfColumns = NumberOfColumns(csv);
+
+    // Unpack timecode
+    Ximu3DataLtc ltc;
+    char timecode[XIMU3_LTC_TIMECODE_SIZE];
+    if ((csv->descriptor->asciiId == XIMU3_ASCII_ID_LTC) && (((const Ximu3DataLtc*) data)->timecode == NULL)) {
+        ltc = *(const Ximu3DataLtc*) data;
+        if (Ximu3LtcUnpack(ltc.packedTimecode, timecode) == false) {
+            return Ximu3ResultError;
+        }
+        ltc.timecode = timecode;
+        members = (const uint8_t*) &ltc;
+    }
+
+    // Flush if the largest possible row does not fit
+    size_t rowSize = MAX_ROW_OVERHEAD;
+    for (size_t column = 0; column < numberOfColumns; column++) {
+        const Ximu3DescriptorField * const field = Column(csv, column);
+        if (field == NULL) {
+            return Ximu3ResultError;
+        }
+        const uint8_t * const member = &members[field->offset];
+        switch (field->type) {
+            case Ximu3DescriptorFieldTypeFloat:
+            case Ximu3DescriptorFieldTypeBool:
+                rowSize += XIMU3_SIZE_ASCII_FLOAT;
+                break;
+            case Ximu3DescriptorFieldTypeString:
+            {
+                const char* string;
+                memcpy(&string, member, sizeof (string));
+                rowSize += 3 + (2 * (string == NULL ? 0 : strlen(string))); // comma, quotes and every character escaped
+                break;
+            }
+            case Ximu3DescriptorFieldTypeBytes:
+            {
+                size_t numberOfBytes;
+                memcpy(&numberOfBytes, &members[field->numberOfBytesOffset], sizeof (numberOfBytes));
+                rowSize += 3 + (2 * numberOfBytes);
+                break;
+            }
+        }
+    }
+    if (rowSize > csv->bufferSize) {
+        return Ximu3ResultError;
+    }
+    if (rowSize > (csv->bufferSize - csv->index)) {
+        Ximu3CsvFlush(csv);
+    }
+
+    // Timestamp
+    char * const destination = &((char*) csv->buffer)[csv->index];
+    const size_t destinationSize = csv->bufferSize - csv->index;
+    size_t destinationIndex = Ximu3AsciiUint64(destination, destinationSize, *(const uint64_t*) members);
+
+    // Columns
+    float floats[FLOATS_BLOCK];
+    size_t numberOfFloats = 0;
+    for (size_t column = 0; column < numberOfColumns; column++) {
+        const Ximu3DescriptorField * const field = Column(csv, column);
+        const uint8_t * const member = &members[field->offset];
+        if (field->type == Ximu3DescriptorFieldTypeFloat) {
+            memcpy(&floats[numberOfFloats++], member, sizeof (float));
+            if (numberOfFloats < FLOATS_BLOCK) {
+                continue;
+            }
+        }
+        destinationIndex += Ximu3AsciiFloats(&destination[destinationIndex], destinationSize - destinationIndex, floats, numberOfFloats, csv->precision);
+        numberOfFloats = 0;
+        switch (field->type) {
+            case Ximu3DescriptorFieldTypeFloat:
+                break;
+            case Ximu3DescriptorFieldTypeBool:
+                destination[destinationIndex++] = ',';
+                destination[destinationIndex++] = *(const bool*) member ? '1' : '0';
+                break;
+            case Ximu3DescriptorFieldTypeString:
+            {
+                const char* string;
+                memcpy(&string, member, sizeof (string));
+                WriteQuoted(destination, &destinationIndex, string, string == NULL ? 0 : strlen(string));
+                break;
+            }
+            case Ximu3DescriptorFieldTypeBytes:
+            {
+                const char* bytes;
+                size_t numberOfBytes;
+                memcpy(&bytes, member, sizeof (bytes));
+                memcpy(&numberOfBytes, &members[field->numberOfBytesOffset], sizeof (numberOfBytes));
+                WriteQuoted(destination, &destinationIndex, bytes, numberOfBytes);
+                break;
+            }
+        }
+    }
+    destinationIndex += Ximu3AsciiFloats(&destination[destinationIndex], destinationSize - destinationIndex, floats, numberOfFloats, csv->precision);
+    destination[destinationIndex++] = '\n';
+    csv->index += destinationIndex;
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Writes the buffer to the file. This must be called after the last
+ * row.
+ * @param csv CSV file.
+ */
+void Ximu3CsvFlush(Ximu3Csv * const csv) {
+    if (csv->index == 0) {
+        return;
+    }
+    csv->write(csv->buffer, csv->index, csv->context);
+    csv->index = 0;
+}
+
+/**
+ * @brief Returns the number of columns, excluding the timestamp.
+ * @param csv CSV file.
+ * @return Number of columns.
+ */
+static inline size_t NumberOfColumns(const Ximu3Csv * const csv) {
+    return csv->columns != NULL ? csv->numberOfColumns : csv->descriptor->numberOfFields;
+}
+
+/**
+ * @brief Returns the descriptor field of a column.
+ * @param csv CSV file.
+ * @param column Column index, excluding the timestamp.
+ * @return Descriptor field. NULL if the column is not a descriptor field.
+ */
+static inline const Ximu3DescriptorField* Column(const Ximu3Csv * const csv, const size_t column) {
+    const size_t fieldIndex = csv->columns != NULL ? csv->columns[column] : column;
+    if (fieldIndex >= csv->descriptor->numberOfFields) {
+        return NULL;
+    }
+    return &csv->descriptor->fields[fieldIndex];
+}
+
+/**
+ * @brief Appends bytes to the buffer. The buffer is flushed each time it is
+ * full.
+ * @param csv CSV file.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+static void Append(Ximu3Csv * const csv, const char* const data, const size_t numberOfBytes) {
+    size_t index = 0;
+    while (index < numberOfBytes) {
+        if (csv->index == csv->bufferSize) {
+            Ximu3CsvFlush(csv);
+        }
+        const size_t available = csv->bufferSize - csv->index;
+        const size_t chunkSize = (numberOfBytes - index) < available ? (numberOfBytes - index) : available;
+        memcpy(&((char*) csv->buffer)[csv->index], &data[index], chunkSize);
+        csv->index += chunkSize;
+        index += chunkSize;
+    }
+}
+
+/**
+ * @brief Writes a comma followed by a quoted field. Quotes are escaped as two
+ * quotes. Non-printable characters are replaced.
+ * @param destination Destination.
+ * @param destinationIndex Destination index.
+ * @param string String.
+ * @param length String length.
+ */
+static inline void WriteQuoted(char* const destination, size_t * const destinationIndex, const char* const string, const size_t length) {
+    size_t index = *destinationIndex;
+    destination[index++] = ',';
+    destination[index++] = '"';
+    for (size_t characterIndex = 0; characterIndex < length; characterIndex++) {
+        const char character = string[characterIndex];
+        if (((unsigned char) character < 0x20) || ((unsigned char) character > 0x7E)) {
+            destination[index++] = '?';
+            continue;
+        }
+        if (character == '"') {
+            destination[index++] = '"';
+        }
+        destination[index++] = character;
+    }
+    destination[index++] = '"';
+    *destinationIndex = index;
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,51 @@
+/**
+ * @file Ximu3Csv.h
+ * @author Seb Madgwick
+ * @brief CSV file writer for data messages.
+ */
+
+#ifndef XIMU3_CSV_H
+#define XIMU3_CSV_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stddef.h>
+#include "Ximu3Definitions.h"
+#include "Ximu3Descriptor.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief CSV file of one message type. Rows are written to the buffer and the
+ * buffer is written to the file when the next row may not fit, so the buffer
+ * should be large, e.g. 1 MB, for the file to be written in a few large
+ * writes. The first column is always the timestamp. Floats are written with
+ * the ASCII data message formatter, bools as 0 or 1, and strings and bytes as
+ * quoted fields.
+ */
+typedef struct {
+    const Ximu3Descriptor* descriptor;
+    const size_t* columns; // indices of the descriptor fields written, in order, NULL to write all fields
+    size_t numberOfColumns; // ignored if columns is NULL
+    const char* const* headings; // one per descriptor field, NULL to use the default headings
+    int precision; // number of decimal places of floats, e.g. XIMU3_ASCII_PRECISION_DEFAULT
+    void* buffer;
+    size_t bufferSize;
+    void (*const write) (const void* const data, const size_t numberOfBytes, void* const context);
+    void* context;
+    size_t index; // private
+} Ximu3Csv;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void Ximu3CsvHeadings(Ximu3Csv * const csv);
+Ximu3Result Ximu3CsvRow(Ximu3Csv * const csv, const void* const data);
+void Ximu3CsvFlush(Ximu3Csv * const csv);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -148,7 +148,8 @@ typedef struct {
  */
 typedef struct {
     uint64_t timestamp;
-    const char* timecode;
+    const char* timecode; // NULL if packedTimecode is used
+    uint32_t packedTimecode; // see Ximu3LtcPack
 } Ximu3DataLtc;
 
 /**
@@ -202,6 +203,23 @@ typedef struct {
     const char* error;
 } Ximu3DataError;
 
+/**
+ * @brief Composite data message. Binary only. Each member is NULL if not
+ * included. The timestamp of each included message is ignored.
+ */
+typedef struct {
+    uint64_t timestamp;
+    const Ximu3DataInertial* inertial;
+    const Ximu3DataMagnetometer* magnetometer;
+    const Ximu3DataHighGAccelerometer* highGAccelerometer;
+    const Ximu3DataTemperature* temperature;
+    const Ximu3DataQuaternion* quaternion;
+    const Ximu3DataRotationMatrix* rotationMatrix;
+    const Ximu3DataEulerAngles* eulerAngles;
+    const Ximu3DataLinearAcceleration* linearAcceleration;
+    const Ximu3DataEarthAcceleration* earthAcceleration;
+} Ximu3DataComposite;
+
 #endif
 
 //------------------------------------------------------------------------------
@@ -28,12 +28,27 @@ Ximu3Result Ximu3SettingsIndexFrom(Ximu3SettingsIndex * const index, const int i
         case Ximu3SettingsIndexBinaryModeEnabled:
             *index = Ximu3SettingsIndexBinaryModeEnabled;
             break;
+        case Ximu3SettingsIndexBinaryPayloadFormat:
+            *index = Ximu3SettingsIndexBinaryPayloadFormat;
+            break;
+        case Ximu3SettingsIndexBinaryQuaternionCompression:
+            *index = Ximu3SettingsIndexBinaryQuaternionCompression;
+            break;
+        case Ximu3SettingsIndexAsciiPrecision:
+            *index = Ximu3SettingsIndexAsciiPrecision;
+            break;
         case Ximu3SettingsIndexUsbDataMessagesEnabled:
             *index = Ximu3SettingsIndexUsbDataMessagesEnabled;
             break;
+        case Ximu3SettingsIndexUsbBinaryFraming:
+            *index = Ximu3SettingsIndexUsbBinaryFraming;
+            break;
         case Ximu3SettingsIndexSerialDataMessagesEnabled:
             *index = Ximu3SettingsIndexSerialDataMessagesEnabled;
             break;
+        case Ximu3SettingsIndexSerialBinaryFraming:
+            *index = Ximu3SettingsIndexSerialBinaryFraming;
+            break;
         case Ximu3SettingsIndexExampleFloat:
             *index = Ximu3SettingsIndexExampleFloat;
             break;
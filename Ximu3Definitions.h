@@ -6,9 +6,9 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-#define XIMU3_MAX_KEY_LENGTH (28)
+#define XIMU3_MAX_KEY_LENGTH (29)
 
-#define XIMU3_NUMBER_OF_SETTINGS (11)
+#define XIMU3_NUMBER_OF_SETTINGS (16)
 
 #define XIMU3_TERMINATION '\n'
 
@@ -32,8 +32,13 @@ typedef struct {
     uint32_t serialBaudRate;
     bool serialRtsCtsEnabled;
     bool binaryModeEnabled;
+    uint32_t binaryPayloadFormat;
+    uint32_t binaryQuaternionCompression;
+    uint32_t asciiPrecision;
     bool usbDataMessagesEnabled;
+    uint32_t usbBinaryFraming;
     bool serialDataMessagesEnabled;
+    uint32_t serialBinaryFraming;
     float exampleFloat;
 } Ximu3SettingsValues;
 
@@ -46,8 +51,13 @@ typedef enum {
     Ximu3SettingsIndexSerialBaudRate,
     Ximu3SettingsIndexSerialRtsCtsEnabled,
     Ximu3SettingsIndexBinaryModeEnabled,
+    Ximu3SettingsIndexBinaryPayloadFormat,
+    Ximu3SettingsIndexBinaryQuaternionCompression,
+    Ximu3SettingsIndexAsciiPrecision,
     Ximu3SettingsIndexUsbDataMessagesEnabled,
+    Ximu3SettingsIndexUsbBinaryFraming,
     Ximu3SettingsIndexSerialDataMessagesEnabled,
+    Ximu3SettingsIndexSerialBinaryFraming,
     Ximu3SettingsIndexExampleFloat,
 } Ximu3SettingsIndex;
 
@@ -0,0 +1,311 @@
+/**
+ * @file Ximu3Descriptor.c
+ * @author Seb Madgwick
+ * @brief Data message descriptors. A descriptor lists the fields of a data
+ * message so that the message can be written by a generic encoder. Custom data
+ * messages may be registered at runtime.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include "Ximu3Ascii.h"
+#include "Ximu3Data.h"
+#include "Ximu3Descriptor.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Float field.
+ */
+#define FLOAT(structure, member) { .type = Ximu3DescriptorFieldTypeFloat, .offset = offsetof(structure, member) }
+
+/**
+ * @brief Bool field.
+ */
+#define BOOL(structure, member) { .type = Ximu3DescriptorFieldTypeBool, .offset = offsetof(structure, member) }
+
+/**
+ * @brief String field.
+ */
+#define STRING(structure, member) { .type = Ximu3DescriptorFieldTypeString, .offset = offsetof(structure, member) }
+
+/**
+ * @brief Bytes field.
+ */
+#define BYTES(structure, member, numberOfBytes) { .type = Ximu3DescriptorFieldTypeBytes, .offset = offsetof(structure, member), .numberOfBytesOffset = offsetof(structure, numberOfBytes) }
+
+/**
+ * @brief Descriptor.
+ */
+#define DESCRIPTOR(id, structure, fields_) { .asciiId = id, .size = sizeof (structure), .fields = fields_, .numberOfFields = sizeof (fields_) / sizeof (fields_[0]) }
+
+//------------------------------------------------------------------------------
+// Variables
+
+static const Ximu3DescriptorField inertialFields[] = {
+    FLOAT(Ximu3DataInertial, gyroscopeX),
+    FLOAT(Ximu3DataInertial, gyroscopeY),
+    FLOAT(Ximu3DataInertial, gyroscopeZ),
+    FLOAT(Ximu3DataInertial, accelerometerX),
+    FLOAT(Ximu3DataInertial, accelerometerY),
+    FLOAT(Ximu3DataInertial, accelerometerZ),
+};
+
+static const Ximu3DescriptorField magnetometerFields[] = {
+    FLOAT(Ximu3DataMagnetometer, x),
+    FLOAT(Ximu3DataMagnetometer, y),
+    FLOAT(Ximu3DataMagnetometer, z),
+};
+
+static const Ximu3DescriptorField highGAccelerometerFields[] = {
+    FLOAT(Ximu3DataHighGAccelerometer, x),
+    FLOAT(Ximu3DataHighGAccelerometer, y),
+    FLOAT(Ximu3DataHighGAccelerometer, z),
+};
+
+static const Ximu3DescriptorField quaternionFields[] = {
+    FLOAT(Ximu3DataQuaternion, w),
+    FLOAT(Ximu3DataQuaternion, x),
+    FLOAT(Ximu3DataQuaternion, y),
+    FLOAT(Ximu3DataQuaternion, z),
+};
+
+static const Ximu3DescriptorField rotationMatrixFields[] = {
+    FLOAT(Ximu3DataRotationMatrix, xx),
+    FLOAT(Ximu3DataRotationMatrix, xy),
+    FLOAT(Ximu3DataRotationMatrix, xz),
+    FLOAT(Ximu3DataRotationMatrix, yx),
+    FLOAT(Ximu3DataRotationMatrix, yy),
+    FLOAT(Ximu3DataRotationMatrix, yz),
+    FLOAT(Ximu3DataRotationMatrix, zx),
+    FLOAT(Ximu3DataRotationMatrix, zy),
+    FLOAT(Ximu3DataRotationMatrix, zz),
+};
+
+static const Ximu3DescriptorField eulerAnglesFields[] = {
+    FLOAT(Ximu3DataEulerAngles, roll),
+    FLOAT(Ximu3DataEulerAngles, pitch),
+    FLOAT(Ximu3DataEulerAngles, yaw),
+};
+
+static const Ximu3DescriptorField linearAccelerationFields[] = {
+    FLOAT(Ximu3DataLinearAcceleration, quaternionW),
+    FLOAT(Ximu3DataLinearAcceleration, quaternionX),
+    FLOAT(Ximu3DataLinearAcceleration, quaternionY),
+    FLOAT(Ximu3DataLinearAcceleration, quaternionZ),
+    FLOAT(Ximu3DataLinearAcceleration, linearAccelerationX),
+    FLOAT(Ximu3DataLinearAcceleration, linearAccelerationY),
+    FLOAT(Ximu3DataLinearAcceleration, linearAccelerationZ),
+};
+
+static const Ximu3DescriptorField earthAccelerationFields[] = {
+    FLOAT(Ximu3DataEarthAcceleration, quaternionW),
+    FLOAT(Ximu3DataEarthAcceleration, quaternionX),
+    FLOAT(Ximu3DataEarthAcceleration, quaternionY),
+    FLOAT(Ximu3DataEarthAcceleration, quaternionZ),
+    FLOAT(Ximu3DataEarthAcceleration, earthAccelerationX),
+    FLOAT(Ximu3DataEarthAcceleration, earthAccelerationY),
+    FLOAT(Ximu3DataEarthAcceleration, earthAccelerationZ),
+};
+
+static const Ximu3DescriptorField ahrsStatusFields[] = {
+    BOOL(Ximu3DataAhrsStatus, initialising),
+    BOOL(Ximu3DataAhrsStatus, angularRateRecovery),
+    BOOL(Ximu3DataAhrsStatus, accelerationRecovery),
+    BOOL(Ximu3DataAhrsStatus, magneticRecovery),
+};
+
+static const Ximu3DescriptorField serialAccessoryFields[] = {
+    BYTES(Ximu3DataSerialAccessory, data, numberOfBytes),
+};
+
+static const Ximu3DescriptorField syncFields[] = {
+    BOOL(Ximu3DataSync, edge),
+};
+
+static const Ximu3DescriptorField ltcFields[] = {
+    STRING(Ximu3DataLtc, timecode),
+};
+
+static const Ximu3DescriptorField temperatureFields[] = {
+    FLOAT(Ximu3DataTemperature, temperature),
+};
+
+static const Ximu3DescriptorField batteryFields[] = {
+    FLOAT(Ximu3DataBattery, percentage),
+    FLOAT(Ximu3DataBattery, voltage),
+    FLOAT(Ximu3DataBattery, chargingStatus),
+};
+
+static const Ximu3DescriptorField rssiFields[] = {
+    FLOAT(Ximu3DataRssi, percentage),
+    FLOAT(Ximu3DataRssi, power),
+};
+
+static const Ximu3DescriptorField buttonFields[] = {
+    BOOL(Ximu3DataButton, state),
+};
+
+static const Ximu3DescriptorField notificationFields[] = {
+    STRING(Ximu3DataNotification, notification),
+};
+
+static const Ximu3DescriptorField errorFields[] = {
+    STRING(Ximu3DataError, error),
+};
+
+const Ximu3Descriptor ximu3DescriptorInertial = DESCRIPTOR(XIMU3_ASCII_ID_INERTIAL, Ximu3DataInertial, inertialFields);
+const Ximu3Descriptor ximu3DescriptorMagnetometer = DESCRIPTOR(XIMU3_ASCII_ID_MAGNETOMETER, Ximu3DataMagnetometer, magnetometerFields);
+const Ximu3Descriptor ximu3DescriptorHighGAccelerometer = DESCRIPTOR(XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER, Ximu3DataHighGAccelerometer, highGAccelerometerFields);
+const Ximu3Descriptor ximu3DescriptorQuaternion = DESCRIPTOR(XIMU3_ASCII_ID_QUATERNION, Ximu3DataQuaternion, quaternionFields);
+const Ximu3Descriptor ximu3DescriptorRotationMatrix = DESCRIPTOR(XIMU3_ASCII_ID_ROTATION_MATRIX, Ximu3DataRotationMatrix, rotationMatrixFields);
+const Ximu3Descriptor ximu3DescriptorEulerAngles = DESCRIPTOR(XIMU3_ASCII_ID_EULER_ANGLES, Ximu3DataEulerAngles, eulerAnglesFields);
+const Ximu3Descriptor ximu3DescriptorLinearAcceleration = DESCRIPTOR(XIMU3_ASCII_ID_LINEAR_ACCELERATION, Ximu3DataLinearAcceleration, linearAccelerationFields);
+const Ximu3Descriptor ximu3DescriptorEarthAcceleration = DESCRIPTOR(XIMU3_ASCII_ID_EARTH_ACCELERATION, Ximu3DataEarthAcceleration, earthAccelerationFields);
+const Ximu3Descriptor ximu3DescriptorAhrsStatus = DESCRIPTOR(XIMU3_ASCII_ID_AHRS_STATUS, Ximu3DataAhrsStatus, ahrsStatusFields);
+const Ximu3Descriptor ximu3DescriptorSerialAccessory = DESCRIPTOR(XIMU3_ASCII_ID_SERIAL_ACCESSORY, Ximu3DataSerialAccessory, serialAccessoryFields);
+const Ximu3Descriptor ximu3DescriptorSync = DESCRIPTOR(XIMU3_ASCII_ID_SYNC, Ximu3DataSync, syncFields);
+const Ximu3Descriptor ximu3DescriptorLtc = DESCRIPTOR(XIMU3_ASCII_ID_LTC, Ximu3DataLtc, ltcFields);
+const Ximu3Descriptor ximu3DescriptorTemperature = DESCRIPTOR(XIMU3_ASCII_ID_TEMPERATURE, Ximu3DataTemperature, temperatureFields);
+const Ximu3Descriptor ximu3DescriptorBattery = DESCRIPTOR(XIMU3_ASCII_ID_BATTERY, Ximu3DataBattery, batteryFields);
+const Ximu3Descriptor ximu3DescriptorRssi = DESCRIPTOR(XIMU3_ASCII_ID_RSSI, Ximu3DataRssi, rssiFields);
+const Ximu3Descriptor ximu3DescriptorButton = DESCRIPTOR(XIMU3_ASCII_ID_BUTTON, Ximu3DataButton, buttonFields);
+const Ximu3Descriptor ximu3DescriptorNotification = DESCRIPTOR(XIMU3_ASCII_ID_NOTIFICATION, Ximu3DataNotification, notificationFields);
+const Ximu3Descriptor ximu3DescriptorError = DESCRIPTOR(XIMU3_ASCII_ID_ERROR, Ximu3DataError, errorFields);
+
+/**
+ * @brief Placeholder for IDs that are reserved or binary only.
+ */
+static const Ximu3Descriptor reserved = {0};
+
+/**
+ * @brief Descriptors indexed by ASCII ID.
+ */
+static const Ximu3Descriptor* const builtIns[128] = {
+    [XIMU3_ASCII_ID_INERTIAL] = &ximu3DescriptorInertial,
+    [XIMU3_ASCII_ID_MAGNETOMETER] = &ximu3DescriptorMagnetometer,
+    [XIMU3_ASCII_ID_HIGH_G_ACCELEROMETER] = &ximu3DescriptorHighGAccelerometer,
+    [XIMU3_ASCII_ID_PRESSURE] = &reserved,
+    [XIMU3_ASCII_ID_QUATERNION] = &ximu3DescriptorQuaternion,
+    [XIMU3_ASCII_ID_ROTATION_MATRIX] = &ximu3DescriptorRotationMatrix,
+    [XIMU3_ASCII_ID_EULER_ANGLES] = &ximu3DescriptorEulerAngles,
+    [XIMU3_ASCII_ID_LINEAR_ACCELERATION] = &ximu3DescriptorLinearAcceleration,
+    [XIMU3_ASCII_ID_EARTH_ACCELERATION] = &ximu3DescriptorEarthAcceleration,
+    [XIMU3_ASCII_ID_DELTA] = &reserved,
+    [XIMU3_ASCII_ID_AHRS_STATUS] = &ximu3DescriptorAhrsStatus,
+    [XIMU3_ASCII_ID_MAGNETIC_COMPASS] = &reserved,
+    [XIMU3_ASCII_ID_GNSS] = &reserved,
+    [XIMU3_ASCII_ID_SERIAL_ACCESSORY] = &ximu3DescriptorSerialAccessory,
+    [XIMU3_ASCII_ID_SYNC] = &ximu3DescriptorSync,
+    [XIMU3_ASCII_ID_LTC] = &ximu3DescriptorLtc,
+    [XIMU3_ASCII_ID_TEMPERATURE] = &ximu3DescriptorTemperature,
+    [XIMU3_ASCII_ID_BATTERY] = &ximu3DescriptorBattery,
+    [XIMU3_ASCII_ID_RSSI] = &ximu3DescriptorRssi,
+    [XIMU3_ASCII_ID_BUTTON] = &ximu3DescriptorButton,
+    [XIMU3_ASCII_ID_NOTIFICATION] = &ximu3DescriptorNotification,
+    [XIMU3_ASCII_ID_ERROR] = &ximu3DescriptorError,
+    [XIMU3_ASCII_ID_AGGREGATE] = &reserved,
+    [XIMU3_ASCII_ID_COMPOSITE] = &reserved,
+    [XIMU3_ASCII_ID_COMPRESSED] = &reserved,
+};
+
+/**
+ * @brief Registered custom descriptors indexed by ASCII ID.
+ */
+static const Ximu3Descriptor* customs[128];
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline bool IsCustomId(const char asciiId);
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Registers a custom data message. The ID must be an uppercase letter
+ * or digit that is not used by another data message. Custom data messages
+ * only support the 32-bit float payload format. The descriptor must remain
+ * valid until unregistered.
+ * @param descriptor Descriptor.
+ * @return Result.
+ */
+Ximu3Result Ximu3DescriptorRegister(const Ximu3Descriptor * const descriptor) {
+    if ((IsCustomId(descriptor->asciiId) == false) || (customs[(int) descriptor->asciiId] != NULL)) {
+        return Ximu3ResultError;
+    }
+    if ((descriptor->size < sizeof (uint64_t)) || (descriptor->size > XIMU3_DESCRIPTOR_MAX_SIZE)) {
+        return Ximu3ResultError;
+    }
+    for (size_t index = 0; index < descriptor->numberOfFields; index++) {
+        const Ximu3DescriptorField * const field = &descriptor->fields[index];
+        size_t fieldSize;
+        switch (field->type) {
+            case Ximu3DescriptorFieldTypeFloat:
+                fieldSize = sizeof (float);
+                break;
+            case Ximu3DescriptorFieldTypeBool:
+                fieldSize = sizeof (bool);
+                break;
+            case Ximu3DescriptorFieldTypeString:
+            case Ximu3DescriptorFieldTypeBytes:
+                if (index != (descriptor->numberOfFields - 1)) {
+                    return Ximu3ResultError; // must be the last field
+                }
+                fieldSize = sizeof (void*);
+                break;
+            default:
+                return Ximu3ResultError;
+        }
+        if ((field->offset < sizeof (uint64_t)) || ((field->offset + fieldSize) > descriptor->size)) {
+            return Ximu3ResultError;
+        }
+        if ((field->type == Ximu3DescriptorFieldTypeBytes) && ((field->numberOfBytesOffset + sizeof (size_t)) > descriptor->size)) {
+            return Ximu3ResultError;
+        }
+    }
+    customs[(int) descriptor->asciiId] = descriptor;
+    return Ximu3ResultOk;
+}
+
+/**
+ * @brief Unregisters a custom data message.
+ * @param asciiId ASCII ID.
+ */
+void Ximu3DescriptorUnregister(const char asciiId) {
+    if (IsCustomId(asciiId) == false) {
+        return;
+    }
+    customs[(int) asciiId] = NULL;
+}
+
+/**
+ * @brief Returns the descriptor of a data message.
+ * @param asciiId ASCII ID.
+ * @return Descriptor. NULL if the ID is not used by a data message.
+ */
+const Ximu3Descriptor* Ximu3DescriptorFind(const char asciiId) {
+    if ((asciiId < 0) || (builtIns[(int) asciiId] == &reserved)) {
+        return NULL;
+    }
+    if (builtIns[(int) asciiId] != NULL) {
+        return builtIns[(int) asciiId];
+    }
+    return customs[(int) asciiId];
+}
+
+/**
+ * @brief Returns true if the ID may be used by a custom data message.
+ * @param asciiId ASCII ID.
+ * @return True if the ID may be used by a custom data message.
+ */
+static inline bool IsCustomId(const char asciiId) {
+    const bool valid = ((asciiId >= 'A') && (asciiId <= 'Z')) || ((asciiId >= '0') && (asciiId <= '9'));
+    return valid && (builtIns[(int) asciiId] == NULL);
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,93 @@
+/**
+ * @file Ximu3Descriptor.h
+ * @author Seb Madgwick
+ * @brief Data message descriptors. A descriptor lists the fields of a data
+ * message so that the message can be written by a generic encoder. Custom data
+ * messages may be registered at runtime.
+ */
+
+#ifndef XIMU3_DESCRIPTOR_H
+#define XIMU3_DESCRIPTOR_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Ximu3Definitions.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Field type.
+ */
+typedef enum {
+    Ximu3DescriptorFieldTypeFloat, // float
+    Ximu3DescriptorFieldTypeBool, // bool, written as a float
+    Ximu3DescriptorFieldTypeString, // const char*
+    Ximu3DescriptorFieldTypeBytes, // const uint8_t*, followed by the number of bytes
+} Ximu3DescriptorFieldType;
+
+/**
+ * @brief Field. The offset is the offsetof() of the member within the data
+ * structure.
+ */
+typedef struct {
+    Ximu3DescriptorFieldType type;
+    uint16_t offset;
+    uint16_t numberOfBytesOffset; // offsetof() of the size_t number of bytes, Ximu3DescriptorFieldTypeBytes only
+} Ximu3DescriptorField;
+
+/**
+ * @brief Descriptor. The first member of the data structure must be the
+ * uint64_t timestamp. A string or bytes field must be the last field. A NULL
+ * string is written as an empty string, except the timecode of an LTC
+ * message, for which the packed timecode is written instead.
+ */
+typedef struct {
+    char asciiId;
+    size_t size; // sizeof() of the data structure
+    const Ximu3DescriptorField* fields;
+    size_t numberOfFields;
+} Ximu3Descriptor;
+
+/**
+ * @brief Maximum size of the data structure of a custom data message that may
+ * be decoded.
+ */
+#define XIMU3_DESCRIPTOR_MAX_SIZE (256)
+
+/**
+ * @brief Descriptors of the data messages.
+ */
+extern const Ximu3Descriptor ximu3DescriptorInertial;
+extern const Ximu3Descriptor ximu3DescriptorMagnetometer;
+extern const Ximu3Descriptor ximu3DescriptorHighGAccelerometer;
+extern const Ximu3Descriptor ximu3DescriptorQuaternion;
+extern const Ximu3Descriptor ximu3DescriptorRotationMatrix;
+extern const Ximu3Descriptor ximu3DescriptorEulerAngles;
+extern const Ximu3Descriptor ximu3DescriptorLinearAcceleration;
+extern const Ximu3Descriptor ximu3DescriptorEarthAcceleration;
+extern const Ximu3Descriptor ximu3DescriptorAhrsStatus;
+extern const Ximu3Descriptor ximu3DescriptorSerialAccessory;
+extern const Ximu3Descriptor ximu3DescriptorSync;
+extern const Ximu3Descriptor ximu3DescriptorLtc;
+extern const Ximu3Descriptor ximu3DescriptorTemperature;
+extern const Ximu3Descriptor ximu3DescriptorBattery;
+extern const Ximu3Descriptor ximu3DescriptorRssi;
+extern const Ximu3Descriptor ximu3DescriptorButton;
+extern const Ximu3Descriptor ximu3DescriptorNotification;
+extern const Ximu3Descriptor ximu3DescriptorError;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+Ximu3Result Ximu3DescriptorRegister(const Ximu3Descriptor * const descriptor);
+void Ximu3DescriptorUnregister(const char asciiId);
+const Ximu3Descriptor* Ximu3DescriptorFind(const char asciiId);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
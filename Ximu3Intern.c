@@ -0,0 +1,79 @@
+/**
+ * @file Ximu3Intern.c
+ * @author Seb Madgwick
+ * @brief String intern table for notification and error messages. The first
+ * occurrence of a string is sent as a definition of the string and its index.
+ * Later occurrences are sent as the index only. Strings too long to be
+ * interned are sent unchanged.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <string.h>
+#include "Ximu3Intern.h"
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Returns the index of a string in the table.
+ * @param intern Intern table.
+ * @param string String.
+ * @return Index. -1 if the string is not in the table.
+ */
+int Ximu3InternFind(const Ximu3Intern * const intern, const char* const string) {
+    if (string[0] == '\0') {
+        return -1;
+    }
+    for (int index = 0; index < XIMU3_INTERN_NUMBER_OF_STRINGS; index++) {
+        if (strcmp(intern->strings[index], string) == 0) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Returns the index at which Ximu3InternAdd will add a string.
+ * @param intern Intern table.
+ * @param string String.
+ * @return Index. -1 if the string is empty or too long to be interned.
+ */
+int Ximu3InternNext(const Ximu3Intern * const intern, const char* const string) {
+    const size_t length = strlen(string);
+    if ((length == 0) || (length >= XIMU3_INTERN_STRING_SIZE)) {
+        return -1;
+    }
+    return (int) intern->index;
+}
+
+/**
+ * @brief Adds a string to the table. The least recently added string is
+ * replaced if the table is full. This should only be called once the
+ * definition has been written.
+ * @param intern Intern table.
+ * @param string String.
+ */
+void Ximu3InternAdd(Ximu3Intern * const intern, const char* const string) {
+    if (Ximu3InternNext(intern, string) < 0) {
+        return;
+    }
+    strcpy(intern->strings[intern->index], string);
+    intern->index = (intern->index + 1) % XIMU3_INTERN_NUMBER_OF_STRINGS;
+}
+
+/**
+ * @brief Empties the table so that each string is defined again. This should
+ * be called when the interface reconnects.
+ * @param intern Intern table.
+ */
+void Ximu3InternReset(Ximu3Intern * const intern) {
+    for (int index = 0; index < XIMU3_INTERN_NUMBER_OF_STRINGS; index++) {
+        intern->strings[index][0] = '\0';
+    }
+    intern->index = 0;
+}
+
+//------------------------------------------------------------------------------
+// End of file
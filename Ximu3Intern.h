@@ -0,0 +1,65 @@
+/**
+ * @file Ximu3Intern.h
+ * @author Seb Madgwick
+ * @brief String intern table for notification and error messages. The first
+ * occurrence of a string is sent as a definition of the string and its index.
+ * Later occurrences are sent as the index only. Strings too long to be
+ * interned are sent unchanged.
+ */
+
+#ifndef XIMU3_INTERN_H
+#define XIMU3_INTERN_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of strings in the table. Must not exceed 128.
+ */
+#define XIMU3_INTERN_NUMBER_OF_STRINGS (16)
+
+/**
+ * @brief Maximum string size including the null terminator.
+ */
+#define XIMU3_INTERN_STRING_SIZE (64)
+
+/**
+ * @brief Flag of the index byte of a binary interned string indicating that the
+ * string follows.
+ */
+#define XIMU3_INTERN_FLAG_DEFINITION (1 << 7)
+
+/**
+ * @brief Non-printable character that precedes an ASCII interned string.
+ * Plain strings are written with non-printable characters replaced and so
+ * cannot be mistaken for an interned string.
+ */
+#define XIMU3_INTERN_ASCII_MARKER ('\x1F')
+
+/**
+ * @brief Intern table. There should be one instance per interface. A zero
+ * initialised instance is empty.
+ */
+typedef struct {
+    char strings[XIMU3_INTERN_NUMBER_OF_STRINGS][XIMU3_INTERN_STRING_SIZE]; // private
+    uint32_t index; // private
+} Ximu3Intern;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+int Ximu3InternFind(const Ximu3Intern * const intern, const char* const string);
+int Ximu3InternNext(const Ximu3Intern * const intern, const char* const string);
+void Ximu3InternAdd(Ximu3Intern * const intern, const char* const string);
+void Ximu3InternReset(Ximu3Intern * const intern);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,113 @@
+/**
+ * @file Ximu3Ltc.c
+ * @author Seb Madgwick
+ * @brief LTC timecode packed into 4 bytes. The least significant byte is the
+ * frames, followed by the seconds, minutes and hours. The most significant
+ * bit of the frames byte indicates drop-frame timecode, written as
+ * "hh:mm:ss;ff".
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Ximu3Ltc.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum value of each field, from the frames to the hours. Frames
+ * allow up to 60 frames per second.
+ */
+static const uint8_t maximums[] = {59, 59, 59, 23};
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline bool ReadField(const char* const string, uint8_t * const value);
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Packs a timecode string. For example:
+ *
+ * uint32_t packedTimecode;
+ * if (Ximu3LtcPack("01:23:45:12", &packedTimecode)) {
+ *     const Ximu3DataLtc data = {.timestamp = timestamp, .packedTimecode = packedTimecode};
+ * }
+ *
+ * @param timecode Timecode string as "hh:mm:ss:ff" or "hh:mm:ss;ff".
+ * @param packedTimecode Packed timecode. Only valid if the function returns
+ * true.
+ * @return True if the timecode is valid.
+ */
+bool Ximu3LtcPack(const char* const timecode, uint32_t * const packedTimecode) {
+    uint8_t fields[4];
+    bool dropFrame = false;
+    for (int index = 3; index >= 0; index--) {
+        const char* const field = &timecode[9 - (3 * index)];
+        if ((ReadField(field, &fields[index]) == false) || (fields[index] > maximums[index])) {
+            return false;
+        }
+        if (index == 0) {
+            if (field[2] != '\0') {
+                return false;
+            }
+            break;
+        }
+        if ((index == 1) && (field[2] == ';')) {
+            dropFrame = true;
+        } else if (field[2] != ':') {
+            return false;
+        }
+    }
+    if (dropFrame) {
+        fields[0] |= XIMU3_LTC_FLAG_DROP_FRAME;
+    }
+    *packedTimecode = (uint32_t) fields[0] | ((uint32_t) fields[1] << 8) | ((uint32_t) fields[2] << 16) | ((uint32_t) fields[3] << 24);
+    return true;
+}
+
+/**
+ * @brief Unpacks a timecode string.
+ * @param packedTimecode Packed timecode.
+ * @param timecode Timecode string of XIMU3_LTC_TIMECODE_SIZE. Only valid if the
+ * function returns true.
+ * @return True if the packed timecode is valid.
+ */
+bool Ximu3LtcUnpack(const uint32_t packedTimecode, char* const timecode) {
+    for (int index = 0; index < 4; index++) {
+        uint8_t field = (uint8_t) (packedTimecode >> (8 * index));
+        if (index == 0) {
+            field &= ~XIMU3_LTC_FLAG_DROP_FRAME;
+        }
+        if (field > maximums[index]) {
+            return false;
+        }
+        timecode[9 - (3 * index)] = (char) ('0' + (field / 10));
+        timecode[10 - (3 * index)] = (char) ('0' + (field % 10));
+    }
+    timecode[2] = ':';
+    timecode[5] = ':';
+    timecode[8] = (packedTimecode & XIMU3_LTC_FLAG_DROP_FRAME) != 0 ? ';' : ':';
+    timecode[11] = '\0';
+    return true;
+}
+
+/**
+ * @brief Reads a two-digit field.
+ * @param string String.
+ * @param value Value.
+ * @return True if the field is two digits.
+ */
+static inline bool ReadField(const char* const string, uint8_t * const value) {
+    if ((string[0] < '0') || (string[0] > '9') || (string[1] < '0') || (string[1] > '9')) {
+        return false;
+    }
+    *value = (uint8_t) (((string[0] - '0') * 10) + (string[1] - '0'));
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// End of file
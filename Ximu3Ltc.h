@@ -0,0 +1,41 @@
+/**
+ * @file Ximu3Ltc.h
+ * @author Seb Madgwick
+ * @brief LTC timecode packed into 4 bytes. The least significant byte is the
+ * frames, followed by the seconds, minutes and hours. The most significant
+ * bit of the frames byte indicates drop-frame timecode, written as
+ * "hh:mm:ss;ff".
+ */
+
+#ifndef XIMU3_LTC_H
+#define XIMU3_LTC_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Size of a timecode string including the null terminator.
+ */
+#define XIMU3_LTC_TIMECODE_SIZE (sizeof ("hh:mm:ss:ff"))
+
+/**
+ * @brief Drop-frame flag of the frames byte.
+ */
+#define XIMU3_LTC_FLAG_DROP_FRAME (1 << 7)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+bool Ximu3LtcPack(const char* const timecode, uint32_t * const packedTimecode);
+bool Ximu3LtcUnpack(const uint32_t packedTimecode, char* const timecode);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
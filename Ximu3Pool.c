@@ -0,0 +1,49 @@
+/**
+ * @file Ximu3Pool.c
+ * @author Seb Madgwick
+ * @brief Pool of fixed-size message buffers. A pool per message type allows
+ * queued messages to use slots of the exact worst-case size of that type.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <string.h>
+#include "Ximu3Pool.h"
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Allocates a slot. Freed slots form a list linked through the first
+ * bytes of each slot so that both allocation and free are constant time.
+ * @param pool Pool.
+ * @return Slot of slotSize bytes. NULL if all slots are allocated.
+ */
+void* Ximu3PoolAlloc(Ximu3Pool * const pool) {
+    if (pool->free != NULL) {
+        uint8_t * const slot = pool->free;
+        memcpy(&pool->free, slot, sizeof (pool->free)); // slot may not be aligned
+        return slot;
+    }
+    if (pool->numberOfUsedSlots < pool->numberOfSlots) {
+        return &((uint8_t*) pool->slots)[pool->slotSize * pool->numberOfUsedSlots++];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Frees a slot.
+ * @param pool Pool.
+ * @param slot Slot returned by Ximu3PoolAlloc. Ignored if NULL.
+ */
+void Ximu3PoolFree(Ximu3Pool * const pool, void* const slot) {
+    if (slot == NULL) {
+        return;
+    }
+    memcpy(slot, &pool->free, sizeof (pool->free));
+    pool->free = slot;
+}
+
+//------------------------------------------------------------------------------
+// End of file
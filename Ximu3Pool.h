@@ -0,0 +1,43 @@
+/**
+ * @file Ximu3Pool.h
+ * @author Seb Madgwick
+ * @brief Pool of fixed-size message buffers. A pool per message type allows
+ * queued messages to use slots of the exact worst-case size of that type.
+ */
+
+#ifndef XIMU3_POOL_H
+#define XIMU3_POOL_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Pool. The slots are numberOfSlots consecutive buffers of slotSize
+ * bytes, e.g. static uint8_t slots[8][XIMU3_SIZE_BINARY_INERTIAL]. The slot
+ * size must be at least sizeof(void*). Slots are allocated in order until all
+ * have been used once, and then from the slots that have been freed.
+ */
+typedef struct {
+    void* slots;
+    size_t slotSize;
+    size_t numberOfSlots;
+    size_t numberOfUsedSlots; // private
+    uint8_t* free; // private
+} Ximu3Pool;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void* Ximu3PoolAlloc(Ximu3Pool * const pool);
+void Ximu3PoolFree(Ximu3Pool * const pool, void* const slot);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
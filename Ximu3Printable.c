@@ -0,0 +1,160 @@
+/**
+ * @file Ximu3Printable.c
+ * @author Seb Madgwick
+ * @brief Copies characters with non-printable characters replaced by '?'.
+ * Printable characters are 0x20 to 0x7E.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "Ximu3Printable.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define PRINTABLE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PRINTABLE_NEON
+#endif
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Machine word used to copy characters that are all printable.
+ */
+#if UINTPTR_MAX > 0xFFFFFFFF
+typedef uint64_t Word;
+#else
+typedef uint32_t Word;
+#endif
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline bool WordPrintable(const Word word);
+static inline char Printable(const char character);
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Copies characters with non-printable characters replaced by '?'.
+ * Characters are copied 16 at a time using SSE2 or NEON where available, with
+ * the last 16 overlapping the previous 16, and otherwise one machine word at a
+ * time if all characters of the word are printable. The destination and
+ * source must not overlap.
+ * @param destination Destination.
+ * @param source Source.
+ * @param numberOfCharacters Number of characters.
+ */
+void Ximu3PrintableCopy(char* const destination, const char* const source, const size_t numberOfCharacters) {
+    size_t index = 0;
+#if defined(PRINTABLE_SSE2)
+    if (numberOfCharacters >= 16) {
+        const __m128i lower = _mm_set1_epi8(0x20 - 1);
+        const __m128i upper = _mm_set1_epi8(0x7E + 1);
+        const __m128i replacement = _mm_set1_epi8('?');
+        while (true) {
+            const __m128i characters = _mm_loadu_si128((const __m128i*) &source[index]);
+            const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(characters, lower), _mm_cmplt_epi8(characters, upper)); // signed so 0x80 to 0xFF are less than lower
+            _mm_storeu_si128((__m128i*) &destination[index], _mm_or_si128(_mm_and_si128(printable, characters), _mm_andnot_si128(printable, replacement)));
+            if (index == (numberOfCharacters - 16)) {
+                return;
+            }
+            index += 16;
+            if ((numberOfCharacters - index) < 16) {
+                index = numberOfCharacters - 16; // last block overlaps the previous block
+            }
+        }
+    }
+#elif defined(PRINTABLE_NEON)
+    if (numberOfCharacters >= 16) {
+        const int8x16_t lower = vdupq_n_s8(0x20 - 1);
+        const int8x16_t upper = vdupq_n_s8(0x7E + 1);
+        const int8x16_t replacement = vdupq_n_s8('?');
+        while (true) {
+            const int8x16_t characters = vld1q_s8((const int8_t*) &source[index]);
+            const uint8x16_t printable = vandq_u8(vcgtq_s8(characters, lower), vcltq_s8(characters, upper)); // signed so 0x80 to 0xFF are less than lower
+            vst1q_s8((int8_t*) &destination[index], vbslq_s8(printable, characters, replacement));
+            if (index == (numberOfCharacters - 16)) {
+                return;
+            }
+            index += 16;
+            if ((numberOfCharacters - index) < 16) {
+                index = numberOfCharacters - 16; // last block overlaps the previous block
+            }
+        }
+    }
+#endif
+    while ((numberOfCharacters - index) >= sizeof (Word)) {
+        Word word;
+        memcpy(&word, &source[index], sizeof (word));
+        if (WordPrintable(word)) {
+            memcpy(&destination[index], &word, sizeof (word));
+        } else {
+            for (size_t wordIndex = 0; wordIndex < sizeof (Word); wordIndex++) {
+                destination[index + wordIndex] = Printable(source[index + wordIndex]);
+            }
+        }
+        index += sizeof (Word);
+    }
+    for (; index < numberOfCharacters; index++) {
+        destination[index] = Printable(source[index]);
+    }
+}
+
+/**
+ * @brief Copies a string with non-printable characters replaced by '?'. The
+ * string is truncated if longer than the destination size minus the null
+ * terminator.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param string String.
+ * @return String length written, excluding the null terminator.
+ */
+size_t Ximu3PrintableCopyString(char* const destination, const size_t destinationSize, const char* const string) {
+    if (destinationSize == 0) {
+        return 0;
+    }
+    const char* const terminator = memchr(string, '\0', destinationSize - 1);
+    const size_t length = terminator != NULL ? (size_t) (terminator - string) : destinationSize - 1;
+    Ximu3PrintableCopy(destination, string, length);
+    destination[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief Returns true if all characters of the word are printable. A byte is
+ * less than 0x20 if its most significant bit is clear and becomes set when
+ * 0x20 is subtracted, and greater than 0x7E if its most significant bit is set
+ * or becomes set when 1 is added.
+ * @param word Word.
+ * @return True if all characters of the word are printable.
+ */
+static inline bool WordPrintable(const Word word) {
+    const Word ones = ((Word) ~(Word) 0) / 0xFF; // 0x0101...
+    const Word highs = ones * 0x80;
+    const Word less = (word - (ones * 0x20)) & ~word & highs;
+    const Word greater = ((word + ones) | word) & highs;
+    return (less | greater) == 0;
+}
+
+/**
+ * @brief Returns the character if printable, otherwise '?'.
+ * @param character Character.
+ * @return Printable character.
+ */
+static inline char Printable(const char character) {
+    if (((unsigned char) character < 0x20) || ((unsigned char) character > 0x7E)) {
+        return '?';
+    }
+    return character;
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,25 @@
+/**
+ * @file Ximu3Printable.h
+ * @author Seb Madgwick
+ * @brief Copies characters with non-printable characters replaced by '?'.
+ * Printable characters are 0x20 to 0x7E.
+ */
+
+#ifndef XIMU3_PRINTABLE_H
+#define XIMU3_PRINTABLE_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void Ximu3PrintableCopy(char* const destination, const char* const source, const size_t numberOfCharacters);
+size_t Ximu3PrintableCopyString(char* const destination, const size_t destinationSize, const char* const string);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
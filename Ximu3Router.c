@@ -0,0 +1,180 @@
+/**
+ * @file Ximu3Router.c
+ * @author Seb Madgwick
+ * @brief Routes data messages to the interfaces that have data messages
+ * enabled. Each message is encoded once per distinct format and the encoded
+ * message is written to every interface that uses that format.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdbool.h>
+#include "Ximu3Ascii.h"
+#include "Ximu3Router.h"
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static bool Formatted(const Ximu3Router * const router, const Ximu3Descriptor * const descriptor);
+static size_t BinaryMessage(const Ximu3Router * const router, void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data);
+static void Write(const Ximu3Router * const router, const uint32_t interfaces, const void* const message, const size_t messageSize);
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Determines the interfaces of each format from the settings. An
+ * interface is included if it has a writer and data messages enabled. All
+ * interfaces use ASCII if binary mode is disabled, otherwise the binary
+ * framing of the interface.
+ * @param router Router.
+ * @param values Settings values.
+ */
+void Ximu3RouterApply(Ximu3Router * const router, const Ximu3SettingsValues * const values) {
+    const bool enabled[XIMU3_ROUTER_NUMBER_OF_INTERFACES] = {
+        [Ximu3RouterInterfaceUsb] = values->usbDataMessagesEnabled,
+        [Ximu3RouterInterfaceSerial] = values->serialEnabled && values->serialDataMessagesEnabled,
+    };
+    const uint32_t framing[XIMU3_ROUTER_NUMBER_OF_INTERFACES] = {
+        [Ximu3RouterInterfaceUsb] = values->usbBinaryFraming,
+        [Ximu3RouterInterfaceSerial] = values->serialBinaryFraming,
+    };
+    router->asciiInterfaces = 0;
+    router->binaryInterfaces = 0;
+    router->cobsInterfaces = 0;
+    for (int index = 0; index < XIMU3_ROUTER_NUMBER_OF_INTERFACES; index++) {
+        if ((router->writers[index] == NULL) || (enabled[index] == false)) {
+            continue;
+        }
+        if (values->binaryModeEnabled == false) {
+            router->asciiInterfaces |= 1 << index;
+        } else if (framing[index] == Ximu3BinaryFramingCobs) {
+            router->cobsInterfaces |= 1 << index;
+        } else {
+            router->binaryInterfaces |= 1 << index;
+        }
+    }
+    router->precision = (int) values->asciiPrecision;
+    router->payloadFormat = (Ximu3BinaryPayloadFormat) values->binaryPayloadFormat;
+    router->quaternionCompression = (Ximu3BinaryQuaternionCompression) values->binaryQuaternionCompression;
+}
+
+/**
+ * @brief Writes a data message described by a descriptor to each interface.
+ * The message is encoded once for all ASCII interfaces, once for all binary
+ * interfaces, and once for all COBS interfaces. COBS messages are written
+ * directly from the data unless a payload format or quaternion compression
+ * applies, in which case the binary message is converted. Nothing is written
+ * if the message cannot be encoded, e.g. an LTC message with an invalid packed
+ * timecode.
+ * @param router Router.
+ * @param descriptor Descriptor.
+ * @param data Data.
+ */
+void Ximu3RouterMessage(Ximu3Router * const router, const Ximu3Descriptor * const descriptor, const void* const data) {
+    if (router->asciiInterfaces != 0) {
+        Write(router, router->asciiInterfaces, router->message, Ximu3AsciiMessagePrecision(router->message, sizeof (router->message), descriptor, data, router->precision));
+    }
+    if ((router->binaryInterfaces | router->cobsInterfaces) == 0) {
+        return;
+    }
+
+    // Payload format or quaternion compression
+    if (Formatted(router, descriptor)) {
+        uint8_t message[XIMU3_SIZE_BINARY_ROTATION_MATRIX]; // largest message with a payload format or quaternion compression
+        const size_t messageSize = BinaryMessage(router, message, sizeof (message), descriptor, data);
+        if (router->binaryInterfaces != 0) {
+            Write(router, router->binaryInterfaces, message, messageSize);
+        }
+        if (router->cobsInterfaces != 0) {
+            Write(router, router->cobsInterfaces, router->message, Ximu3BinaryCobs(router->message, sizeof (router->message), message, messageSize));
+        }
+        return;
+    }
+
+    // Descriptor
+    if (router->binaryInterfaces != 0) {
+        Write(router, router->binaryInterfaces, router->message, Ximu3BinaryMessage(router->message, sizeof (router->message), descriptor, data));
+    }
+    if (router->cobsInterfaces != 0) {
+        Write(router, router->cobsInterfaces, router->message, Ximu3BinaryMessageCobs(router->message, sizeof (router->message), descriptor, data));
+    }
+}
+
+/**
+ * @brief Returns true if the payload format or quaternion compression of the
+ * settings is applicable to the message type.
+ * @param router Router.
+ * @param descriptor Descriptor.
+ * @return True if the payload format or quaternion compression is applicable.
+ */
+static bool Formatted(const Ximu3Router * const router, const Ximu3Descriptor * const descriptor) {
+    if ((descriptor == &ximu3DescriptorQuaternion) || (descriptor == &ximu3DescriptorLinearAcceleration) || (descriptor == &ximu3DescriptorEarthAcceleration)) {
+        return (router->payloadFormat != Ximu3BinaryPayloadFormatFloat32) || (router->quaternionCompression != Ximu3BinaryQuaternionCompressionNone);
+    }
+    if ((descriptor == &ximu3DescriptorInertial) || (descriptor == &ximu3DescriptorMagnetometer) || (descriptor == &ximu3DescriptorHighGAccelerometer) ||
+        (descriptor == &ximu3DescriptorRotationMatrix) || (descriptor == &ximu3DescriptorEulerAngles) || (descriptor == &ximu3DescriptorTemperature)) {
+        return router->payloadFormat != Ximu3BinaryPayloadFormatFloat32;
+    }
+    return false;
+}
+
+/**
+ * @brief Writes a binary data message with the payload format and quaternion
+ * compression of the settings if applicable to the message type.
+ * @param router Router.
+ * @param destination Destination.
+ * @param destinationSize Destination size.
+ * @param descriptor Descriptor.
+ * @param data Data.
+ * @return Message size.
+ */
+static size_t BinaryMessage(const Ximu3Router * const router, void* const destination, const size_t destinationSize, const Ximu3Descriptor * const descriptor, const void* const data) {
+    if (descriptor == &ximu3DescriptorInertial) {
+        return Ximu3BinaryInertialPayloadFormat(destination, destinationSize, data, router->payloadFormat);
+    }
+    if (descriptor == &ximu3DescriptorMagnetometer) {
+        return Ximu3BinaryMagnetometerPayloadFormat(destination, destinationSize, data, router->payloadFormat);
+    }
+    if (descriptor == &ximu3DescriptorHighGAccelerometer) {
+        return Ximu3BinaryHighGAccelerometerPayloadFormat(destination, destinationSize, data, router->payloadFormat);
+    }
+    if (descriptor == &ximu3DescriptorQuaternion) {
+        return Ximu3BinaryQuaternionCompressed(destination, destinationSize, data, router->payloadFormat, router->quaternionCompression);
+    }
+    if (descriptor == &ximu3DescriptorRotationMatrix) {
+        return Ximu3BinaryRotationMatrixPayloadFormat(destination, destinationSize, data, router->payloadFormat);
+    }
+    if (descriptor == &ximu3DescriptorEulerAngles) {
+        return Ximu3BinaryEulerAnglesPayloadFormat(destination, destinationSize, data, router->payloadFormat);
+    }
+    if (descriptor == &ximu3DescriptorLinearAcceleration) {
+        return Ximu3BinaryLinearAccelerationCompressed(destination, destinationSize, data, router->payloadFormat, router->quaternionCompression);
+    }
+    if (descriptor == &ximu3DescriptorEarthAcceleration) {
+        return Ximu3BinaryEarthAccelerationCompressed(destination, destinationSize, data, router->payloadFormat, router->quaternionCompression);
+    }
+    if (descriptor == &ximu3DescriptorTemperature) {
+        return Ximu3BinaryTemperaturePayloadFormat(destination, destinationSize, data, router->payloadFormat);
+    }
+    return Ximu3BinaryMessage(destination, destinationSize, descriptor, data);
+}
+
+/**
+ * @brief Writes an encoded message to each interface.
+ * @param router Router.
+ * @param interfaces Interfaces as bits indexed by Ximu3RouterInterface.
+ * @param message Message.
+ * @param messageSize Message size.
+ */
+static void Write(const Ximu3Router * const router, const uint32_t interfaces, const void* const message, const size_t messageSize) {
+    for (int index = 0; index < XIMU3_ROUTER_NUMBER_OF_INTERFACES; index++) {
+        if ((interfaces & (1 << index)) != 0) {
+            Ximu3WriterWrite(router->writers[index], message, messageSize);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,64 @@
+/**
+ * @file Ximu3Router.h
+ * @author Seb Madgwick
+ * @brief Routes data messages to the interfaces that have data messages
+ * enabled. Each message is encoded once per distinct format and the encoded
+ * message is written to every interface that uses that format.
+ */
+
+#ifndef XIMU3_ROUTER_H
+#define XIMU3_ROUTER_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stdint.h>
+#include "Ximu3Binary.h"
+#include "Ximu3Definitions.h"
+#include "Ximu3Descriptor.h"
+#include "Ximu3Size.h"
+#include "Ximu3Writer.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Interface. Values are indices of the router writers.
+ */
+typedef enum {
+    Ximu3RouterInterfaceUsb,
+    Ximu3RouterInterfaceSerial,
+} Ximu3RouterInterface;
+
+/**
+ * @brief Number of interfaces.
+ */
+#define XIMU3_ROUTER_NUMBER_OF_INTERFACES (2)
+
+/**
+ * @brief Router. The interfaces of each format are determined by
+ * Ximu3RouterApply and are not recomputed for each message, so
+ * Ximu3RouterApply must be called on startup and each time the settings are
+ * applied.
+ */
+typedef struct {
+    const Ximu3Writer* writers[XIMU3_ROUTER_NUMBER_OF_INTERFACES]; // indexed by Ximu3RouterInterface, NULL if unused
+    uint32_t asciiInterfaces; // private
+    uint32_t binaryInterfaces; // private
+    uint32_t cobsInterfaces; // private
+    int precision; // private
+    Ximu3BinaryPayloadFormat payloadFormat; // private
+    Ximu3BinaryQuaternionCompression quaternionCompression; // private
+    uint8_t message[XIMU3_SIZE_ROUTER]; // private
+} Ximu3Router;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+void Ximu3RouterApply(Ximu3Router * const router, const Ximu3SettingsValues * const values);
+void Ximu3RouterMessage(Ximu3Router * const router, const Ximu3Descriptor * const descriptor, const void* const data);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -11,6 +11,7 @@
 #include <math.h>
 #include "Metadata.h"
 #include <string.h>
+#include "Ximu3Printable.h"
 #include "Ximu3Settings.h"
 
 //------------------------------------------------------------------------------
@@ -154,19 +155,8 @@ static bool IsNanOrInf(const float value) {
  * @param string String.
  */
 static void CopyString(char* const destination, const size_t destinationSize, const char* string) {
-    for (size_t index = 0; index < destinationSize; index++) {
-        if (*string == '\0') {
-            destination[index] = *string;
-            continue;
-        }
-        if (((unsigned char) *string < 0x20) || ((unsigned char) *string > 0x7E)) {
-            destination[index] = '?';
-        } else {
-            destination[index] = *string;
-        }
-        string++;
-    }
-    destination[destinationSize - 1] = '\0';
+    const size_t length = Ximu3PrintableCopyString(destination, destinationSize, string);
+    memset(&destination[length], 0, destinationSize - length);
 }
 
 /**
@@ -20,8 +20,9 @@
 
 #define XIMU3_SIZE_BYTE_STUFFING(n)             (2 * (n)) /* worst case after byte stuffing */
 
-#define XIMU3_SIZE_BINARY_OVERHEAD              (2 + XIMU3_SIZE_BYTE_STUFFING(8)) /* ID + termination + 64-bit timestamp */
+#define XIMU3_SIZE_BINARY_OVERHEAD              (2 + XIMU3_SIZE_BYTE_STUFFING(8)) /* ID + termination + 64-bit timestamp, byte stuffing not applicable to ID (0x80 + ASCII ID) or termination */
 #define XIMU3_SIZE_BINARY_FLOAT                 XIMU3_SIZE_BYTE_STUFFING(4) /* 32-bit float */
+#define XIMU3_SIZE_BINARY_BOOL                  (4) /* bool written as 0.0f or 1.0f, byte stuffing not applicable */
 #define XIMU3_SIZE_BINARY_CHAR_ARRAY            XIMU3_SIZE_BYTE_STUFFING(XIMU3_SIZE_CHAR_ARRAY)
 
 #define XIMU3_SIZE_BINARY_INERTIAL              (XIMU3_SIZE_BINARY_OVERHEAD + (6 * XIMU3_SIZE_BINARY_FLOAT))
@@ -32,20 +33,89 @@
 #define XIMU3_SIZE_BINARY_EULER_ANGLES          (XIMU3_SIZE_BINARY_OVERHEAD + (3 * XIMU3_SIZE_BINARY_FLOAT))
 #define XIMU3_SIZE_BINARY_LINEAR_ACCELERATION   (XIMU3_SIZE_BINARY_OVERHEAD + (7 * XIMU3_SIZE_BINARY_FLOAT))
 #define XIMU3_SIZE_BINARY_EARTH_ACCELERATION    (XIMU3_SIZE_BINARY_OVERHEAD + (7 * XIMU3_SIZE_BINARY_FLOAT))
-#define XIMU3_SIZE_BINARY_AHRS_STATUS           (XIMU3_SIZE_BINARY_OVERHEAD + (4 * XIMU3_SIZE_BINARY_FLOAT))
+#define XIMU3_SIZE_BINARY_AHRS_STATUS           (XIMU3_SIZE_BINARY_OVERHEAD + (4 * XIMU3_SIZE_BINARY_BOOL))
 #define XIMU3_SIZE_BINARY_SERIAL_ACCESSORY      (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_CHAR_ARRAY)
-#define XIMU3_SIZE_BINARY_SYNC                  (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_FLOAT)
+#define XIMU3_SIZE_BINARY_SYNC                  (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_BOOL)
 #define XIMU3_SIZE_BINARY_LTC                   (XIMU3_SIZE_BINARY_OVERHEAD + sizeof ("hh:mm:ss:ff") - 1) /* byte stuffing not applicable to timecode */
 #define XIMU3_SIZE_BINARY_TEMPERATURE           (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_FLOAT)
 #define XIMU3_SIZE_BINARY_BATTERY               (XIMU3_SIZE_BINARY_OVERHEAD + (3 * XIMU3_SIZE_BINARY_FLOAT))
 #define XIMU3_SIZE_BINARY_RSSI                  (XIMU3_SIZE_BINARY_OVERHEAD + (2 * XIMU3_SIZE_BINARY_FLOAT))
-#define XIMU3_SIZE_BINARY_BUTTON                (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_FLOAT)
+#define XIMU3_SIZE_BINARY_BUTTON                (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_BOOL)
 #define XIMU3_SIZE_BINARY_NOTIFICATION          (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_CHAR_ARRAY)
 #define XIMU3_SIZE_BINARY_ERROR                 (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_CHAR_ARRAY)
 
+#define XIMU3_SIZE_BINARY_16_BIT                XIMU3_SIZE_BYTE_STUFFING(2) /* 16-bit half float or scaled integer */
+
+#define XIMU3_SIZE_BINARY_INERTIAL_16_BIT               (XIMU3_SIZE_BINARY_OVERHEAD + (6 * XIMU3_SIZE_BINARY_16_BIT))
+#define XIMU3_SIZE_BINARY_MAGNETOMETER_16_BIT           (XIMU3_SIZE_BINARY_OVERHEAD + (3 * XIMU3_SIZE_BINARY_16_BIT))
+#define XIMU3_SIZE_BINARY_HIGH_G_ACCELEROMETER_16_BIT   (XIMU3_SIZE_BINARY_OVERHEAD + (3 * XIMU3_SIZE_BINARY_16_BIT))
+#define XIMU3_SIZE_BINARY_QUATERNION_16_BIT             (XIMU3_SIZE_BINARY_OVERHEAD + (4 * XIMU3_SIZE_BINARY_16_BIT))
+#define XIMU3_SIZE_BINARY_ROTATION_MATRIX_16_BIT        (XIMU3_SIZE_BINARY_OVERHEAD + (9 * XIMU3_SIZE_BINARY_16_BIT))
+#define XIMU3_SIZE_BINARY_EULER_ANGLES_16_BIT           (XIMU3_SIZE_BINARY_OVERHEAD + (3 * XIMU3_SIZE_BINARY_16_BIT))
+#define XIMU3_SIZE_BINARY_LINEAR_ACCELERATION_16_BIT    (XIMU3_SIZE_BINARY_OVERHEAD + (7 * XIMU3_SIZE_BINARY_16_BIT))
+#define XIMU3_SIZE_BINARY_EARTH_ACCELERATION_16_BIT     (XIMU3_SIZE_BINARY_OVERHEAD + (7 * XIMU3_SIZE_BINARY_16_BIT))
+#define XIMU3_SIZE_BINARY_TEMPERATURE_16_BIT            (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_16_BIT)
+
+#define XIMU3_SIZE_BINARY_COMPRESSED_QUATERNION_32_BIT  XIMU3_SIZE_BYTE_STUFFING(4)
+#define XIMU3_SIZE_BINARY_COMPRESSED_QUATERNION_48_BIT  XIMU3_SIZE_BYTE_STUFFING(6)
+
+#define XIMU3_SIZE_BINARY_QUATERNION_COMPRESSED             (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_COMPRESSED_QUATERNION_48_BIT) /* either compression */
+#define XIMU3_SIZE_BINARY_LINEAR_ACCELERATION_COMPRESSED    (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_COMPRESSED_QUATERNION_48_BIT + (3 * XIMU3_SIZE_BINARY_FLOAT)) /* either compression and any payload format */
+#define XIMU3_SIZE_BINARY_EARTH_ACCELERATION_COMPRESSED     (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_COMPRESSED_QUATERNION_48_BIT + (3 * XIMU3_SIZE_BINARY_FLOAT)) /* either compression and any payload format */
+
+#define XIMU3_SIZE_BINARY_FLAGS                 (1) /* byte stuffing not applicable to flags of 0 or 1 */
+
+#define XIMU3_SIZE_BINARY_AHRS_STATUS_PACKED    (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BYTE_STUFFING(1)) /* flags may be 0x0A */
+#define XIMU3_SIZE_BINARY_SYNC_PACKED           (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_FLAGS)
+#define XIMU3_SIZE_BINARY_BUTTON_PACKED         (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_FLAGS)
+#define XIMU3_SIZE_BINARY_LTC_PACKED            (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BYTE_STUFFING(4))
+
+#define XIMU3_SIZE_BINARY_AGGREGATE             (512) /* aggregate message buffer */
+
+#define XIMU3_SIZE_BINARY_COMPOSITE             (XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BYTE_STUFFING(1) + 1 + (43 * XIMU3_SIZE_BINARY_FLOAT)) /* all types included, byte stuffing not applicable to the most significant byte of the presence bitmask */
+
+#define XIMU3_SIZE_BINARY_COMPACT_OVERHEAD      (2 + XIMU3_SIZE_BYTE_STUFFING(3)) /* ID + termination + 21-bit varint timestamp delta */
+#define XIMU3_SIZE_BINARY_COMPACT(n)            ((n) - XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BINARY_COMPACT_OVERHEAD) /* e.g. XIMU3_SIZE_BINARY_COMPACT(XIMU3_SIZE_BINARY_INERTIAL) */
+
+#define XIMU3_SIZE_COBS(n)                      ((n) + ((n) / 254) + 1) /* worst case after COBS */
+
+#define XIMU3_SIZE_BINARY_COBS(n)               (2 + XIMU3_SIZE_COBS(8 + (n))) /* ID + termination + 64-bit timestamp and n-byte payload after COBS */
+
+#define XIMU3_SIZE_BINARY_COBS_INERTIAL             XIMU3_SIZE_BINARY_COBS(6 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_MAGNETOMETER         XIMU3_SIZE_BINARY_COBS(3 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_HIGH_G_ACCELEROMETER XIMU3_SIZE_BINARY_COBS(3 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_QUATERNION           XIMU3_SIZE_BINARY_COBS(4 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_ROTATION_MATRIX      XIMU3_SIZE_BINARY_COBS(9 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_EULER_ANGLES         XIMU3_SIZE_BINARY_COBS(3 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_LINEAR_ACCELERATION  XIMU3_SIZE_BINARY_COBS(7 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_EARTH_ACCELERATION   XIMU3_SIZE_BINARY_COBS(7 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_AHRS_STATUS          XIMU3_SIZE_BINARY_COBS(4 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_SERIAL_ACCESSORY     XIMU3_SIZE_BINARY_COBS(XIMU3_SIZE_CHAR_ARRAY)
+#define XIMU3_SIZE_BINARY_COBS_SYNC                 XIMU3_SIZE_BINARY_COBS(sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_LTC                  XIMU3_SIZE_BINARY_COBS(sizeof ("hh:mm:ss:ff") - 1)
+#define XIMU3_SIZE_BINARY_COBS_TEMPERATURE          XIMU3_SIZE_BINARY_COBS(sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_BATTERY              XIMU3_SIZE_BINARY_COBS(3 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_RSSI                 XIMU3_SIZE_BINARY_COBS(2 * sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_BUTTON               XIMU3_SIZE_BINARY_COBS(sizeof (float))
+#define XIMU3_SIZE_BINARY_COBS_NOTIFICATION         XIMU3_SIZE_BINARY_COBS(XIMU3_SIZE_CHAR_ARRAY)
+#define XIMU3_SIZE_BINARY_COBS_ERROR                XIMU3_SIZE_BINARY_COBS(XIMU3_SIZE_CHAR_ARRAY)
+#define XIMU3_SIZE_BINARY_COBS_COMPOSITE            XIMU3_SIZE_BINARY_COBS(2 + (43 * sizeof (float))) /* all types included */
+#define XIMU3_SIZE_BINARY_COBS_AGGREGATE            (2 + XIMU3_SIZE_COBS(XIMU3_SIZE_BINARY_AGGREGATE - 2))
+
+#define XIMU3_SIZE_BINARY_DECODER               XIMU3_SIZE_MAX(XIMU3_SIZE_BINARY_COBS(XIMU3_SIZE_CHAR_ARRAY), XIMU3_SIZE_BINARY_COBS_AGGREGATE) /* largest message before COBS decoding or after byte stuffing removed, the termination is replaced by a null terminator */
+
+#define XIMU3_SIZE_COMPRESSION_LZ77(n)          ((n) + 1 + ((n) / 128)) /* worst case after LZ77 coding */
+#define XIMU3_SIZE_COMPRESSION_TOKENS           (XIMU3_SIZE_BINARY_DECODER + 2) /* largest message after delta coding, the 64-bit timestamp becomes a varint of up to 10 bytes */
+#define XIMU3_SIZE_COMPRESSION_FRAME            (2 + XIMU3_SIZE_COMPRESSION_LZ77(XIMU3_SIZE_COMPRESSION_TOKENS)) /* largest compressed message after byte stuffing removed, ID + flags + LZ77 coded message */
+#define XIMU3_SIZE_COMPRESSED(n)                (2 + XIMU3_SIZE_BYTE_STUFFING(1 + XIMU3_SIZE_COMPRESSION_LZ77((n) + 1))) /* worst case after compression of an n-byte binary message, e.g. XIMU3_SIZE_COMPRESSED(XIMU3_SIZE_BINARY_INERTIAL) */
+
 #define XIMU3_SIZE_ASCII_OVERHEAD           	(sizeof ("X,00112233445566778899\n") - 1)
-#define XIMU3_SIZE_ASCII_FLOAT              	(sizeof (",-999999.9999") - 1)
+#define XIMU3_SIZE_ASCII_COMPACT_OVERHEAD       (sizeof ("x,2097151\n") - 1)
+#define XIMU3_SIZE_ASCII_COMPACT(n)             ((n) - XIMU3_SIZE_ASCII_OVERHEAD + XIMU3_SIZE_ASCII_COMPACT_OVERHEAD) /* e.g. XIMU3_SIZE_ASCII_COMPACT(XIMU3_SIZE_ASCII_INERTIAL) */
+#define XIMU3_SIZE_ASCII_FLOAT_PRECISION(p)     (sizeof (",-999999") - 1 + (((p) > 0) ? (1 + (p)) : 0)) /* p decimal places, e.g. XIMU3_SIZE_ASCII_FLOAT_PRECISION(2) */
+#define XIMU3_SIZE_ASCII_FLOAT              	XIMU3_SIZE_ASCII_FLOAT_PRECISION(6) /* maximum precision */
 #define XIMU3_SIZE_ASCII_CHAR_ARRAY             (sizeof (",") - 1 + XIMU3_SIZE_CHAR_ARRAY)
+#define XIMU3_SIZE_ASCII_BOOL                   (sizeof (",1.000000") - 1) /* bool written as 0 or 1 at maximum precision */
 
 #define XIMU3_SIZE_ASCII_INERTIAL           	(XIMU3_SIZE_ASCII_OVERHEAD + (6 * XIMU3_SIZE_ASCII_FLOAT))
 #define XIMU3_SIZE_ASCII_MAGNETOMETER       	(XIMU3_SIZE_ASCII_OVERHEAD + (3 * XIMU3_SIZE_ASCII_FLOAT))
@@ -55,17 +125,19 @@
 #define XIMU3_SIZE_ASCII_EULER_ANGLES       	(XIMU3_SIZE_ASCII_OVERHEAD + (3 * XIMU3_SIZE_ASCII_FLOAT))
 #define XIMU3_SIZE_ASCII_LINEAR_ACCELERATION	(XIMU3_SIZE_ASCII_OVERHEAD + (7 * XIMU3_SIZE_ASCII_FLOAT))
 #define XIMU3_SIZE_ASCII_EARTH_ACCELERATION 	(XIMU3_SIZE_ASCII_OVERHEAD + (7 * XIMU3_SIZE_ASCII_FLOAT))
-#define XIMU3_SIZE_ASCII_AHRS_STATUS        	(XIMU3_SIZE_ASCII_OVERHEAD + (4 * XIMU3_SIZE_ASCII_FLOAT))
+#define XIMU3_SIZE_ASCII_AHRS_STATUS        	(XIMU3_SIZE_ASCII_OVERHEAD + (4 * XIMU3_SIZE_ASCII_BOOL))
 #define XIMU3_SIZE_ASCII_SERIAL_ACCESSORY   	(XIMU3_SIZE_ASCII_OVERHEAD + XIMU3_SIZE_ASCII_CHAR_ARRAY)
-#define XIMU3_SIZE_ASCII_SYNC               	(XIMU3_SIZE_ASCII_OVERHEAD + (1 * XIMU3_SIZE_ASCII_FLOAT))
+#define XIMU3_SIZE_ASCII_SYNC               	(XIMU3_SIZE_ASCII_OVERHEAD + (1 * XIMU3_SIZE_ASCII_BOOL))
 #define XIMU3_SIZE_ASCII_LTC                	(XIMU3_SIZE_ASCII_OVERHEAD + sizeof (",hh:mm:ss:ff") - 1)
 #define XIMU3_SIZE_ASCII_TEMPERATURE        	(XIMU3_SIZE_ASCII_OVERHEAD + (1 * XIMU3_SIZE_ASCII_FLOAT))
 #define XIMU3_SIZE_ASCII_BATTERY            	(XIMU3_SIZE_ASCII_OVERHEAD + (3 * XIMU3_SIZE_ASCII_FLOAT))
 #define XIMU3_SIZE_ASCII_RSSI               	(XIMU3_SIZE_ASCII_OVERHEAD + (2 * XIMU3_SIZE_ASCII_FLOAT))
-#define XIMU3_SIZE_ASCII_BUTTON             	(XIMU3_SIZE_ASCII_OVERHEAD + (1 * XIMU3_SIZE_ASCII_FLOAT))
+#define XIMU3_SIZE_ASCII_BUTTON             	(XIMU3_SIZE_ASCII_OVERHEAD + (1 * XIMU3_SIZE_ASCII_BOOL))
 #define XIMU3_SIZE_ASCII_NOTIFICATION       	(XIMU3_SIZE_ASCII_OVERHEAD + XIMU3_SIZE_ASCII_CHAR_ARRAY)
 #define XIMU3_SIZE_ASCII_ERROR              	(XIMU3_SIZE_ASCII_OVERHEAD + XIMU3_SIZE_ASCII_CHAR_ARRAY)
 
+#define XIMU3_SIZE_ASCII_PARSER                 (XIMU3_SIZE_ASCII_OVERHEAD + (62 * XIMU3_SIZE_ASCII_FLOAT)) /* largest custom message, 62 floats fill a XIMU3_DESCRIPTOR_MAX_SIZE structure after the timestamp, the termination is replaced by a null terminator */
+
 #define XIMU3_SIZE_MAX(a, b)                    ((a) > (b) ? (a) : (b))
 
 #define XIMU3_SIZE_INERTIAL                     XIMU3_SIZE_MAX(XIMU3_SIZE_BINARY_INERTIAL, XIMU3_SIZE_ASCII_INERTIAL)
@@ -87,6 +159,8 @@
 #define XIMU3_SIZE_NOTIFICATION                 XIMU3_SIZE_MAX(XIMU3_SIZE_BINARY_NOTIFICATION, XIMU3_SIZE_ASCII_NOTIFICATION)
 #define XIMU3_SIZE_ERROR                        XIMU3_SIZE_MAX(XIMU3_SIZE_BINARY_ERROR, XIMU3_SIZE_ASCII_ERROR)
 
+#define XIMU3_SIZE_ROUTER                       XIMU3_SIZE_MAX(XIMU3_SIZE_ASCII_PARSER, XIMU3_SIZE_BINARY_OVERHEAD + XIMU3_SIZE_BYTE_STUFFING(256)) /* largest ASCII, binary or COBS framed message of any descriptor, the payload of a XIMU3_DESCRIPTOR_MAX_SIZE structure or a char array is at most 256 bytes */
+
 #endif
 
 //------------------------------------------------------------------------------
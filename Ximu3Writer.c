@@ -0,0 +1,71 @@
+/**
+ * @file Ximu3Writer.c
+ * @author Seb Madgwick
+ * @brief Output sink that allows messages to be encoded directly to
+ * driver-owned memory, e.g. a USB or UART transmit ring buffer.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <string.h>
+#include "Ximu3Writer.h"
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Reserves memory for a message. The returned size should be passed
+ * to the encoder as the destination size so that the message is encoded
+ * directly to the sink. For example:
+ *
+ * void* destination;
+ * const size_t destinationSize = Ximu3WriterReserve(&writer, XIMU3_SIZE_BINARY_INERTIAL, &destination);
+ * Ximu3WriterCommit(&writer, Ximu3BinaryInertial(destination, destinationSize, &data));
+ *
+ * @param writer Writer.
+ * @param numberOfBytes Number of bytes. This should be the maximum message
+ * size, e.g. XIMU3_SIZE_BINARY_INERTIAL.
+ * @param destination Destination. NULL if unavailable.
+ * @return Number of bytes reserved. 0 if unavailable.
+ */
+size_t Ximu3WriterReserve(const Ximu3Writer * const writer, const size_t numberOfBytes, void* * const destination) {
+    *destination = writer->reserve(numberOfBytes, writer->context);
+    if (*destination == NULL) {
+        return 0;
+    }
+    return numberOfBytes;
+}
+
+/**
+ * @brief Commits the number of bytes written to the last reservation.
+ * @param writer Writer.
+ * @param numberOfBytes Number of bytes. May be 0 if the reservation was
+ * unavailable.
+ */
+void Ximu3WriterCommit(const Ximu3Writer * const writer, const size_t numberOfBytes) {
+    if (numberOfBytes == 0) {
+        return;
+    }
+    writer->commit(numberOfBytes, writer->context);
+}
+
+/**
+ * @brief Writes data that has already been encoded.
+ * @param writer Writer.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes written. 0 if the sink does not have space.
+ */
+size_t Ximu3WriterWrite(const Ximu3Writer * const writer, const void* const data, const size_t numberOfBytes) {
+    void* destination;
+    if ((numberOfBytes == 0) || (Ximu3WriterReserve(writer, numberOfBytes, &destination) == 0)) {
+        return 0;
+    }
+    memcpy(destination, data, numberOfBytes);
+    Ximu3WriterCommit(writer, numberOfBytes);
+    return numberOfBytes;
+}
+
+//------------------------------------------------------------------------------
+// End of file
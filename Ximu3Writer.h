@@ -0,0 +1,42 @@
+/**
+ * @file Ximu3Writer.h
+ * @author Seb Madgwick
+ * @brief Output sink that allows messages to be encoded directly to
+ * driver-owned memory, e.g. a USB or UART transmit ring buffer.
+ */
+
+#ifndef XIMU3_WRITER_H
+#define XIMU3_WRITER_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Writer. The reserve callback must return contiguous memory of at
+ * least the requested number of bytes, or NULL if unavailable, without
+ * modifying the state of the sink. The commit callback makes the specified
+ * number of bytes of the last reservation available for transmission. Any
+ * wrap-around of a ring buffer is handled by the sink.
+ */
+typedef struct {
+    void* (*const reserve) (const size_t numberOfBytes, void* const context);
+    void (*const commit) (const size_t numberOfBytes, void* const context);
+    void* context;
+} Ximu3Writer;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+size_t Ximu3WriterReserve(const Ximu3Writer * const writer, const size_t numberOfBytes, void* * const destination);
+void Ximu3WriterCommit(const Ximu3Writer * const writer, const size_t numberOfBytes);
+size_t Ximu3WriterWrite(const Ximu3Writer * const writer, const void* const data, const size_t numberOfBytes);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file